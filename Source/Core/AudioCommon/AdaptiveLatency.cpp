@@ -0,0 +1,108 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/AdaptiveLatency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+namespace
+{
+// How quickly old deviations of the callback times are forgotten
+constexpr double JITTER_HALF_LIFE_MS = 2000.0;
+// The buffer only shrinks after it wasn't needed for this long
+constexpr double WINDOW_MS = 1000.0;
+// How much audio is kept buffered on top of the deepest dip of the buffered audio in a window
+constexpr double SAFETY_MARGIN_MS = 2.0;
+// How much of the unneeded buffer is given up after each window
+constexpr double SHRINK_FACTOR = 0.5;
+// How much the buffer grows after an underrun
+constexpr double GROW_FACTOR = 1.5;
+constexpr double GROW_MIN_STEP_MS = 4.0;
+// How quickly the latency estimate follows changes
+constexpr double LATENCY_SMOOTHING = 0.05;
+}  // namespace
+
+AdaptiveLatency::AdaptiveLatency(unsigned int sample_rate) : m_sample_rate(sample_rate)
+{
+  Reset();
+}
+
+void AdaptiveLatency::Reset()
+{
+  m_target_ms = INITIAL_TARGET_MS;
+  m_latency_ms = 0.0;
+  m_jitter_ms = 0.0;
+  m_underrun_count = 0;
+  m_has_last_callback = false;
+  StartWindow();
+}
+
+void AdaptiveLatency::Idle()
+{
+  // Neither the time until the next callback nor the buffered audio says anything about the
+  // latency which is needed
+  m_has_last_callback = false;
+  StartWindow();
+}
+
+void AdaptiveLatency::StartWindow()
+{
+  m_window_min_buffered_ms = std::numeric_limits<double>::infinity();
+  m_window_sum_buffered_ms = 0.0;
+  m_window_callbacks = 0;
+  m_window_elapsed_ms = 0.0;
+}
+
+void AdaptiveLatency::Update(TimePoint now, u32 requested_frames, u32 buffered_frames,
+                             bool underrun)
+{
+  const double period_ms = requested_frames * 1000.0 / m_sample_rate;
+  const double buffered_ms = buffered_frames * 1000.0 / m_sample_rate;
+
+  if (m_has_last_callback)
+  {
+    const double interval_ms = DT_ms(now - m_last_callback).count();
+    const double decay = std::exp2(-interval_ms / JITTER_HALF_LIFE_MS);
+    m_jitter_ms = std::max(std::abs(interval_ms - period_ms), m_jitter_ms * decay);
+    m_window_elapsed_ms += interval_ms;
+  }
+  m_has_last_callback = true;
+  m_last_callback = now;
+
+  // The requested frames are played after the ones which are still buffered
+  m_latency_ms += LATENCY_SMOOTHING * (buffered_ms + period_ms - m_latency_ms);
+
+  if (underrun)
+  {
+    ++m_underrun_count;
+    m_target_ms = std::min(std::max(m_target_ms * GROW_FACTOR, m_target_ms + GROW_MIN_STEP_MS),
+                           MAX_TARGET_MS);
+    StartWindow();
+    return;
+  }
+
+  m_window_min_buffered_ms = std::min(m_window_min_buffered_ms, buffered_ms);
+  m_window_sum_buffered_ms += buffered_ms;
+  ++m_window_callbacks;
+  if (m_window_elapsed_ms < WINDOW_MS)
+    return;
+
+  // The buffered audio hovers around the target, which the mixer reaches by slightly speeding up
+  // or slowing down playback. How deep it dips below its average shows how much of it is needed
+  // to absorb the bursts of emulation and of the callbacks, independently of where the average
+  // currently is. Even at the deepest dip, a whole callback has to be left.
+  const double average_ms = m_window_sum_buffered_ms / m_window_callbacks;
+  const double dip_ms = std::max(average_ms - m_window_min_buffered_ms, m_jitter_ms);
+  const double needed_ms = std::max(dip_ms + period_ms + SAFETY_MARGIN_MS, MIN_TARGET_MS);
+  if (needed_ms < m_target_ms)
+    m_target_ms -= (m_target_ms - needed_ms) * SHRINK_FACTOR;
+
+  StartWindow();
+}
+}  // namespace AudioCommon
@@ -0,0 +1,61 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon
+{
+// Chooses how much audio the mixer keeps buffered in low latency mode. The buffer shrinks while
+// it never came close to running out over the last second, and grows right away after an underrun.
+// It never shrinks below what the jitter of the audio callbacks requires.
+//
+// Only used from the audio thread. The time is passed in, so that the behavior can be tested
+// with a simulated clock.
+class AdaptiveLatency
+{
+public:
+  explicit AdaptiveLatency(unsigned int sample_rate);
+
+  void Reset();
+
+  // Called for every audio callback with the number of frames the backend requested and the
+  // number of frames which were buffered before mixing them. <underrun> is set if the buffered
+  // frames ran out while emulation was producing audio.
+  void Update(TimePoint now, u32 requested_frames, u32 buffered_frames, bool underrun);
+  // Called instead of Update while emulation isn't producing audio, e.g. while it is paused
+  void Idle();
+
+  // How much audio the mixer should keep buffered, in milliseconds
+  double GetTargetBufferMs() const { return m_target_ms; }
+  // The estimated time from a sample being pushed to the mixer to it being played, in milliseconds
+  double GetLatencyMs() const { return m_latency_ms; }
+  // The largest recent deviation of the callbacks from their expected times, in milliseconds
+  double GetJitterMs() const { return m_jitter_ms; }
+  u64 GetUnderrunCount() const { return m_underrun_count; }
+
+  static constexpr double MIN_TARGET_MS = 2.0;
+  static constexpr double MAX_TARGET_MS = 60.0;
+  static constexpr double INITIAL_TARGET_MS = 20.0;
+
+private:
+  void StartWindow();
+
+  unsigned int m_sample_rate;
+
+  double m_target_ms = INITIAL_TARGET_MS;
+  double m_latency_ms = 0.0;
+  double m_jitter_ms = 0.0;
+  u64 m_underrun_count = 0;
+
+  bool m_has_last_callback = false;
+  TimePoint m_last_callback{};
+
+  // The buffered audio seen in the current window
+  double m_window_min_buffered_ms = 0.0;
+  double m_window_sum_buffered_ms = 0.0;
+  u32 m_window_callbacks = 0;
+  double m_window_elapsed_ms = 0.0;
+};
+}  // namespace AudioCommon
@@ -8,6 +8,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
 
 AlsaSound::AlsaSound()
     : m_thread_status(ALSAThreadStatus::STOPPED), handle(nullptr),
@@ -144,7 +145,9 @@ bool AlsaSound::AlsaInit()
     return false;
   }
 
-  periods = BUFFER_SIZE_MAX / FRAME_COUNT_MIN;
+  const size_t hw_buffer_size_max =
+      Config::Get(Config::MAIN_AUDIO_LOW_LATENCY) ? LOW_LATENCY_BUFFER_SIZE_MAX : BUFFER_SIZE_MAX;
+  periods = hw_buffer_size_max / FRAME_COUNT_MIN;
   err = snd_pcm_hw_params_set_periods_max(handle, hwparams, &periods, &dir);
   if (err < 0)
   {
@@ -152,7 +155,7 @@ bool AlsaSound::AlsaInit()
     return false;
   }
 
-  buffer_size_max = BUFFER_SIZE_MAX;
+  buffer_size_max = hw_buffer_size_max;
   err = snd_pcm_hw_params_set_buffer_size_max(handle, hwparams, &buffer_size_max);
   if (err < 0)
   {
@@ -32,6 +32,8 @@ private:
 
   // maximum number of frames the buffer can hold
   static constexpr size_t BUFFER_SIZE_MAX = 8192;
+  // maximum number of frames the hardware buffer may hold in low latency mode (~10 ms)
+  static constexpr size_t LOW_LATENCY_BUFFER_SIZE_MAX = 512;
 
   // minimum number of frames to deliver in one transfer
   static constexpr u32 FRAME_COUNT_MIN = 256;
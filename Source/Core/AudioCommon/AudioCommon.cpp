@@ -3,6 +3,8 @@
 
 #include "AudioCommon/AudioCommon.h"
 
+#include <string_view>
+
 #include <fmt/chrono.h>
 #include <fmt/format.h>
 
@@ -220,12 +222,14 @@ void StartAudioDump(Core::System& system)
   std::string base_name =
       fmt::format("{}_{:%Y-%m-%d_%H-%M-%S}", path_prefix, fmt::localtime(start_time));
 
-  const std::string audio_file_name_dtk = fmt::format("{}_dtkdump.wav", base_name);
-  const std::string audio_file_name_dsp = fmt::format("{}_dspdump.wav", base_name);
+  const AudioDumpFormat format = Config::Get(Config::MAIN_DUMP_AUDIO_FORMAT);
+  const std::string_view extension = format == AudioDumpFormat::FLAC ? "flac" : "wav";
+  const std::string audio_file_name_dtk = fmt::format("{}_dtkdump.{}", base_name, extension);
+  const std::string audio_file_name_dsp = fmt::format("{}_dspdump.{}", base_name, extension);
   File::CreateFullPath(audio_file_name_dtk);
   File::CreateFullPath(audio_file_name_dsp);
-  sound_stream->GetMixer()->StartLogDTKAudio(audio_file_name_dtk);
-  sound_stream->GetMixer()->StartLogDSPAudio(audio_file_name_dsp);
+  sound_stream->GetMixer()->StartLogDTKAudio(audio_file_name_dtk, format);
+  sound_stream->GetMixer()->StartLogDSPAudio(audio_file_name_dsp, format);
   system.SetAudioDumpStarted(true);
 }
 
@@ -13,8 +13,12 @@ class AudioStretcher
 {
 public:
   explicit AudioStretcher(unsigned int sample_rate);
-  void ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out);
-  void GetStretchedSamples(short* out, unsigned int num_out);
+  // <max_latency> is the size of the backlog in milliseconds, which is kept about half full
+  void ProcessSamples(const short* in, unsigned int num_in, unsigned int num_out,
+                      double max_latency);
+  // Returns the number of samples which were available. The rest is padded.
+  unsigned int GetStretchedSamples(short* out, unsigned int num_out);
+  unsigned int GetBacklog() const;
   void Clear();
 
 private:
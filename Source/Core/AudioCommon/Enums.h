@@ -12,4 +12,10 @@ enum class DPL2Quality
   High = 2,
   Highest = 3
 };
+
+enum class AudioDumpFormat
+{
+  WAV = 0,
+  FLAC = 1
+};
 }  // namespace AudioCommon
@@ -0,0 +1,584 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/FlacFileWriter.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "AudioCommon/Mixer.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
+#include "Common/Swap.h"
+#include "Common/Thread.h"
+#include "Core/Config/MainSettings.h"
+
+namespace AudioCommon
+{
+namespace
+{
+constexpr u32 BITS_PER_SAMPLE = 16;
+constexpr u32 MAX_FIXED_ORDER = 4;
+constexpr u32 MAX_PARTITION_ORDER = 8;
+// Rice parameters are written with 4 bits, 15 being reserved as an escape code
+constexpr u32 MAX_RICE_PARAMETER = 14;
+
+enum class ChannelAssignment : u32
+{
+  Independent = 1,
+  LeftSide = 8,
+  RightSide = 9,
+  MidSide = 10,
+};
+
+class BitWriter
+{
+public:
+  explicit BitWriter(std::vector<u8>* out) : m_out(out) {}
+
+  void Write(u32 value, u32 bits)
+  {
+    m_accumulator = (m_accumulator << bits) | (value & ((u64{1} << bits) - 1));
+    m_bits += bits;
+    while (m_bits >= 8)
+    {
+      m_bits -= 8;
+      m_out->push_back(static_cast<u8>(m_accumulator >> m_bits));
+    }
+  }
+
+  // <zeros> zero bits followed by a one bit
+  void WriteUnary(u32 zeros)
+  {
+    for (; zeros >= 32; zeros -= 32)
+      Write(0, 32);
+    Write(1, zeros + 1);
+  }
+
+  void AlignToByte()
+  {
+    if (m_bits != 0)
+      Write(0, 8 - m_bits);
+  }
+
+private:
+  std::vector<u8>* m_out;
+  u64 m_accumulator = 0;
+  u32 m_bits = 0;
+};
+
+u8 CRC8(const u8* data, size_t size)
+{
+  u8 crc = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit)
+      crc = static_cast<u8>((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+  }
+  return crc;
+}
+
+u16 CRC16(const u8* data, size_t size)
+{
+  u16 crc = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    crc ^= static_cast<u16>(data[i] << 8);
+    for (int bit = 0; bit < 8; ++bit)
+      crc = static_cast<u16>((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+  }
+  return crc;
+}
+
+// Frame numbers are coded like UTF-8 characters
+void WriteFrameNumber(BitWriter& writer, u32 number)
+{
+  if (number < 0x80)
+  {
+    writer.Write(number, 8);
+    return;
+  }
+
+  u32 extra_bytes = 1;
+  while (extra_bytes < 5 && number >= (1u << (5 * extra_bytes + 6)))
+    ++extra_bytes;
+
+  const u32 marker = (0xFF00u >> (extra_bytes + 1)) & 0xFF;
+  writer.Write(marker | (number >> (6 * extra_bytes)), 8);
+  for (u32 i = extra_bytes; i-- > 0;)
+    writer.Write(0x80 | ((number >> (6 * i)) & 0x3F), 8);
+}
+
+u32 ZigZag(s32 value)
+{
+  return (static_cast<u32>(value) << 1) ^ static_cast<u32>(value >> 31);
+}
+
+// The residual of a fixed polynomial predictor, from sample <order> on
+void ComputeResidual(const s32* samples, u32 count, u32 order, u32* residual)
+{
+  for (u32 i = order; i < count; ++i)
+  {
+    const s32* x = samples + i;
+    s32 value;
+    switch (order)
+    {
+    case 0:
+      value = x[0];
+      break;
+    case 1:
+      value = x[0] - x[-1];
+      break;
+    case 2:
+      value = x[0] - 2 * x[-1] + x[-2];
+      break;
+    case 3:
+      value = x[0] - 3 * x[-1] + 3 * x[-2] - x[-3];
+      break;
+    default:
+      value = x[0] - 4 * x[-1] + 6 * x[-2] - 4 * x[-3] + x[-4];
+      break;
+    }
+    residual[i] = ZigZag(value);
+  }
+}
+
+struct RiceCoding
+{
+  u32 partition_order = 0;
+  std::array<u8, 1 << MAX_PARTITION_ORDER> parameters{};
+  u64 bits = std::numeric_limits<u64>::max();
+};
+
+// The cheapest Rice parameter for one partition, and its cost in bits
+std::pair<u32, u64> ChooseRiceParameter(const u32* residual, u32 count)
+{
+  u64 sum = 0;
+  for (u32 i = 0; i < count; ++i)
+    sum += residual[i];
+
+  // The best parameter is close to log2 of the mean
+  u32 estimate = 0;
+  while (estimate < MAX_RICE_PARAMETER && (u64{count} << (estimate + 1)) <= sum)
+    ++estimate;
+
+  u32 best_parameter = 0;
+  u64 best_bits = std::numeric_limits<u64>::max();
+  for (u32 parameter = estimate > 0 ? estimate - 1 : 0;
+       parameter <= std::min(estimate + 1, MAX_RICE_PARAMETER); ++parameter)
+  {
+    u64 bits = u64{count} * (parameter + 1);
+    for (u32 i = 0; i < count; ++i)
+      bits += residual[i] >> parameter;
+    if (bits < best_bits)
+    {
+      best_parameter = parameter;
+      best_bits = bits;
+    }
+  }
+  return {best_parameter, best_bits};
+}
+
+RiceCoding ChooseRiceCoding(const u32* residual, u32 count, u32 order)
+{
+  RiceCoding best;
+  for (u32 partition_order = 0; partition_order <= MAX_PARTITION_ORDER; ++partition_order)
+  {
+    const u32 partition_size = count >> partition_order;
+    if ((count & ((1u << partition_order) - 1)) != 0 || partition_size <= order)
+      break;
+
+    RiceCoding coding;
+    coding.partition_order = partition_order;
+    coding.bits = 0;
+    for (u32 partition = 0; partition < (1u << partition_order); ++partition)
+    {
+      const u32 start = partition == 0 ? order : partition * partition_size;
+      const u32 end = (partition + 1) * partition_size;
+      const auto [parameter, bits] = ChooseRiceParameter(residual + start, end - start);
+      coding.parameters[partition] = static_cast<u8>(parameter);
+      coding.bits += 4 + bits;
+    }
+
+    if (coding.bits < best.bits)
+      best = coding;
+  }
+  return best;
+}
+
+struct Subframe
+{
+  bool constant = false;
+  // Verbatim if no fixed predictor is cheaper
+  bool verbatim = true;
+  u32 order = 0;
+  RiceCoding coding;
+  u64 bits = 0;
+};
+
+Subframe ChooseSubframe(const s32* samples, u32 count, u32 bits_per_sample,
+                        std::vector<u32>& residual)
+{
+  Subframe best;
+  if (std::all_of(samples, samples + count, [&](s32 sample) { return sample == samples[0]; }))
+  {
+    best.constant = true;
+    best.bits = 8 + bits_per_sample;
+    return best;
+  }
+
+  best.bits = 8 + u64{count} * bits_per_sample;
+  for (u32 order = 0; order <= std::min(MAX_FIXED_ORDER, count - 1); ++order)
+  {
+    ComputeResidual(samples, count, order, residual.data());
+    const RiceCoding coding = ChooseRiceCoding(residual.data(), count, order);
+    const u64 bits = 8 + order * bits_per_sample + 6 + coding.bits;
+    if (bits < best.bits)
+    {
+      best.verbatim = false;
+      best.order = order;
+      best.coding = coding;
+      best.bits = bits;
+    }
+  }
+  return best;
+}
+
+void WriteSubframe(BitWriter& writer, const Subframe& subframe, const s32* samples, u32 count,
+                   u32 bits_per_sample, std::vector<u32>& residual)
+{
+  // Zero padding bit, type, no wasted bits
+  if (subframe.constant)
+  {
+    writer.Write(0b00000000, 8);
+    writer.Write(static_cast<u32>(samples[0]), bits_per_sample);
+    return;
+  }
+
+  if (subframe.verbatim)
+  {
+    writer.Write(0b00000010, 8);
+    for (u32 i = 0; i < count; ++i)
+      writer.Write(static_cast<u32>(samples[i]), bits_per_sample);
+    return;
+  }
+
+  writer.Write((0b001000 | subframe.order) << 1, 8);
+  for (u32 i = 0; i < subframe.order; ++i)
+    writer.Write(static_cast<u32>(samples[i]), bits_per_sample);
+
+  // Rice coding with 4-bit parameters
+  const RiceCoding& coding = subframe.coding;
+  writer.Write(0, 2);
+  writer.Write(coding.partition_order, 4);
+  ComputeResidual(samples, count, subframe.order, residual.data());
+  const u32 partition_size = count >> coding.partition_order;
+  for (u32 partition = 0; partition < (1u << coding.partition_order); ++partition)
+  {
+    const u32 parameter = coding.parameters[partition];
+    writer.Write(parameter, 4);
+    const u32 start = partition == 0 ? subframe.order : partition * partition_size;
+    for (u32 i = start; i < (partition + 1) * partition_size; ++i)
+    {
+      writer.WriteUnary(residual[i] >> parameter);
+      if (parameter != 0)
+        writer.Write(residual[i], parameter);
+    }
+  }
+}
+}  // namespace
+
+std::vector<u8> FlacEncoder::GetStreamHeader(u32 sample_rate, u64 total_frames)
+{
+  std::vector<u8> header;
+  BitWriter writer(&header);
+
+  writer.Write(0x664C6143, 32);  // "fLaC"
+  // Last metadata block, STREAMINFO, 34 bytes
+  writer.Write(1, 1);
+  writer.Write(0, 7);
+  writer.Write(34, 24);
+
+  writer.Write(BLOCK_SIZE, 16);  // minimum block size
+  writer.Write(BLOCK_SIZE, 16);  // maximum block size
+  writer.Write(0, 24);           // unknown minimum frame size
+  writer.Write(0, 24);           // unknown maximum frame size
+  writer.Write(sample_rate, 20);
+  writer.Write(2 - 1, 3);  // channels
+  writer.Write(BITS_PER_SAMPLE - 1, 5);
+  writer.Write(static_cast<u32>(total_frames >> 32), 4);
+  writer.Write(static_cast<u32>(total_frames), 32);
+  for (int i = 0; i < 4; ++i)
+    writer.Write(0, 32);  // unknown MD5 signature
+
+  return header;
+}
+
+void FlacEncoder::EncodeFrame(const s16* samples, u32 count, std::vector<u8>* out)
+{
+  // Try coding the channels independently and as combinations with their difference (side), which
+  // needs one more bit per sample
+  std::array<std::vector<s32>, 4> channels;
+  for (std::vector<s32>& channel : channels)
+    channel.resize(count);
+  std::vector<s32>& left = channels[0];
+  std::vector<s32>& right = channels[1];
+  std::vector<s32>& mid = channels[2];
+  std::vector<s32>& side = channels[3];
+  for (u32 i = 0; i < count; ++i)
+  {
+    left[i] = samples[i * 2];
+    right[i] = samples[i * 2 + 1];
+    mid[i] = (left[i] + right[i]) >> 1;
+    side[i] = left[i] - right[i];
+  }
+
+  std::vector<u32> residual(count);
+  std::array<Subframe, 4> subframes;
+  for (size_t i = 0; i < channels.size(); ++i)
+  {
+    const u32 bits_per_sample = &channels[i] == &side ? BITS_PER_SAMPLE + 1 : BITS_PER_SAMPLE;
+    subframes[i] = ChooseSubframe(channels[i].data(), count, bits_per_sample, residual);
+  }
+
+  struct Assignment
+  {
+    ChannelAssignment assignment;
+    size_t first;
+    size_t second;
+  };
+  constexpr std::array<Assignment, 4> assignments = {{
+      {ChannelAssignment::Independent, 0, 1},
+      {ChannelAssignment::LeftSide, 0, 3},
+      {ChannelAssignment::RightSide, 3, 1},
+      {ChannelAssignment::MidSide, 2, 3},
+  }};
+  const Assignment& best = *std::min_element(
+      assignments.begin(), assignments.end(), [&](const Assignment& a, const Assignment& b) {
+        return subframes[a.first].bits + subframes[a.second].bits <
+               subframes[b.first].bits + subframes[b.second].bits;
+      });
+
+  const size_t frame_start = out->size();
+  BitWriter writer(out);
+
+  // Fixed block size stream
+  writer.Write(0xFFF8, 16);
+  // The block size follows the frame number, the sample rate is the one in STREAMINFO
+  writer.Write(0b0111, 4);
+  writer.Write(0b0000, 4);
+  writer.Write(static_cast<u32>(best.assignment), 4);
+  writer.Write(0b100, 3);  // 16 bits per sample
+  writer.Write(0, 1);
+  WriteFrameNumber(writer, m_frame_number++);
+  writer.Write(count - 1, 16);
+  writer.Write(CRC8(out->data() + frame_start, out->size() - frame_start), 8);
+
+  for (const size_t channel : {best.first, best.second})
+  {
+    const u32 bits_per_sample = channel == 3 ? BITS_PER_SAMPLE + 1 : BITS_PER_SAMPLE;
+    WriteSubframe(writer, subframes[channel], channels[channel].data(), count, bits_per_sample,
+                  residual);
+  }
+
+  writer.AlignToByte();
+  writer.Write(CRC16(out->data() + frame_start, out->size() - frame_start), 16);
+}
+
+FlacFileWriter::FlacFileWriter() = default;
+
+FlacFileWriter::~FlacFileWriter()
+{
+  Stop();
+}
+
+bool FlacFileWriter::Start(const std::string& filename, u32 sample_rate_divisor)
+{
+  // Ask to delete file
+  if (File::Exists(filename))
+  {
+    if (Config::Get(Config::MAIN_DUMP_AUDIO_SILENT) ||
+        AskYesNoFmtT("Delete the existing file '{0}'?", filename))
+    {
+      File::Delete(filename);
+    }
+    else
+    {
+      // Stop and cancel dumping the audio
+      return false;
+    }
+  }
+
+  if (m_thread.joinable())
+  {
+    PanicAlertFmtT("The file {0} was already open, the file header will not be written.", filename);
+    return false;
+  }
+
+  m_file.Open(filename, "wb");
+  if (!m_file)
+  {
+    PanicAlertFmtT(
+        "The file {0} could not be opened for writing. Please check if it's already opened "
+        "by another program.",
+        filename);
+    return false;
+  }
+
+  if (m_basename.empty())
+    SplitPath(filename, nullptr, &m_basename, nullptr);
+
+  m_sample_rate_divisor = sample_rate_divisor;
+  m_total_frames = 0;
+  m_encoder = FlacEncoder();
+  const std::vector<u8> header =
+      FlacEncoder::GetStreamHeader(Mixer::FIXED_SAMPLE_RATE_DIVIDEND / sample_rate_divisor, 0);
+  m_file.WriteBytes(header.data(), header.size());
+
+  m_pending.sample_rate_divisor = sample_rate_divisor;
+  m_stopping.Clear();
+  m_thread = std::thread(&FlacFileWriter::WorkerThread, this);
+  return true;
+}
+
+void FlacFileWriter::Stop()
+{
+  if (!m_thread.joinable())
+    return;
+
+  QueuePending();
+  m_stopping.Set();
+  m_queue_event.Set();
+  m_thread.join();
+}
+
+void FlacFileWriter::AddStereoSamplesBE(const short* sample_data, u32 count,
+                                        u32 sample_rate_divisor, int l_volume, int r_volume)
+{
+  if (!m_thread.joinable())
+  {
+    ERROR_LOG_FMT(AUDIO, "FlacFileWriter - file not open.");
+    return;
+  }
+
+  if (sample_rate_divisor != m_pending.sample_rate_divisor)
+  {
+    QueuePending();
+    m_pending.sample_rate_divisor = sample_rate_divisor;
+  }
+
+  for (u32 i = 0; i < count; i++)
+  {
+    // Flip the audio channels from RL to LR and apply volume (volume ranges from 0 to 256)
+    const s16 left = static_cast<s16>(Common::swap16(static_cast<u16>(sample_data[2 * i + 1])));
+    const s16 right = static_cast<s16>(Common::swap16(static_cast<u16>(sample_data[2 * i])));
+    m_pending.samples.push_back(static_cast<s16>(left * l_volume / 256));
+    m_pending.samples.push_back(static_cast<s16>(right * r_volume / 256));
+  }
+
+  if (m_pending.samples.size() >= FlacEncoder::BLOCK_SIZE * 2)
+    QueuePending();
+}
+
+void FlacFileWriter::QueuePending()
+{
+  if (m_pending.samples.empty())
+    return;
+
+  const u32 sample_rate_divisor = m_pending.sample_rate_divisor;
+  m_queue.Push(std::move(m_pending));
+  m_pending = Batch{sample_rate_divisor, {}};
+  m_pending.samples.reserve(FlacEncoder::BLOCK_SIZE * 2);
+  m_queue_event.Set();
+}
+
+void FlacFileWriter::WorkerThread()
+{
+  Common::SetCurrentThreadName("FLAC audio dump");
+
+  while (true)
+  {
+    m_queue_event.Wait();
+    // Read the flag before emptying the queue, so that nothing queued before stopping is missed
+    const bool stopping = m_stopping.IsSet();
+
+    Batch batch;
+    while (m_queue.Pop(batch))
+    {
+      if (batch.sample_rate_divisor != m_sample_rate_divisor)
+        OpenNextFile(batch.sample_rate_divisor);
+
+      m_unencoded.insert(m_unencoded.end(), batch.samples.begin(), batch.samples.end());
+      EncodeFrames(false);
+    }
+
+    if (stopping)
+    {
+      EncodeFrames(true);
+      FinishFile();
+      return;
+    }
+  }
+}
+
+void FlacFileWriter::OpenNextFile(u32 sample_rate_divisor)
+{
+  EncodeFrames(true);
+  FinishFile();
+
+  m_file_index++;
+  const std::string filename =
+      fmt::format("{}{}{}.flac", File::GetUserPath(D_DUMPAUDIO_IDX), m_basename, m_file_index);
+  m_file.Open(filename, "wb");
+  if (!m_file)
+    ERROR_LOG_FMT(AUDIO, "FlacFileWriter - could not open {}", filename);
+
+  m_sample_rate_divisor = sample_rate_divisor;
+  m_total_frames = 0;
+  m_encoder = FlacEncoder();
+  const std::vector<u8> header =
+      FlacEncoder::GetStreamHeader(Mixer::FIXED_SAMPLE_RATE_DIVIDEND / sample_rate_divisor, 0);
+  m_file.WriteBytes(header.data(), header.size());
+}
+
+void FlacFileWriter::EncodeFrames(bool flush)
+{
+  // All frames but the last one of a file have to hold exactly BLOCK_SIZE samples
+  const size_t num_frames = m_unencoded.size() / 2;
+  size_t frame = 0;
+  while (num_frames - frame >= FlacEncoder::BLOCK_SIZE || (flush && frame < num_frames))
+  {
+    const u32 count =
+        static_cast<u32>(std::min<size_t>(num_frames - frame, FlacEncoder::BLOCK_SIZE));
+    m_encoder.EncodeFrame(m_unencoded.data() + frame * 2, count, &m_encoded);
+    frame += count;
+  }
+
+  m_file.WriteBytes(m_encoded.data(), m_encoded.size());
+  m_encoded.clear();
+  m_unencoded.erase(m_unencoded.begin(), m_unencoded.begin() + frame * 2);
+  m_total_frames += frame;
+}
+
+void FlacFileWriter::FinishFile()
+{
+  if (!m_file)
+    return;
+
+  // Now that the length is known, fill it in
+  const std::vector<u8> header = FlacEncoder::GetStreamHeader(
+      Mixer::FIXED_SAMPLE_RATE_DIVIDEND / m_sample_rate_divisor, m_total_frames);
+  m_file.Seek(0, File::SeekOrigin::Begin);
+  m_file.WriteBytes(header.data(), header.size());
+  m_file.Close();
+}
+}  // namespace AudioCommon
@@ -0,0 +1,90 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Writes 16-bit stereo audio streams to FLAC files. Encoding and writing happen on a worker
+// thread, which the samples are passed to through a lock-free queue, so that long dumps take a
+// fraction of the disk space of WAV dumps without stalling emulation on disk writes.
+// The interface matches WaveFileWriter.
+
+#pragma once
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
+#include "Common/IOFile.h"
+#include "Common/SPSCQueue.h"
+
+namespace AudioCommon
+{
+// Encodes 16-bit stereo audio to a FLAC stream, using fixed predictors and Rice coding.
+class FlacEncoder
+{
+public:
+  static constexpr u32 BLOCK_SIZE = 4096;
+
+  // The "fLaC" marker and the STREAMINFO block. <total_frames> may be 0 if it isn't known yet.
+  static std::vector<u8> GetStreamHeader(u32 sample_rate, u64 total_frames);
+
+  // Appends a FLAC frame to <out>, holding <count> (at most BLOCK_SIZE) frames of interleaved
+  // left and right samples.
+  void EncodeFrame(const s16* samples, u32 count, std::vector<u8>* out);
+
+private:
+  u32 m_frame_number = 0;
+};
+
+class FlacFileWriter
+{
+public:
+  FlacFileWriter();
+  ~FlacFileWriter();
+
+  FlacFileWriter(const FlacFileWriter&) = delete;
+  FlacFileWriter& operator=(const FlacFileWriter&) = delete;
+  FlacFileWriter(FlacFileWriter&&) = delete;
+  FlacFileWriter& operator=(FlacFileWriter&&) = delete;
+
+  bool Start(const std::string& filename, u32 sample_rate_divisor);
+  // Waits until all samples are written
+  void Stop();
+
+  // big endian
+  void AddStereoSamplesBE(const short* sample_data, u32 count, u32 sample_rate_divisor,
+                          int l_volume, int r_volume);
+
+private:
+  struct Batch
+  {
+    u32 sample_rate_divisor = 0;
+    std::vector<s16> samples;
+  };
+
+  void QueuePending();
+  void WorkerThread();
+  void OpenNextFile(u32 sample_rate_divisor);
+  void EncodeFrames(bool flush);
+  void FinishFile();
+
+  // Only used by the thread adding samples
+  Batch m_pending;
+
+  Common::SPSCQueue<Batch, false> m_queue;
+  Common::Event m_queue_event;
+  Common::Flag m_stopping;
+  std::thread m_thread;
+
+  // Only used by the worker thread while it runs
+  File::IOFile m_file;
+  std::string m_basename;
+  u32 m_file_index = 0;
+  u32 m_sample_rate_divisor = 0;
+  u64 m_total_frames = 0;
+  FlacEncoder m_encoder;
+  std::vector<s16> m_unencoded;
+  std::vector<u8> m_encoded;
+};
+}  // namespace AudioCommon
@@ -8,6 +8,7 @@
 #include <cstring>
 
 #include "AudioCommon/Enums.h"
+#include "AudioCommon/MixerResample.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -16,26 +17,45 @@
 #include "Core/ConfigManager.h"
 #include "VideoCommon/PerformanceMetrics.h"
 
-static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality)
+static u32 DPL2QualityToFrameBlockSize(AudioCommon::DPL2Quality quality, bool low_latency)
 {
+  u32 frame_block_size;
   switch (quality)
   {
   case AudioCommon::DPL2Quality::Lowest:
-    return 512;
+    frame_block_size = 512;
+    break;
   case AudioCommon::DPL2Quality::Low:
-    return 1024;
+    frame_block_size = 1024;
+    break;
   case AudioCommon::DPL2Quality::Highest:
-    return 4096;
+    frame_block_size = 4096;
+    break;
   default:
-    return 2048;
+    frame_block_size = 2048;
+    break;
   }
+
+  // Halving the block size halves the latency of the decoder, at the cost of a coarser frequency
+  // resolution
+  return low_latency ? frame_block_size / 2 : frame_block_size;
+}
+
+static std::unique_ptr<AudioCommon::SurroundDecoder> CreateSurroundDecoder(u32 sample_rate)
+{
+  return std::make_unique<AudioCommon::SurroundDecoder>(
+      sample_rate, DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY),
+                                               Config::Get(Config::MAIN_AUDIO_LOW_LATENCY)));
 }
 
 Mixer::Mixer(unsigned int BackendSampleRate)
-    : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate),
-      m_surround_decoder(BackendSampleRate,
-                         DPL2QualityToFrameBlockSize(Config::Get(Config::MAIN_DPL2_QUALITY)))
+    : m_sampleRate(BackendSampleRate), m_stretcher(BackendSampleRate), m_latency(BackendSampleRate)
 {
+  // The sound stream is created along with the mixer, and decides whether to use DPLII from the
+  // same setting
+  if (Config::ShouldUseDPL2Decoder())
+    m_surround_decoder = CreateSurroundDecoder(BackendSampleRate);
+
   m_config_changed_callback_id = Config::AddConfigChangedCallback([this] { RefreshConfig(); });
   RefreshConfig();
 
@@ -58,12 +78,9 @@ void Mixer::DoState(PointerWrap& p)
 }
 
 // Executed from sound stream thread
-unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
-                                   bool consider_framelimit, float emulationspeed,
-                                   int timing_variance)
+unsigned int Mixer::MixerFifo::Mix(s32* samples, unsigned int numSamples, bool consider_framelimit,
+                                   float emulationspeed, int buffer_ms)
 {
-  unsigned int currentSample = 0;
-
   // Cache access in non-volatile variable
   // This is the only function changing the read value, so it's safe to
   // cache it locally although it's written here.
@@ -84,7 +101,7 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
   {
     float numLeft = static_cast<float>(((indexW - indexR) & INDEX_MASK) / 2);
 
-    u32 low_watermark = (FIXED_SAMPLE_RATE_DIVIDEND * timing_variance) /
+    u32 low_watermark = (FIXED_SAMPLE_RATE_DIVIDEND * buffer_ms) /
                         (static_cast<u64>(m_input_sample_rate_divisor) * 1000);
     low_watermark = std::min(low_watermark, MAX_SAMPLES / 2);
 
@@ -100,58 +117,39 @@ unsigned int Mixer::MixerFifo::Mix(short* samples, unsigned int numSamples,
 
   const u32 ratio = (u32)(65536.0f * aid_sample_rate / (float)m_mixer->m_sampleRate);
 
-  s32 lvolume = m_LVolume.load();
-  s32 rvolume = m_RVolume.load();
+  const s32 lvolume = m_LVolume.load();
+  const s32 rvolume = m_RVolume.load();
+
+  // TODO: consider a higher-quality resampling algorithm.
+  // Actual number of samples written to the buffer without padding.
+  const unsigned int actual_sample_count = AudioCommon::MixerResample::ResampleAdd(
+      samples, numSamples, m_buffer.data(), INDEX_MASK, indexW, !m_little_endian, ratio, lvolume,
+      rvolume, &indexR, &m_frac);
 
   const auto read_buffer = [this](auto index) {
     return m_little_endian ? m_buffer[index] : Common::swap16(m_buffer[index]);
   };
 
-  // TODO: consider a higher-quality resampling algorithm.
-  for (; currentSample < numSamples * 2 && ((indexW - indexR) & INDEX_MASK) > 2; currentSample += 2)
-  {
-    u32 indexR2 = indexR + 2;  // next sample
-
-    s16 l1 = read_buffer(indexR & INDEX_MASK);   // current
-    s16 l2 = read_buffer(indexR2 & INDEX_MASK);  // next
-    int sampleL = ((l1 << 16) + (l2 - l1) * (u16)m_frac) >> 16;
-    sampleL = (sampleL * lvolume) >> 8;
-    sampleL += samples[currentSample + 1];
-    samples[currentSample + 1] = std::clamp(sampleL, -32767, 32767);
-
-    s16 r1 = read_buffer((indexR + 1) & INDEX_MASK);   // current
-    s16 r2 = read_buffer((indexR2 + 1) & INDEX_MASK);  // next
-    int sampleR = ((r1 << 16) + (r2 - r1) * (u16)m_frac) >> 16;
-    sampleR = (sampleR * rvolume) >> 8;
-    sampleR += samples[currentSample];
-    samples[currentSample] = std::clamp(sampleR, -32767, 32767);
-
-    m_frac += ratio;
-    indexR += 2 * (u16)(m_frac >> 16);
-    m_frac &= 0xffff;
-  }
-
-  // Actual number of samples written to the buffer without padding.
-  unsigned int actual_sample_count = currentSample / 2;
-
   // Padding
   short s[2];
   s[0] = read_buffer((indexR - 1) & INDEX_MASK);
   s[1] = read_buffer((indexR - 2) & INDEX_MASK);
   s[0] = (s[0] * rvolume) >> 8;
   s[1] = (s[1] * lvolume) >> 8;
-  for (; currentSample < numSamples * 2; currentSample += 2)
+  for (unsigned int currentSample = actual_sample_count * 2; currentSample < numSamples * 2;
+       currentSample += 2)
   {
-    int sampleR = std::clamp(s[0] + samples[currentSample + 0], -32767, 32767);
-    int sampleL = std::clamp(s[1] + samples[currentSample + 1], -32767, 32767);
-
-    samples[currentSample + 0] = sampleR;
-    samples[currentSample + 1] = sampleL;
+    samples[currentSample + 0] += s[0];
+    samples[currentSample + 1] += s[1];
   }
 
   // Flush cached variable
   m_indexR.store(indexR);
 
+  m_was_pushed_to = indexW != m_last_mixed_indexW;
+  m_last_mixed_indexW = indexW;
+  m_ran_out = actual_sample_count < numSamples;
+
   return actual_sample_count;
 }
 
@@ -160,12 +158,34 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
   if (!samples)
     return 0;
 
-  memset(samples, 0, num_samples * 2 * sizeof(short));
+  const TimePoint start = Clock::now();
+  const unsigned int mixed_samples = MixAll(samples, num_samples);
+  g_perf_metrics.CountAudioCallback(Clock::now() - start);
+
+  return mixed_samples;
+}
 
+unsigned int Mixer::MixAll(short* samples, unsigned int num_samples)
+{
   // TODO: Determine how emulation speed will be used in audio
   // const float emulation_speed = g_perf_metrics.GetSpeed();
   const float emulation_speed = m_config_emulation_speed;
   const int timing_variance = m_config_timing_variance;
+
+  // Every FIFO adds its samples to m_mix_buffer, which is only clamped at the end
+  const auto mix_fifos = [&](unsigned int count, bool consider_framelimit, int buffer_ms) {
+    std::fill_n(m_mix_buffer.begin(), count * 2, 0);
+    m_dma_mixer.Mix(m_mix_buffer.data(), count, consider_framelimit, emulation_speed, buffer_ms);
+    m_streaming_mixer.Mix(m_mix_buffer.data(), count, consider_framelimit, emulation_speed,
+                          buffer_ms);
+    m_wiimote_speaker_mixer.Mix(m_mix_buffer.data(), count, consider_framelimit, emulation_speed,
+                                buffer_ms);
+    m_skylander_portal_mixer.Mix(m_mix_buffer.data(), count, consider_framelimit, emulation_speed,
+                                 buffer_ms);
+    for (auto& mixer : m_gba_mixers)
+      mixer.Mix(m_mix_buffer.data(), count, consider_framelimit, emulation_speed, buffer_ms);
+  };
+
   if (m_config_audio_stretch)
   {
     unsigned int available_samples =
@@ -176,69 +196,92 @@ unsigned int Mixer::Mix(short* samples, unsigned int num_samples)
                m_dma_mixer.AvailableSamples(), m_streaming_mixer.AvailableSamples(),
                available_samples, MAX_SAMPLES, num_samples);
 
-    m_scratch_buffer.fill(0);
-
-    m_dma_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                    timing_variance);
-    m_streaming_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                          timing_variance);
-    m_wiimote_speaker_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                timing_variance);
-    m_skylander_portal_mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                                 timing_variance);
-    for (auto& mixer : m_gba_mixers)
-    {
-      mixer.Mix(m_scratch_buffer.data(), available_samples, false, emulation_speed,
-                timing_variance);
-    }
+    mix_fifos(available_samples, false, timing_variance);
+    AudioCommon::MixerResample::ClampToS16(m_scratch_buffer.data(), m_mix_buffer.data(),
+                                           available_samples * 2);
 
     if (!m_is_stretching)
     {
       m_stretcher.Clear();
       m_is_stretching = true;
     }
-    m_stretcher.ProcessSamples(m_scratch_buffer.data(), available_samples, num_samples);
-    m_stretcher.GetStretchedSamples(samples, num_samples);
+    // The stretcher aims to keep its backlog half full
+    const double max_latency = m_config_low_latency ? m_latency.GetTargetBufferMs() * 2 :
+                                                      m_config_audio_stretch_latency;
+    m_stretcher.ProcessSamples(m_scratch_buffer.data(), available_samples, num_samples,
+                               max_latency);
+    const unsigned int buffered_samples = m_stretcher.GetBacklog();
+    const unsigned int stretched_samples = m_stretcher.GetStretchedSamples(samples, num_samples);
+    UpdateLatency(num_samples, buffered_samples, stretched_samples < num_samples);
   }
   else
   {
-    m_dma_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_streaming_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_wiimote_speaker_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    m_skylander_portal_mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
-    for (auto& mixer : m_gba_mixers)
-      mixer.Mix(samples, num_samples, true, emulation_speed, timing_variance);
+    const unsigned int buffered_samples = m_dma_mixer.AvailableSamples();
+    const int buffer_ms = m_config_low_latency ?
+                              static_cast<int>(std::ceil(m_latency.GetTargetBufferMs())) :
+                              timing_variance;
+    for (unsigned int offset = 0; offset < num_samples; offset += MAX_SAMPLES)
+    {
+      const unsigned int count = std::min(num_samples - offset, MAX_SAMPLES);
+      mix_fifos(count, true, buffer_ms);
+      AudioCommon::MixerResample::ClampToS16(samples + offset * 2, m_mix_buffer.data(), count * 2);
+    }
     m_is_stretching = false;
+    UpdateLatency(num_samples, buffered_samples, m_dma_mixer.RanOut());
   }
 
   return num_samples;
 }
 
+// Runs for every callback, so that the latency is shown in the performance overlay even when the
+// low latency mode is disabled
+void Mixer::UpdateLatency(unsigned int requested_samples, unsigned int buffered_samples,
+                          bool ran_out)
+{
+  if (!m_dma_mixer.WasPushedTo())
+  {
+    m_latency.Idle();
+    return;
+  }
+
+  m_latency.Update(Clock::now(), requested_samples, buffered_samples, ran_out);
+  if (ran_out)
+    g_perf_metrics.CountAudioUnderrun();
+  g_perf_metrics.SetAudioLatency(DT_ms(m_latency.GetLatencyMs()));
+}
+
 unsigned int Mixer::MixSurround(float* samples, unsigned int num_samples)
 {
   if (!num_samples)
     return 0;
 
-  memset(samples, 0, num_samples * SURROUND_CHANNELS * sizeof(float));
+  const TimePoint start = Clock::now();
 
-  size_t needed_frames = m_surround_decoder.QueryFramesNeededForSurroundOutput(num_samples);
+  // Only if the setting was changed between creating the mixer and the sound stream
+  if (!m_surround_decoder)
+    m_surround_decoder = CreateSurroundDecoder(m_sampleRate);
 
-  // Mix() may also use m_scratch_buffer internally, but is safe because it alternates reads
-  // and writes.
-  ASSERT_MSG(AUDIO, needed_frames <= MAX_SAMPLES,
-             "needed_frames would overflow m_scratch_buffer: {} -> {} > {}", num_samples,
-             needed_frames, MAX_SAMPLES);
-  size_t available_frames = Mix(m_scratch_buffer.data(), static_cast<u32>(needed_frames));
-  if (available_frames != needed_frames)
+  // The decoder runs on its own thread and needs the frames ahead of time, so the frames mixed now
+  // are only received by later calls.
+  size_t needed_frames = m_surround_decoder->QueryFramesNeededForSurroundOutput(num_samples);
+  while (needed_frames > 0)
   {
-    ERROR_LOG_FMT(AUDIO,
-                  "Error decoding surround frames: needed {} frames for {} samples but got {}",
-                  needed_frames, num_samples, available_frames);
-    return 0;
+    // MixAll() may also use m_scratch_buffer internally, but is safe because it alternates reads
+    // and writes.
+    const u32 frames = static_cast<u32>(std::min<size_t>(needed_frames, MAX_SAMPLES));
+    MixAll(m_scratch_buffer.data(), frames);
+    m_surround_decoder->PutFrames(m_scratch_buffer.data(), frames);
+    needed_frames -= frames;
+  }
+
+  const size_t received_frames = m_surround_decoder->ReceiveFrames(samples, num_samples);
+  if (received_frames != num_samples)
+  {
+    DEBUG_LOG_FMT(AUDIO, "Surround decoder fell behind: needed {} frames but got {}", num_samples,
+                  received_frames);
   }
 
-  m_surround_decoder.PutFrames(m_scratch_buffer.data(), needed_frames);
-  m_surround_decoder.ReceiveFrames(samples, num_samples);
+  g_perf_metrics.CountAudioCallback(Clock::now() - start);
 
   return num_samples;
 }
@@ -269,6 +312,12 @@ void Mixer::MixerFifo::PushSamples(const short* samples, unsigned int num_sample
     memcpy(&m_buffer[indexW & INDEX_MASK], samples, num_samples * 4);
   }
 
+  if (over_bytes > 0 || (indexW & INDEX_MASK) == 0)
+  {
+    m_buffer[MAX_SAMPLES * 2] = m_buffer[0];
+    m_buffer[MAX_SAMPLES * 2 + 1] = m_buffer[1];
+  }
+
   m_indexW.fetch_add(num_samples * 2);
 }
 
@@ -279,8 +328,16 @@ void Mixer::PushSamples(const short* samples, unsigned int num_samples)
   {
     int sample_rate_divisor = m_dma_mixer.GetInputSampleRateDivisor();
     auto volume = m_dma_mixer.GetVolume();
-    m_wave_writer_dsp.AddStereoSamplesBE(samples, num_samples, sample_rate_divisor, volume.first,
-                                         volume.second);
+    if (m_dsp_dump_format == AudioCommon::AudioDumpFormat::FLAC)
+    {
+      m_flac_writer_dsp.AddStereoSamplesBE(samples, num_samples, sample_rate_divisor, volume.first,
+                                           volume.second);
+    }
+    else
+    {
+      m_wave_writer_dsp.AddStereoSamplesBE(samples, num_samples, sample_rate_divisor, volume.first,
+                                           volume.second);
+    }
   }
 }
 
@@ -291,8 +348,16 @@ void Mixer::PushStreamingSamples(const short* samples, unsigned int num_samples)
   {
     int sample_rate_divisor = m_streaming_mixer.GetInputSampleRateDivisor();
     auto volume = m_streaming_mixer.GetVolume();
-    m_wave_writer_dtk.AddStereoSamplesBE(samples, num_samples, sample_rate_divisor, volume.first,
-                                         volume.second);
+    if (m_dtk_dump_format == AudioCommon::AudioDumpFormat::FLAC)
+    {
+      m_flac_writer_dtk.AddStereoSamplesBE(samples, num_samples, sample_rate_divisor, volume.first,
+                                           volume.second);
+    }
+    else
+    {
+      m_wave_writer_dtk.AddStereoSamplesBE(samples, num_samples, sample_rate_divisor, volume.first,
+                                           volume.second);
+    }
   }
 }
 
@@ -379,11 +444,15 @@ void Mixer::SetGBAVolume(int device_number, unsigned int lvolume, unsigned int r
   m_gba_mixers[device_number].SetVolume(lvolume, rvolume);
 }
 
-void Mixer::StartLogDTKAudio(const std::string& filename)
+void Mixer::StartLogDTKAudio(const std::string& filename, AudioCommon::AudioDumpFormat format)
 {
   if (!m_log_dtk_audio)
   {
-    bool success = m_wave_writer_dtk.Start(filename, m_streaming_mixer.GetInputSampleRateDivisor());
+    m_dtk_dump_format = format;
+    const u32 sample_rate_divisor = m_streaming_mixer.GetInputSampleRateDivisor();
+    bool success = format == AudioCommon::AudioDumpFormat::FLAC ?
+                       m_flac_writer_dtk.Start(filename, sample_rate_divisor) :
+                       m_wave_writer_dtk.Start(filename, sample_rate_divisor);
     if (success)
     {
       m_log_dtk_audio = true;
@@ -407,7 +476,10 @@ void Mixer::StopLogDTKAudio()
   if (m_log_dtk_audio)
   {
     m_log_dtk_audio = false;
-    m_wave_writer_dtk.Stop();
+    if (m_dtk_dump_format == AudioCommon::AudioDumpFormat::FLAC)
+      m_flac_writer_dtk.Stop();
+    else
+      m_wave_writer_dtk.Stop();
     NOTICE_LOG_FMT(AUDIO, "Stopping DTK Audio logging");
   }
   else
@@ -416,11 +488,15 @@ void Mixer::StopLogDTKAudio()
   }
 }
 
-void Mixer::StartLogDSPAudio(const std::string& filename)
+void Mixer::StartLogDSPAudio(const std::string& filename, AudioCommon::AudioDumpFormat format)
 {
   if (!m_log_dsp_audio)
   {
-    bool success = m_wave_writer_dsp.Start(filename, m_dma_mixer.GetInputSampleRateDivisor());
+    m_dsp_dump_format = format;
+    const u32 sample_rate_divisor = m_dma_mixer.GetInputSampleRateDivisor();
+    bool success = format == AudioCommon::AudioDumpFormat::FLAC ?
+                       m_flac_writer_dsp.Start(filename, sample_rate_divisor) :
+                       m_wave_writer_dsp.Start(filename, sample_rate_divisor);
     if (success)
     {
       m_log_dsp_audio = true;
@@ -444,7 +520,10 @@ void Mixer::StopLogDSPAudio()
   if (m_log_dsp_audio)
   {
     m_log_dsp_audio = false;
-    m_wave_writer_dsp.Stop();
+    if (m_dsp_dump_format == AudioCommon::AudioDumpFormat::FLAC)
+      m_flac_writer_dsp.Stop();
+    else
+      m_wave_writer_dsp.Stop();
     NOTICE_LOG_FMT(AUDIO, "Stopping DSP Audio logging");
   }
   else
@@ -458,6 +537,8 @@ void Mixer::RefreshConfig()
   m_config_emulation_speed = Config::Get(Config::MAIN_EMULATION_SPEED);
   m_config_timing_variance = Config::Get(Config::MAIN_TIMING_VARIANCE);
   m_config_audio_stretch = Config::Get(Config::MAIN_AUDIO_STRETCH);
+  m_config_audio_stretch_latency = Config::Get(Config::MAIN_AUDIO_STRETCH_LATENCY);
+  m_config_low_latency = Config::Get(Config::MAIN_AUDIO_LOW_LATENCY);
 }
 
 void Mixer::MixerFifo::DoState(PointerWrap& p)
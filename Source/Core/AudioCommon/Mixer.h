@@ -5,8 +5,12 @@
 
 #include <array>
 #include <atomic>
+#include <memory>
 
+#include "AudioCommon/AdaptiveLatency.h"
 #include "AudioCommon/AudioStretcher.h"
+#include "AudioCommon/Enums.h"
+#include "AudioCommon/FlacFileWriter.h"
 #include "AudioCommon/SurroundDecoder.h"
 #include "AudioCommon/WaveFile.h"
 #include "Common/CommonTypes.h"
@@ -44,10 +48,10 @@ public:
   void SetWiimoteSpeakerVolume(unsigned int lvolume, unsigned int rvolume);
   void SetGBAVolume(int device_number, unsigned int lvolume, unsigned int rvolume);
 
-  void StartLogDTKAudio(const std::string& filename);
+  void StartLogDTKAudio(const std::string& filename, AudioCommon::AudioDumpFormat format);
   void StopLogDTKAudio();
 
-  void StartLogDSPAudio(const std::string& filename);
+  void StartLogDSPAudio(const std::string& filename, AudioCommon::AudioDumpFormat format);
   void StopLogDSPAudio();
 
   // 54000000 doesn't work here as it doesn't evenly divide with 32000, but 108000000 does
@@ -60,8 +64,6 @@ private:
   static constexpr float CONTROL_FACTOR = 0.2f;
   static constexpr u32 CONTROL_AVG = 32;  // In freq_shift per FIFO size offset
 
-  const unsigned int SURROUND_CHANNELS = 6;
-
   class MixerFifo final
   {
   public:
@@ -72,19 +74,24 @@ private:
     }
     void DoState(PointerWrap& p);
     void PushSamples(const short* samples, unsigned int num_samples);
-    unsigned int Mix(short* samples, unsigned int numSamples, bool consider_framelimit,
-                     float emulationspeed, int timing_variance);
+    unsigned int Mix(s32* samples, unsigned int numSamples, bool consider_framelimit,
+                     float emulationspeed, int buffer_ms);
     void SetInputSampleRateDivisor(unsigned int rate_divisor);
     unsigned int GetInputSampleRateDivisor() const;
     void SetVolume(unsigned int lvolume, unsigned int rvolume);
     std::pair<s32, s32> GetVolume() const;
     unsigned int AvailableSamples() const;
+    // Whether samples were pushed between the last two calls to Mix, and whether the last call
+    // ran out of samples
+    bool WasPushedTo() const { return m_was_pushed_to; }
+    bool RanOut() const { return m_ran_out; }
 
   private:
     Mixer* m_mixer;
     unsigned m_input_sample_rate_divisor;
     bool m_little_endian;
-    std::array<short, MAX_SAMPLES * 2> m_buffer{};
+    // The first frame is mirrored after the end of the ring, see MixerResample::ResampleAdd
+    std::array<short, MAX_SAMPLES * 2 + 2> m_buffer{};
     std::atomic<u32> m_indexW{0};
     std::atomic<u32> m_indexR{0};
     // Volume ranges from 0-256
@@ -92,8 +99,14 @@ private:
     std::atomic<s32> m_RVolume{256};
     float m_numLeftI = 0.0f;
     u32 m_frac = 0;
+    u32 m_last_mixed_indexW = 0;
+    bool m_was_pushed_to = false;
+    bool m_ran_out = false;
   };
 
+  unsigned int MixAll(short* samples, unsigned int num_samples);
+  void UpdateLatency(unsigned int requested_samples, unsigned int buffered_samples, bool ran_out);
+
   void RefreshConfig();
 
   MixerFifo m_dma_mixer{this, FIXED_SAMPLE_RATE_DIVIDEND / 32000, false};
@@ -108,11 +121,19 @@ private:
 
   bool m_is_stretching = false;
   AudioCommon::AudioStretcher m_stretcher;
-  AudioCommon::SurroundDecoder m_surround_decoder;
+  // Only exists while DPLII is enabled, as it has its own thread and large buffers
+  std::unique_ptr<AudioCommon::SurroundDecoder> m_surround_decoder;
+  AudioCommon::AdaptiveLatency m_latency;
   std::array<short, MAX_SAMPLES * 2> m_scratch_buffer{};
+  // All FIFOs are added up here before the result is clamped once
+  std::array<s32, MAX_SAMPLES * 2> m_mix_buffer{};
 
   WaveFileWriter m_wave_writer_dtk;
   WaveFileWriter m_wave_writer_dsp;
+  AudioCommon::FlacFileWriter m_flac_writer_dtk;
+  AudioCommon::FlacFileWriter m_flac_writer_dsp;
+  AudioCommon::AudioDumpFormat m_dtk_dump_format = AudioCommon::AudioDumpFormat::WAV;
+  AudioCommon::AudioDumpFormat m_dsp_dump_format = AudioCommon::AudioDumpFormat::WAV;
 
   bool m_log_dtk_audio = false;
   bool m_log_dsp_audio = false;
@@ -120,6 +141,8 @@ private:
   float m_config_emulation_speed;
   int m_config_timing_variance;
   bool m_config_audio_stretch;
+  int m_config_audio_stretch_latency;
+  bool m_config_low_latency;
 
   Config::ConfigChangedCallbackID m_config_changed_callback_id;
 };
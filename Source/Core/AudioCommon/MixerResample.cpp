@@ -0,0 +1,215 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AudioCommon/MixerResample.h"
+
+#include <algorithm>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+
+#if defined(_M_X86_64)
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace AudioCommon::MixerResample
+{
+// The interpolation wraps around in 32 bits for extreme sample differences, so it is done with
+// unsigned arithmetic to match the vector code.
+static s32 Interpolate(s16 current, s16 next, u16 frac)
+{
+  const u32 sum = (static_cast<u32>(current) << 16) + static_cast<u32>(next - current) * frac;
+  return static_cast<s32>(sum) >> 16;
+}
+
+u32 ResampleAddGeneric(s32* out, u32 num_frames, const s16* ring, u32 index_mask, u32 index_w,
+                       bool swap_bytes, u32 ratio, s32 lvolume, s32 rvolume, u32* index_r,
+                       u32* frac)
+{
+  const auto read = [&](u32 index) -> s16 {
+    const s16 sample = ring[index & index_mask];
+    return swap_bytes ? static_cast<s16>(Common::swap16(static_cast<u16>(sample))) : sample;
+  };
+
+  u32 index = *index_r;
+  u32 f = *frac;
+  u32 frame = 0;
+  for (; frame < num_frames && ((index_w - index) & index_mask) > 2; ++frame)
+  {
+    const s32 sample_l = Interpolate(read(index), read(index + 2), static_cast<u16>(f));
+    const s32 sample_r = Interpolate(read(index + 1), read(index + 3), static_cast<u16>(f));
+    out[frame * 2] += (sample_r * rvolume) >> 8;
+    out[frame * 2 + 1] += (sample_l * lvolume) >> 8;
+
+    f += ratio;
+    index += 2 * static_cast<u16>(f >> 16);
+    f &= 0xffff;
+  }
+
+  *index_r = index;
+  *frac = f;
+  return frame;
+}
+
+void ClampToS16Generic(s16* out, const s32* in, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+    out[i] = static_cast<s16>(std::clamp(in[i], -32767, 32767));
+}
+
+// Two output frames are rendered per iteration. The positions of the frames are stepped in scalar
+// code, since they depend on the fraction, and each frame is loaded together with the next one,
+// which the mirrored first frame at the end of the ring makes possible without wrapping.
+
+#if defined(_M_X86_64)
+FUNCTION_TARGET_SSR41
+static u32 ResampleAddSSE41(s32* out, u32 num_frames, const s16* ring, u32 index_mask,
+                            u32 index_w, bool swap_bytes, u32 ratio, s32 lvolume, s32 rvolume,
+                            u32* index_r, u32* frac)
+{
+  const __m128i volumes = _mm_setr_epi32(lvolume, rvolume, lvolume, rvolume);
+  u32 index = *index_r;
+  u32 f = *frac;
+  u32 frame = 0;
+  for (; frame + 2 <= num_frames; frame += 2)
+  {
+    const u32 f1 = f + ratio;
+    const u32 index1 = index + 2 * static_cast<u16>(f1 >> 16);
+    if (((index_w - index) & index_mask) <= 2 || ((index_w - index1) & index_mask) <= 2)
+      break;
+
+    __m128i in = _mm_unpacklo_epi64(
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ring + (index & index_mask))),
+        _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ring + (index1 & index_mask))));
+    if (swap_bytes)
+      in = _mm_or_si128(_mm_slli_epi16(in, 8), _mm_srli_epi16(in, 8));
+
+    const __m128i current = _mm_cvtepi16_epi32(_mm_shuffle_epi32(in, _MM_SHUFFLE(3, 1, 2, 0)));
+    const __m128i next = _mm_cvtepi16_epi32(_mm_shuffle_epi32(in, _MM_SHUFFLE(3, 1, 3, 1)));
+    const __m128i fracs = _mm_setr_epi32(static_cast<u16>(f), static_cast<u16>(f),
+                                         static_cast<u16>(f1), static_cast<u16>(f1));
+    __m128i samples = _mm_add_epi32(_mm_slli_epi32(current, 16),
+                                    _mm_mullo_epi32(_mm_sub_epi32(next, current), fracs));
+    samples = _mm_srai_epi32(_mm_mullo_epi32(_mm_srai_epi32(samples, 16), volumes), 8);
+    // Swap the channels of both frames
+    samples = _mm_shuffle_epi32(samples, _MM_SHUFFLE(2, 3, 0, 1));
+
+    __m128i* dst = reinterpret_cast<__m128i*>(out + frame * 2);
+    _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), samples));
+
+    const u32 f2 = (f1 & 0xffff) + ratio;
+    index = index1 + 2 * static_cast<u16>(f2 >> 16);
+    f = f2 & 0xffff;
+  }
+
+  *index_r = index;
+  *frac = f;
+  return frame + ResampleAddGeneric(out + frame * 2, num_frames - frame, ring, index_mask,
+                                    index_w, swap_bytes, ratio, lvolume, rvolume, index_r, frac);
+}
+
+// SSE2 is always available on x86-64
+static void ClampToS16SSE2(s16* out, const s32* in, size_t count)
+{
+  const size_t vector_count = count & ~size_t(7);
+  const __m128i min = _mm_set1_epi16(-32767);
+  for (size_t i = 0; i < vector_count; i += 8)
+  {
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),
+                     _mm_max_epi16(_mm_packs_epi32(low, high), min));
+  }
+
+  ClampToS16Generic(out + vector_count, in + vector_count, count - vector_count);
+}
+#elif defined(_M_ARM_64)
+static u32 ResampleAddNEON(s32* out, u32 num_frames, const s16* ring, u32 index_mask,
+                           u32 index_w, bool swap_bytes, u32 ratio, s32 lvolume, s32 rvolume,
+                           u32* index_r, u32* frac)
+{
+  const s32 initial_volumes[4] = {lvolume, rvolume, lvolume, rvolume};
+  const int32x4_t volumes = vld1q_s32(initial_volumes);
+  u32 index = *index_r;
+  u32 f = *frac;
+  u32 frame = 0;
+  for (; frame + 2 <= num_frames; frame += 2)
+  {
+    const u32 f1 = f + ratio;
+    const u32 index1 = index + 2 * static_cast<u16>(f1 >> 16);
+    if (((index_w - index) & index_mask) <= 2 || ((index_w - index1) & index_mask) <= 2)
+      break;
+
+    int16x4_t in0 = vld1_s16(ring + (index & index_mask));
+    int16x4_t in1 = vld1_s16(ring + (index1 & index_mask));
+    if (swap_bytes)
+    {
+      in0 = vreinterpret_s16_u8(vrev16_u8(vreinterpret_u8_s16(in0)));
+      in1 = vreinterpret_s16_u8(vrev16_u8(vreinterpret_u8_s16(in1)));
+    }
+
+    const int32x2x2_t frames = vzip_s32(vreinterpret_s32_s16(in0), vreinterpret_s32_s16(in1));
+    const int32x4_t current = vmovl_s16(vreinterpret_s16_s32(frames.val[0]));
+    const int32x4_t next = vmovl_s16(vreinterpret_s16_s32(frames.val[1]));
+    const s32 frame_fracs[4] = {static_cast<u16>(f), static_cast<u16>(f), static_cast<u16>(f1),
+                                static_cast<u16>(f1)};
+    int32x4_t samples = vaddq_s32(vshlq_n_s32(current, 16),
+                                  vmulq_s32(vsubq_s32(next, current), vld1q_s32(frame_fracs)));
+    samples = vshrq_n_s32(vmulq_s32(vshrq_n_s32(samples, 16), volumes), 8);
+    // Swap the channels of both frames
+    samples = vrev64q_s32(samples);
+
+    vst1q_s32(out + frame * 2, vaddq_s32(vld1q_s32(out + frame * 2), samples));
+
+    const u32 f2 = (f1 & 0xffff) + ratio;
+    index = index1 + 2 * static_cast<u16>(f2 >> 16);
+    f = f2 & 0xffff;
+  }
+
+  *index_r = index;
+  *frac = f;
+  return frame + ResampleAddGeneric(out + frame * 2, num_frames - frame, ring, index_mask,
+                                    index_w, swap_bytes, ratio, lvolume, rvolume, index_r, frac);
+}
+
+static void ClampToS16NEON(s16* out, const s32* in, size_t count)
+{
+  const size_t vector_count = count & ~size_t(3);
+  const int16x4_t min = vdup_n_s16(-32767);
+  for (size_t i = 0; i < vector_count; i += 4)
+    vst1_s16(out + i, vmax_s16(vqmovn_s32(vld1q_s32(in + i)), min));
+
+  ClampToS16Generic(out + vector_count, in + vector_count, count - vector_count);
+}
+#endif
+
+u32 ResampleAdd(s32* out, u32 num_frames, const s16* ring, u32 index_mask, u32 index_w,
+                bool swap_bytes, u32 ratio, s32 lvolume, s32 rvolume, u32* index_r, u32* frac)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+  {
+    return ResampleAddSSE41(out, num_frames, ring, index_mask, index_w, swap_bytes, ratio, lvolume,
+                            rvolume, index_r, frac);
+  }
+#elif defined(_M_ARM_64)
+  return ResampleAddNEON(out, num_frames, ring, index_mask, index_w, swap_bytes, ratio, lvolume,
+                         rvolume, index_r, frac);
+#endif
+  return ResampleAddGeneric(out, num_frames, ring, index_mask, index_w, swap_bytes, ratio, lvolume,
+                            rvolume, index_r, frac);
+}
+
+void ClampToS16(s16* out, const s32* in, size_t count)
+{
+#if defined(_M_X86_64)
+  return ClampToS16SSE2(out, in, count);
+#elif defined(_M_ARM_64)
+  return ClampToS16NEON(out, in, count);
+#endif
+  ClampToS16Generic(out, in, count);
+}
+}  // namespace AudioCommon::MixerResample
@@ -0,0 +1,36 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Per-sample loops of the Mixer. They live in their own file so that they can use SIMD
+// instructions and be tested on their own. The vectorized versions produce exactly the same
+// output as the generic ones.
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace AudioCommon::MixerResample
+{
+// Resamples stereo frames from a ring buffer of interleaved samples with linear interpolation,
+// multiplies them by 8.8 volumes and adds them to a 32-bit buffer without clamping. The first
+// channel of each input frame is scaled by lvolume and added to the second channel of the
+// output, and vice versa. <index_r> and <frac> (a 16-bit fraction of a frame) are advanced by
+// <ratio> per output frame.
+//
+// Stops after <num_frames> frames or once only one frame is left before <index_w>, and returns the
+// number of frames written. <ring> must hold index_mask + 3 samples, the last two being a copy of
+// the first frame, so that each frame can be read together with the next one.
+u32 ResampleAdd(s32* out, u32 num_frames, const s16* ring, u32 index_mask, u32 index_w,
+                bool swap_bytes, u32 ratio, s32 lvolume, s32 rvolume, u32* index_r, u32* frac);
+
+// Clamps mixed samples to [-32767, 32767].
+void ClampToS16(s16* out, const s32* in, size_t count);
+
+// Reference implementations, always used on CPUs without the needed instruction sets.
+u32 ResampleAddGeneric(s32* out, u32 num_frames, const s16* ring, u32 index_mask, u32 index_w,
+                       bool swap_bytes, u32 ratio, s32 lvolume, s32 rvolume, u32* index_r,
+                       u32* frac);
+void ClampToS16Generic(s16* out, const s32* in, size_t count);
+}  // namespace AudioCommon::MixerResample
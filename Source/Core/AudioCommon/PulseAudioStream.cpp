@@ -14,6 +14,7 @@
 namespace
 {
 const size_t BUFFER_SAMPLES = 512;  // ~10 ms - needs to be at least 240 for surround
+const size_t LOW_LATENCY_BUFFER_SAMPLES = 256;  // ~5 ms, used in low latency mode
 }
 
 PulseAudio::PulseAudio() = default;
@@ -117,8 +118,8 @@ bool PulseAudio::PulseInit()
   m_pa_ba.minreq = -1;     // don't read every byte, try to group them _a bit_
   m_pa_ba.prebuf = -1;     // start as early as possible
   m_pa_ba.tlength =
-      BUFFER_SAMPLES * m_channels *
-      m_bytespersample;  // designed latency, only change this flag for low latency output
+      (Config::Get(Config::MAIN_AUDIO_LOW_LATENCY) ? LOW_LATENCY_BUFFER_SAMPLES : BUFFER_SAMPLES) *
+      m_channels * m_bytespersample;  // designed latency
   pa_stream_flags flags = pa_stream_flags(PA_STREAM_INTERPOLATE_TIMING | PA_STREAM_ADJUST_LATENCY |
                                           PA_STREAM_AUTO_TIMING_UPDATE);
   m_pa_error = pa_stream_connect_playback(m_pa_s, nullptr, &m_pa_ba, flags, nullptr, nullptr);
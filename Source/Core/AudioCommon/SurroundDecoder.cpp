@@ -4,88 +4,159 @@
 #include "AudioCommon/SurroundDecoder.h"
 
 #include <FreeSurround/FreeSurroundDecoder.h>
+#include <algorithm>
 #include <limits>
 
+#include "Common/Assert.h"
+#include "Common/Thread.h"
+
+#if defined(_M_X86_64)
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
 namespace AudioCommon
 {
-constexpr size_t STEREO_CHANNELS = 2;
-constexpr size_t SURROUND_CHANNELS = 6;
+// Divides rather than multiplies by the reciprocal, so that all paths give the same results.
+static void ConvertToFloat(float* out, const short* in, size_t count)
+{
+  constexpr float scale = static_cast<float>(std::numeric_limits<short>::max());
+  size_t i = 0;
+
+#if defined(_M_X86_64)
+  const __m128 vector_scale = _mm_set1_ps(scale);
+  for (; i + 8 <= count; i += 8)
+  {
+    const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+    const __m128i low = _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i high = _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    _mm_storeu_ps(out + i, _mm_div_ps(_mm_cvtepi32_ps(low), vector_scale));
+    _mm_storeu_ps(out + i + 4, _mm_div_ps(_mm_cvtepi32_ps(high), vector_scale));
+  }
+#elif defined(_M_ARM_64)
+  const float32x4_t vector_scale = vdupq_n_f32(scale);
+  for (; i + 8 <= count; i += 8)
+  {
+    const int16x8_t samples = vld1q_s16(in + i);
+    vst1q_f32(out + i, vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples))), vector_scale));
+    vst1q_f32(out + i + 4,
+              vdivq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples))), vector_scale));
+  }
+#endif
+
+  for (; i < count; ++i)
+    out[i] = in[i] / scale;
+}
 
 SurroundDecoder::SurroundDecoder(u32 sample_rate, u32 frame_block_size)
     : m_sample_rate(sample_rate), m_frame_block_size(frame_block_size)
 {
+  ASSERT(m_frame_block_size <= MAX_FRAME_BLOCK_SIZE && RING_FRAMES % m_frame_block_size == 0);
+
   m_fsdecoder = std::make_unique<DPL2FSDecoder>();
   m_fsdecoder->Init(cs_5point1, m_frame_block_size, m_sample_rate);
-}
 
-SurroundDecoder::~SurroundDecoder() = default;
+  m_thread = std::thread(&SurroundDecoder::DecoderThread, this);
+}
 
-void SurroundDecoder::Clear()
+SurroundDecoder::~SurroundDecoder()
 {
-  m_fsdecoder->flush();
-  m_decoded_fifo.clear();
+  m_running.Clear();
+  m_frames_put_event.Set();
+  m_thread.join();
 }
 
 // Currently only 6 channels are supported.
 size_t SurroundDecoder::QueryFramesNeededForSurroundOutput(const size_t output_frames) const
 {
-  if (m_decoded_fifo.size() < output_frames * SURROUND_CHANNELS)
-  {
-    // Output stereo frames needed to have at least the desired number of surround frames
-    size_t frames_needed = output_frames - m_decoded_fifo.size() / SURROUND_CHANNELS;
-    return frames_needed + m_frame_block_size - frames_needed % m_frame_block_size;
-  }
-
-  return 0;
+  // The frames put in now can only be received after the decoder has got a whole block, so two
+  // callbacks worth of frames on top of a block keep the next callback from running dry.
+  const u32 buffered = m_frames_put.load(std::memory_order_relaxed) -
+                       m_frames_received.load(std::memory_order_relaxed);
+  const size_t wanted = std::min<size_t>(output_frames * 2 + m_frame_block_size, RING_FRAMES);
+  return wanted > buffered ? wanted - buffered : 0;
 }
 
-// Receive and decode samples
+// Queue samples for the decoder thread
 void SurroundDecoder::PutFrames(const short* in, const size_t num_frames_in)
 {
-  // Maybe check if it is really power-of-2?
-  s64 remaining_frames = static_cast<s64>(num_frames_in);
-  size_t frame_index = 0;
+  const u32 put = m_frames_put.load(std::memory_order_relaxed);
+  const u32 buffered = put - m_frames_received.load(std::memory_order_relaxed);
+  const u32 num_frames = static_cast<u32>(std::min<size_t>(num_frames_in, RING_FRAMES - buffered));
 
-  while (remaining_frames > 0)
-  {
-    // Convert to float
-    for (size_t i = 0, end = m_frame_block_size * STEREO_CHANNELS; i < end; ++i)
-    {
-      m_float_conversion_buffer[i] = in[i + frame_index * STEREO_CHANNELS] /
-                                     static_cast<float>(std::numeric_limits<short>::max());
-    }
+  const u32 start = put & RING_MASK;
+  const u32 first_part = std::min(num_frames, RING_FRAMES - start);
+  std::copy_n(in, first_part * STEREO_CHANNELS, &m_stereo_ring[start * STEREO_CHANNELS]);
+  std::copy_n(in + first_part * STEREO_CHANNELS, (num_frames - first_part) * STEREO_CHANNELS,
+              m_stereo_ring.data());
+
+  m_frames_put.store(put + num_frames, std::memory_order_release);
+  m_frames_put_event.Set();
+}
+
+size_t SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
+{
+  const u32 received = m_frames_received.load(std::memory_order_relaxed);
+  const u32 available = m_frames_decoded.load(std::memory_order_acquire) - received;
+  const u32 num_frames = static_cast<u32>(std::min<size_t>(num_frames_out, available));
+
+  const u32 start = received & RING_MASK;
+  const u32 first_part = std::min(num_frames, RING_FRAMES - start);
+  std::copy_n(&m_surround_ring[start * SURROUND_CHANNELS], first_part * SURROUND_CHANNELS, out);
+  std::copy_n(m_surround_ring.data(), (num_frames - first_part) * SURROUND_CHANNELS,
+              out + first_part * SURROUND_CHANNELS);
+  std::fill(out + num_frames * SURROUND_CHANNELS, out + num_frames_out * SURROUND_CHANNELS, 0.0f);
 
-    // Decode
-    const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
+  m_frames_received.store(received + num_frames, std::memory_order_release);
+  return num_frames;
+}
+
+void SurroundDecoder::DecoderThread()
+{
+  Common::SetCurrentThreadName("DPL2 decoder");
+
+  while (true)
+  {
+    m_frames_put_event.Wait();
+    if (!m_running.IsSet())
+      return;
 
-    // Add to ring buffer and fix channel mapping
-    // Maybe modify FreeSurround to output the correct mapping?
-    // FreeSurround:
-    // FL | FC | FR | BL | BR | LFE
-    // Most backends:
-    // FL | FR | FC | LFE | BL | BR
-    for (size_t i = 0; i < m_frame_block_size; ++i)
+    u32 decoded = m_frames_decoded.load(std::memory_order_relaxed);
+    while (m_frames_put.load(std::memory_order_acquire) - decoded >= m_frame_block_size)
     {
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 0]);  // LEFTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 2]);  // RIGHTFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 1]);  // CENTREFRONT
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 5]);  // sub/lfe
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 3]);  // LEFTREAR
-      m_decoded_fifo.push(dpl2_fs[i * SURROUND_CHANNELS + 4]);  // RIGHTREAR
+      DecodeBlock(decoded);
+      decoded += m_frame_block_size;
+      m_frames_decoded.store(decoded, std::memory_order_release);
     }
-
-    remaining_frames = remaining_frames - static_cast<int>(m_frame_block_size);
-    frame_index = frame_index + m_frame_block_size;
   }
 }
 
-void SurroundDecoder::ReceiveFrames(float* out, const size_t num_frames_out)
+void SurroundDecoder::DecodeBlock(u32 first_frame)
 {
-  // Copy to output array with desired num_frames_out
-  for (size_t i = 0, num_samples_output = num_frames_out * SURROUND_CHANNELS;
-       i < num_samples_output; ++i)
+  // Blocks always start at a multiple of the block size, so they never wrap around the rings
+  const u32 start = first_frame & RING_MASK;
+  ConvertToFloat(m_float_conversion_buffer.data(), &m_stereo_ring[start * STEREO_CHANNELS],
+                 m_frame_block_size * STEREO_CHANNELS);
+
+  // Decode
+  const float* dpl2_fs = m_fsdecoder->decode(m_float_conversion_buffer.data());
+
+  // Fix channel mapping
+  // Maybe modify FreeSurround to output the correct mapping?
+  // FreeSurround:
+  // FL | FC | FR | BL | BR | LFE
+  // Most backends:
+  // FL | FR | FC | LFE | BL | BR
+  float* out = &m_surround_ring[start * SURROUND_CHANNELS];
+  for (size_t i = 0; i < m_frame_block_size; ++i)
   {
-    out[i] = m_decoded_fifo.pop_front();
+    out[i * SURROUND_CHANNELS + 0] = dpl2_fs[i * SURROUND_CHANNELS + 0];  // LEFTFRONT
+    out[i * SURROUND_CHANNELS + 1] = dpl2_fs[i * SURROUND_CHANNELS + 2];  // RIGHTFRONT
+    out[i * SURROUND_CHANNELS + 2] = dpl2_fs[i * SURROUND_CHANNELS + 1];  // CENTREFRONT
+    out[i * SURROUND_CHANNELS + 3] = dpl2_fs[i * SURROUND_CHANNELS + 5];  // sub/lfe
+    out[i * SURROUND_CHANNELS + 4] = dpl2_fs[i * SURROUND_CHANNELS + 3];  // LEFTREAR
+    out[i * SURROUND_CHANNELS + 5] = dpl2_fs[i * SURROUND_CHANNELS + 4];  // RIGHTREAR
   }
 }
 
@@ -4,32 +4,62 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <thread>
 
 #include "Common/CommonTypes.h"
-#include "Common/FixedSizeQueue.h"
+#include "Common/Event.h"
+#include "Common/Flag.h"
 
 class DPL2FSDecoder;
 
 namespace AudioCommon
 {
+// Decodes stereo frames to 5.1 surround on its own thread. The audio callback puts in stereo
+// frames and receives the frames which were decoded since earlier calls. Both directions go
+// through lock-free rings, so the audio callback never waits for the decoder.
 class SurroundDecoder
 {
 public:
   explicit SurroundDecoder(u32 sample_rate, u32 frame_block_size);
   ~SurroundDecoder();
+  // Returns how many stereo frames should be put in now, so that later calls can receive
+  // <output_frames> frames without waiting for the decoder.
   size_t QueryFramesNeededForSurroundOutput(const size_t output_frames) const;
   void PutFrames(const short* in, const size_t num_frames_in);
-  void ReceiveFrames(float* out, const size_t num_frames_out);
-  void Clear();
+  // Returns the number of frames which were received. The rest of <out> is filled with silence.
+  size_t ReceiveFrames(float* out, const size_t num_frames_out);
 
 private:
+  static constexpr size_t STEREO_CHANNELS = 2;
+  static constexpr size_t SURROUND_CHANNELS = 6;
+  // Frames which can be in flight, either waiting to be decoded or waiting to be received.
+  // A multiple of every block size, so that blocks never wrap around.
+  static constexpr u32 RING_FRAMES = 16384;
+  static constexpr u32 RING_MASK = RING_FRAMES - 1;
+  static constexpr u32 MAX_FRAME_BLOCK_SIZE = 4096;
+
+  void DecoderThread();
+  void DecodeBlock(u32 first_frame);
+
   u32 m_sample_rate;
   u32 m_frame_block_size;
 
   std::unique_ptr<DPL2FSDecoder> m_fsdecoder;
-  std::array<float, 32768> m_float_conversion_buffer;
-  Common::FixedSizeQueue<float, 32768> m_decoded_fifo;
+  std::array<float, MAX_FRAME_BLOCK_SIZE * STEREO_CHANNELS> m_float_conversion_buffer;
+
+  std::array<short, RING_FRAMES * STEREO_CHANNELS> m_stereo_ring{};
+  std::array<float, RING_FRAMES * SURROUND_CHANNELS> m_surround_ring{};
+  // Running frame counts, which wrap around. The frames in [decoded, put) are waiting to be
+  // decoded, and the frames in [received, decoded) are waiting to be received.
+  std::atomic<u32> m_frames_put{0};
+  std::atomic<u32> m_frames_decoded{0};
+  std::atomic<u32> m_frames_received{0};
+
+  Common::Flag m_running{true};
+  Common::Event m_frames_put_event;
+  std::thread m_thread;
 };
 
 }  // namespace AudioCommon
@@ -41,6 +41,12 @@ public:
   {
     return Crypt(nullptr, nullptr, buf_in, buf_out, len);
   }
+
+  // Crypts count independent buffers of len bytes, each with its own IV (or a zero IV for all of
+  // them if ivs is null). CBC encryption of a single buffer can't be pipelined, but independent
+  // buffers can be interleaved, so prefer this over calling Crypt in a loop.
+  virtual bool CryptMultiple(const u8* const* ivs, const u8* const* bufs_in, u8* const* bufs_out,
+                             size_t count, size_t len) const;
 };
 
 std::unique_ptr<Context> CreateContextEncrypt(const u8* key);
@@ -45,6 +45,7 @@ extern const Info<bool> GFX_SHOW_VTIMES;
 extern const Info<bool> GFX_SHOW_GRAPHS;
 extern const Info<bool> GFX_SHOW_SPEED;
 extern const Info<bool> GFX_SHOW_SPEED_COLORS;
+extern const Info<bool> GFX_SHOW_AUDIO_STATS;
 extern const Info<int> GFX_PERF_SAMP_WINDOW;
 extern const Info<bool> GFX_SHOW_NETPLAY_PING;
 extern const Info<bool> GFX_SHOW_NETPLAY_MESSAGES;
@@ -154,8 +155,10 @@ static constexpr int GFX_STEREO_CONVERGENCE_MAXIMUM = 200;
 
 extern const Info<bool> GFX_HACK_EFB_ACCESS_ENABLE;
 extern const Info<bool> GFX_HACK_EFB_DEFER_INVALIDATION;
+extern const Info<bool> GFX_HACK_EFB_ACCESS_PREDICTIVE;
 extern const Info<int> GFX_HACK_EFB_ACCESS_TILE_SIZE;
 extern const Info<bool> GFX_HACK_BBOX_ENABLE;
+extern const Info<bool> GFX_HACK_BBOX_CPU;
 extern const Info<bool> GFX_HACK_FORCE_PROGRESSIVE;
 extern const Info<bool> GFX_HACK_SKIP_EFB_COPY_TO_RAM;
 extern const Info<bool> GFX_HACK_SKIP_XFB_COPY_TO_RAM;
@@ -58,6 +58,7 @@ const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY{{System::Main, "Core", "D
 const Info<int> MAIN_AUDIO_LATENCY{{System::Main, "Core", "AudioLatency"}, 20};
 const Info<bool> MAIN_AUDIO_STRETCH{{System::Main, "Core", "AudioStretch"}, false};
 const Info<int> MAIN_AUDIO_STRETCH_LATENCY{{System::Main, "Core", "AudioStretchMaxLatency"}, 80};
+const Info<bool> MAIN_AUDIO_LOW_LATENCY{{System::Main, "Core", "AudioLowLatency"}, false};
 const Info<std::string> MAIN_MEMCARD_A_PATH{{System::Main, "Core", "MemcardAPath"}, ""};
 const Info<std::string> MAIN_MEMCARD_B_PATH{{System::Main, "Core", "MemcardBPath"}, ""};
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot)
@@ -198,6 +199,11 @@ const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE{{System::Main, "Core", "SyncGpuMaxDis
 const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE{{System::Main, "Core", "SyncGpuMinDistance"}, -200000};
 const Info<float> MAIN_SYNC_GPU_OVERCLOCK{{System::Main, "Core", "SyncGpuOverclock"}, 1.0f};
 const Info<bool> MAIN_FAST_DISC_SPEED{{System::Main, "Core", "FastDiscSpeed"}, false};
+const Info<int> MAIN_DVD_READ_AHEAD_MIB{{System::Main, "Core", "DVDReadAheadMiB"}, 16};
+const Info<int> MAIN_WIA_RVZ_CACHE_MIB{{System::Main, "Core", "WIARVZCacheMiB"}, 32};
+const Info<int> MAIN_SECTOR_CACHE_MIB{{System::Main, "Core", "SectorCacheMiB"}, 16};
+const Info<bool> MAIN_MAP_DISC_IMAGES{{System::Main, "Core", "MapDiscImages"}, false};
+const Info<bool> MAIN_CACHE_DIRECTORY_SCANS{{System::Main, "Core", "CacheDirectoryScans"}, false};
 const Info<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false};
 const Info<bool> MAIN_FLOAT_EXCEPTIONS{{System::Main, "Core", "FloatExceptions"}, false};
 const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS{{System::Main, "Core", "DivByZeroExceptions"},
@@ -230,6 +236,8 @@ GPUDeterminismMode GetGPUDeterminismMode()
     return GPUDeterminismMode::Disabled;
   if (mode == "fake-completion")
     return GPUDeterminismMode::FakeCompletion;
+  if (mode == "observable-sync")
+    return GPUDeterminismMode::ObservableSync;
 
   NOTICE_LOG_FMT(CORE, "Unknown GPU determinism mode {}", mode);
   return GPUDeterminismMode::Auto;
@@ -246,6 +254,7 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<bool> MAIN_SAVE_STATE_DELTAS{{System::Main, "Core", "SaveStateDeltas"}, false};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 const Info<bool> MAIN_WII_WIILINK_ENABLE{{System::Main, "Core", "EnableWiiLink"}, false};
@@ -273,8 +282,11 @@ const Info<bool> MAIN_DISABLE_SCREENSAVER{{System::Main, "Display", "DisableScre
 const Info<bool> MAIN_DSP_THREAD{{System::Main, "DSP", "DSPThread"}, false};
 const Info<bool> MAIN_DSP_CAPTURE_LOG{{System::Main, "DSP", "CaptureLog"}, false};
 const Info<bool> MAIN_DSP_JIT{{System::Main, "DSP", "EnableJIT"}, true};
+const Info<bool> MAIN_DSP_PARALLEL_AX_VOICES{{System::Main, "DSP", "ParallelAXVoices"}, false};
 const Info<bool> MAIN_DUMP_AUDIO{{System::Main, "DSP", "DumpAudio"}, false};
 const Info<bool> MAIN_DUMP_AUDIO_SILENT{{System::Main, "DSP", "DumpAudioSilent"}, false};
+const Info<AudioCommon::AudioDumpFormat> MAIN_DUMP_AUDIO_FORMAT{
+    {System::Main, "DSP", "DumpAudioFormat"}, AudioCommon::AudioDumpFormat::WAV};
 const Info<bool> MAIN_DUMP_UCODE{{System::Main, "DSP", "DumpUCode"}, false};
 const Info<std::string> MAIN_AUDIO_BACKEND{{System::Main, "DSP", "Backend"},
                                            AudioCommon::GetDefaultSoundBackend()};
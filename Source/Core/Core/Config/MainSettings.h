@@ -29,6 +29,7 @@ enum class CPUCore;
 
 namespace AudioCommon
 {
+enum class AudioDumpFormat;
 enum class DPL2Quality;
 }
 
@@ -74,6 +75,7 @@ extern const Info<AudioCommon::DPL2Quality> MAIN_DPL2_QUALITY;
 extern const Info<int> MAIN_AUDIO_LATENCY;
 extern const Info<bool> MAIN_AUDIO_STRETCH;
 extern const Info<int> MAIN_AUDIO_STRETCH_LATENCY;
+extern const Info<bool> MAIN_AUDIO_LOW_LATENCY;
 extern const Info<std::string> MAIN_MEMCARD_A_PATH;
 extern const Info<std::string> MAIN_MEMCARD_B_PATH;
 const Info<std::string>& GetInfoForMemcardPath(ExpansionInterface::Slot slot);
@@ -116,6 +118,18 @@ extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+// Size of the cache for data read ahead of sequential disc reads. 0 disables reading ahead.
+extern const Info<int> MAIN_DVD_READ_AHEAD_MIB;
+// Size of the cache for decompressed groups of each WIA/RVZ file that is open.
+extern const Info<int> MAIN_WIA_RVZ_CACHE_MIB;
+// Size of the cache for decompressed blocks of each GCZ file that is open.
+extern const Info<int> MAIN_SECTOR_CACHE_MIB;
+// Whether uncompressed disc images are memory mapped instead of read using file I/O.
+extern const Info<bool> MAIN_MAP_DISC_IMAGES;
+// Whether the directory listings of extracted games and Riivolution mods are cached between boots.
+// A file that was overwritten in place with a different size is only noticed when it's opened, at
+// which point the game has to be restarted to see the new size, so this is off by default.
+extern const Info<bool> MAIN_CACHE_DIRECTORY_SCANS;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -137,9 +151,10 @@ enum class GPUDeterminismMode
 {
   Auto,
   Disabled,
-  // This is currently the only mode.  There will probably be at least
-  // one more at some point.
   FakeCompletion,
+  // Like Auto, but the CPU thread only waits for the GPU thread when it needs the results of
+  // rendering (EFB access, bounding box, perf queries), not on every GP register access.
+  ObservableSync,
 };
 extern const Info<std::string> MAIN_GPU_DETERMINISM_MODE;
 GPUDeterminismMode GetGPUDeterminismMode();
@@ -150,6 +165,10 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+// Saves state slots with State::SaveDeltaAs. Slots that build on a slot being overwritten are
+// saved in full first, but deleting or replacing slot files outside of Dolphin still makes the
+// slots that build on them unloadable, so this is off by default.
+extern const Info<bool> MAIN_SAVE_STATE_DELTAS;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
@@ -161,8 +180,12 @@ extern const Info<bool> MAIN_WII_WIILINK_ENABLE;
 extern const Info<bool> MAIN_DSP_THREAD;
 extern const Info<bool> MAIN_DSP_CAPTURE_LOG;
 extern const Info<bool> MAIN_DSP_JIT;
+// Whether AX HLE processes its voices on several threads. Doesn't change the output.
+extern const Info<bool> MAIN_DSP_PARALLEL_AX_VOICES;
 extern const Info<bool> MAIN_DUMP_AUDIO;
 extern const Info<bool> MAIN_DUMP_AUDIO_SILENT;
+// WAV by default, so that existing dumps keep their format. FLAC has to be chosen explicitly.
+extern const Info<AudioCommon::AudioDumpFormat> MAIN_DUMP_AUDIO_FORMAT;
 extern const Info<bool> MAIN_DUMP_UCODE;
 extern const Info<std::string> MAIN_AUDIO_BACKEND;
 extern const Info<int> MAIN_AUDIO_VOLUME;
@@ -61,6 +61,7 @@ public:
 
     layer->Set(Config::GFX_HACK_EFB_ACCESS_ENABLE, m_settings.efb_access_enable);
     layer->Set(Config::GFX_HACK_BBOX_ENABLE, m_settings.bbox_enable);
+    layer->Set(Config::GFX_HACK_BBOX_CPU, m_settings.bbox_cpu);
     layer->Set(Config::GFX_HACK_FORCE_PROGRESSIVE, m_settings.force_progressive);
     layer->Set(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM, m_settings.efb_to_texture_enable);
     layer->Set(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM, m_settings.xfb_to_texture_enable);
@@ -91,6 +92,7 @@ public:
     layer->Set(Config::GFX_HACK_DEFER_EFB_COPIES, m_settings.defer_efb_copies);
     layer->Set(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE, m_settings.efb_access_tile_size);
     layer->Set(Config::GFX_HACK_EFB_DEFER_INVALIDATION, m_settings.efb_access_defer_invalidation);
+    layer->Set(Config::GFX_HACK_EFB_ACCESS_PREDICTIVE, m_settings.efb_access_predictive);
 
     layer->Set(Config::SESSION_USE_FMA, m_settings.use_fma);
 
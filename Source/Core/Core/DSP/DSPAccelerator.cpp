@@ -4,6 +4,7 @@
 #include "Core/DSP/DSPAccelerator.h"
 
 #include <algorithm>
+#include <array>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -160,6 +161,123 @@ u16 Accelerator::Read(const s16* coefs)
   return val;
 }
 
+void Accelerator::ReadSamples(s16* out, u32 count, const s16* coefs)
+{
+  while (count > 0)
+  {
+    // Nothing but a write to YN2 restarts reads, which can only happen in Read
+    if (m_reads_stopped)
+    {
+      std::fill_n(out, count, 0);
+      return;
+    }
+
+    u32 run = 0;
+    switch (m_sample_format)
+    {
+    case 0x00:
+      run = ReadADPCMRun(out, count, coefs);
+      break;
+    case 0x0A:
+    case 0x19:
+      run = ReadPCMRun(out, count);
+      break;
+    }
+
+    // Frame headers, the loop and end addresses and unknown formats take the slow path
+    if (run == 0)
+    {
+      *out = static_cast<s16>(Read(coefs));
+      run = 1;
+    }
+
+    out += run;
+    count -= run;
+  }
+}
+
+u32 Accelerator::ReadADPCMRun(s16* out, u32 count, const s16* coefs)
+{
+  const u32 address = m_current_address;
+
+  // Stop before the sample after which the next frame header is read, and before any sample which
+  // could hit one of the special cases for the end address in Read.
+  u32 run = std::min((address | 15) - address, count);
+  if (m_end_address >= address)
+    run = std::min(run, std::max(m_end_address - address, 2u) - 2);
+  if (run == 0)
+    return 0;
+
+  // A run never leaves its frame, so it covers at most 8 bytes
+  const u32 first_byte = address >> 1;
+  std::array<u8, 8> bytes;
+  ReadMemoryBlock(first_byte, bytes.data(), ((address + run - 1) >> 1) - first_byte + 1);
+
+  const s32 scale = 1 << (m_pred_scale & 0xF);
+  const int coef_idx = (m_pred_scale >> 4) & 0x7;
+  const s32 coef1 = coefs[coef_idx * 2 + 0];
+  const s32 coef2 = coefs[coef_idx * 2 + 1];
+
+  s32 yn1 = m_yn1;
+  s32 yn2 = m_yn2;
+  for (u32 i = 0; i < run; ++i)
+  {
+    const u32 sample_address = address + i;
+    const u8 byte = bytes[(sample_address >> 1) - first_byte];
+    int temp = (sample_address & 1) ? (byte & 0xF) : (byte >> 4);
+    if (temp >= 8)
+      temp -= 16;
+
+    const s32 val32 = (scale * temp) + ((0x400 + coef1 * yn1 + coef2 * yn2) >> 11);
+    yn2 = yn1;
+    yn1 = std::clamp<s32>(val32, -0x7FFF, 0x7FFF);
+    out[i] = static_cast<s16>(yn1);
+  }
+
+  m_yn1 = static_cast<s16>(yn1);
+  m_yn2 = static_cast<s16>(yn2);
+  m_current_address = address + run;
+  return run;
+}
+
+u32 Accelerator::ReadPCMRun(s16* out, u32 count)
+{
+  constexpr u32 MAX_RUN = 32;
+  const u32 address = m_current_address;
+
+  // Stop before the end address and before the address would need to be masked
+  u32 run = std::min({count, MAX_RUN, 0x3fffffff - (address & 0x3fffffff)});
+  if (m_end_address >= address)
+    run = std::min(run, m_end_address - address);
+  if (run == 0)
+    return 0;
+
+  std::array<u8, MAX_RUN * 2> bytes;
+  if (m_sample_format == 0x0A)
+  {
+    ReadMemoryBlock(address * 2, bytes.data(), run * 2);
+    for (u32 i = 0; i < run; ++i)
+      out[i] = static_cast<s16>((bytes[i * 2] << 8) | bytes[i * 2 + 1]);
+  }
+  else
+  {
+    ReadMemoryBlock(address, bytes.data(), run);
+    for (u32 i = 0; i < run; ++i)
+      out[i] = static_cast<s16>(bytes[i] << 8);
+  }
+
+  m_yn2 = run > 1 ? out[run - 2] : m_yn1;
+  m_yn1 = out[run - 1];
+  m_current_address = address + run;
+  return run;
+}
+
+void Accelerator::ReadMemoryBlock(u32 address, u8* dest, u32 size)
+{
+  for (u32 i = 0; i < size; ++i)
+    dest[i] = ReadMemory(address + i);
+}
+
 void Accelerator::DoState(PointerWrap& p)
 {
   p.Do(m_start_address);
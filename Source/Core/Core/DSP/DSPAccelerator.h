@@ -15,6 +15,9 @@ public:
   virtual ~Accelerator() = default;
 
   u16 Read(const s16* coefs);
+  // Reads <count> samples. Behaves exactly like <count> calls to Read, but samples between
+  // frame headers and the loop and end addresses are decoded in bulk, with a single memory read.
+  void ReadSamples(s16* out, u32 count, const s16* coefs);
   // Zelda ucode reads ARAM through 0xffd3.
   u16 ReadD3();
   void WriteD3(u16 value);
@@ -40,6 +43,8 @@ protected:
   virtual void OnEndException() = 0;
   virtual u8 ReadMemory(u32 address) = 0;
   virtual void WriteMemory(u32 address, u8 value) = 0;
+  // Reads <size> consecutive bytes. Can be overridden to avoid a virtual call per byte.
+  virtual void ReadMemoryBlock(u32 address, u8* dest, u32 size);
 
   // DSP accelerator registers.
   u32 m_start_address = 0;
@@ -54,5 +59,11 @@ protected:
   // and updating the current address register, unless the YN2 register is written to.
   // This is kept track of internally; this state is not exposed via any register.
   bool m_reads_stopped = false;
+
+private:
+  // Decode samples up to (but excluding) the next one which needs special handling, and return
+  // the number of decoded samples.
+  u32 ReadADPCMRun(s16* out, u32 count, const s16* coefs);
+  u32 ReadPCMRun(s16* out, u32 count);
 };
 }  // namespace DSP
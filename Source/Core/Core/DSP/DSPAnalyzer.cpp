@@ -60,6 +60,56 @@ constexpr u16 idle_skip_sigs[NUM_IDLE_SIGS][MAX_IDLE_SIG_SIZE + 1] = {
      0, 0},
 };
 
+// Longest polling loop that FindIdleLoops looks for, in words.
+constexpr u16 MAX_IDLE_LOOP_SIZE = 8;
+
+// Whether a loop reading this address can be waiting for something that happens outside of the
+// DSP's own code: the CPU (through the high halves of the mailboxes) or an interrupt handler
+// (through DMEM). Other hardware registers either change by themselves (like DMA status, which is
+// instant in Dolphin) or have side effects when read.
+static bool IsPolledAddress(u16 address)
+{
+  return address < 0xff00 || address == (0xff00 | DSP_DMBH) || address == (0xff00 | DSP_CMBH);
+}
+
+// Whether an instruction can be part of a polling loop: it may load a value, test it or branch
+// out of the loop, but must not change anything a later iteration depends on.
+static bool IsPollingInstruction(const SDSP& dsp, u16 addr, bool* is_load)
+{
+  const UDSPInstruction inst = dsp.ReadIMEM(addr);
+  const DSPOPCTemplate* opcode = GetOpTemplate(inst);
+  if (opcode->extended && GetExtOpTemplate(inst)->opcode != 0x0000)
+    return false;
+
+  switch (opcode->opcode)
+  {
+  case 0x00c0:  // LR
+  {
+    // Only loads into accumulators and AX registers, as loading into the stack registers
+    // pushes them, and loading into SR or CR changes how the code behaves.
+    const u16 reg = inst & 0x1f;
+    const bool is_acc_or_ax = reg == DSP_REG_ACH0 || reg == DSP_REG_ACH1 || reg >= DSP_REG_AXL0;
+    *is_load = true;
+    return is_acc_or_ax && IsPolledAddress(dsp.ReadIMEM(static_cast<u16>(addr + 1)));
+  }
+  case 0x2000:  // LRS
+    // This reads from (CR << 8) | I, and CR is 0xff in practice.
+    *is_load = true;
+    return IsPolledAddress(0xff00 | (inst & 0xff));
+  case 0x0280:  // CMPI
+  case 0x02a0:  // ANDF
+  case 0x02c0:  // ANDCF
+  case 0x8200:  // CMP
+  case 0x8600:  // TSTAXH
+  case 0xb100:  // TST
+  case 0x0000:  // NOP
+    return true;
+  default:
+    // Conditional jumps, which leave the loop once the polled value has changed
+    return opcode->branch && !opcode->uncond_branch && (opcode->opcode & 0xfff0) == 0x0290;
+  }
+}
+
 Analyzer::Analyzer() = default;
 Analyzer::~Analyzer() = default;
 
@@ -83,6 +133,7 @@ void Analyzer::AnalyzeRange(const SDSP& dsp, u16 start_addr, u16 end_addr)
 
   // Next, we'll scan for potential idle skips.
   FindIdleSkips(dsp, start_addr, end_addr);
+  FindIdleLoops(dsp, start_addr, end_addr);
 
   INFO_LOG_FMT(DSPLLE, "Finished analysis.");
 }
@@ -170,4 +221,40 @@ void Analyzer::FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr)
     }
   }
 }
+
+void Analyzer::FindIdleLoops(const SDSP& dsp, u16 start_addr, u16 end_addr)
+{
+  for (u16 addr = start_addr; addr < end_addr; addr++)
+  {
+    if (!IsStartOfInstruction(addr))
+      continue;
+
+    // Look for a jump (conditional or not) back to the start of a short loop
+    const UDSPInstruction inst = dsp.ReadIMEM(addr);
+    if ((inst & 0xfff0) != 0x0290)
+      continue;
+    const u16 loop_start = dsp.ReadIMEM(static_cast<u16>(addr + 1));
+    if (loop_start > addr || addr - loop_start > MAX_IDLE_LOOP_SIZE || loop_start < start_addr ||
+        !IsStartOfInstruction(loop_start))
+    {
+      continue;
+    }
+
+    // A loop which doesn't load anything can't wait for anything
+    bool has_load = false;
+    bool is_polling = true;
+    for (u16 i = loop_start; i < addr && is_polling;)
+    {
+      const DSPOPCTemplate* opcode = GetOpTemplate(dsp.ReadIMEM(i));
+      is_polling = opcode && IsPollingInstruction(dsp, i, &has_load);
+      i += opcode ? opcode->size : 1;
+    }
+
+    if (is_polling && has_load)
+    {
+      INFO_LOG_FMT(DSPLLE, "Idle loop found at {:04x}", loop_start);
+      m_code_flags[loop_start] |= CODE_IDLE_SKIP;
+    }
+  }
+}
 }  // namespace DSP
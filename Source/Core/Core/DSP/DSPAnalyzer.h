@@ -110,6 +110,10 @@ private:
   // Finds locations within the range [start_addr, end_addr) that may contain idle skips.
   void FindIdleSkips(const SDSP& dsp, u16 start_addr, u16 end_addr);
 
+  // Finds short loops within the range [start_addr, end_addr) which only poll memory or
+  // registers (usually the mailboxes) without side effects, and marks their starts as idle skips.
+  void FindIdleLoops(const SDSP& dsp, u16 start_addr, u16 end_addr);
+
   // Retrieves the flags set during analysis for code in memory.
   [[nodiscard]] u8 GetCodeFlags(u16 address) const { return m_code_flags[address]; }
 
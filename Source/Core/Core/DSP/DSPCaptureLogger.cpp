@@ -13,31 +13,6 @@
 
 namespace DSP
 {
-// Definition of the packet structures stored in PCAP capture files.
-
-const u8 IFX_ACCESS_PACKET_MAGIC = 0;
-const u8 DMA_PACKET_MAGIC = 1;
-
-#pragma pack(push, 1)
-struct IFXAccessPacket
-{
-  u8 magic;    // IFX_ACCESS_PACKET_MAGIC
-  u8 is_read;  // 0 for writes, 1 for reads.
-  u16 address;
-  u16 value;
-};
-
-// Followed by the bytes of the DMA.
-struct DMAPacket
-{
-  u8 magic;         // DMA_PACKET_MAGIC
-  u16 dma_control;  // Value of the DMA control register.
-  u32 gc_address;   // Address in the GC RAM.
-  u16 dsp_address;  // Address in the DSP RAM.
-  u16 length;       // Length in bytes.
-};
-#pragma pack(pop)
-
 PCAPDSPCaptureLogger::PCAPDSPCaptureLogger(const std::string& pcap_filename)
     : m_pcap(new Common::PCAP(new File::IOFile(pcap_filename, "wb")))
 {
@@ -50,6 +50,32 @@ public:
   void LogDMA(u16 control, u32 gc_address, u16 dsp_address, u16 length, const u8* data) override {}
 };
 
+// Definition of the packet structures stored in PCAP capture files. They are
+// also read back by DSPTool, which replays captures.
+
+constexpr u8 IFX_ACCESS_PACKET_MAGIC = 0;
+constexpr u8 DMA_PACKET_MAGIC = 1;
+
+#pragma pack(push, 1)
+struct IFXAccessPacket
+{
+  u8 magic;    // IFX_ACCESS_PACKET_MAGIC
+  u8 is_read;  // 0 for writes, 1 for reads.
+  u16 address;
+  u16 value;
+};
+
+// Followed by the bytes of the DMA.
+struct DMAPacket
+{
+  u8 magic;         // DMA_PACKET_MAGIC
+  u16 dma_control;  // Value of the DMA control register.
+  u32 gc_address;   // Address in the GC RAM.
+  u16 dsp_address;  // Address in the DSP RAM.
+  u16 length;       // Length in bytes.
+};
+#pragma pack(pop)
+
 // A capture logger implementation that logs to PCAP files in a custom
 // packet-based format.
 class PCAPDSPCaptureLogger final : public DSPCaptureLogger
@@ -78,7 +78,6 @@ void DSPEmitter::ClearIRAM()
     m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
     m_block_links[i] = nullptr;
     m_block_size[i] = 0;
-    m_unresolved_jumps[i].clear();
   }
   m_dsp_core.DSPState().reset_dspjit_codespace = true;
 }
@@ -94,7 +93,6 @@ void DSPEmitter::ClearIRAMandDSPJITCodespaceReset()
     m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
     m_block_links[i] = nullptr;
     m_block_size[i] = 0;
-    m_unresolved_jumps[i].clear();
   }
   m_dsp_core.DSPState().reset_dspjit_codespace = false;
 }
@@ -228,7 +226,6 @@ void DSPEmitter::Compile(u16 start_addr)
 {
   // Remember the current block address for later
   m_start_address = start_addr;
-  m_unresolved_jumps[start_addr].clear();
 
   const u8* entryPoint = AlignCode16();
 
@@ -238,6 +235,7 @@ void DSPEmitter::Compile(u16 start_addr)
 
   m_compile_pc = start_addr;
   bool fixup_pc = false;
+  bool ends_with_jump = false;
   m_block_size[start_addr] = 0;
 
   auto& analyzer = m_dsp_core.DSPState().GetAnalyzer();
@@ -254,9 +252,6 @@ void DSPEmitter::Compile(u16 start_addr)
     m_block_size[start_addr]++;
     m_compile_pc += opcode->size;
 
-    // If the block was trying to link into itself, remove the link
-    m_unresolved_jumps[start_addr].remove(m_compile_pc);
-
     fixup_pc = true;
 
     // Handle loop condition, only if current instruction was flagged as a loop destination
@@ -304,6 +299,7 @@ void DSPEmitter::Compile(u16 start_addr)
       fixup_pc = false;
       if (opcode->uncond_branch)
       {
+        ends_with_jump = true;
         break;
       }
 
@@ -346,31 +342,14 @@ void DSPEmitter::Compile(u16 start_addr)
     MOV(16, M_SDSP_pc(), Imm16(m_compile_pc));
   }
 
-  m_blocks[start_addr] = (DSPCompiledCode)entryPoint;
+  // Blocks which end without a branch (because of their size, or before an idle skip address)
+  // continue with the next block. So do blocks ending with a conditional branch which was not
+  // taken, as the branch has already set the PC to the next instruction.
+  if (!ends_with_jump)
+    WriteBlockLink(m_compile_pc);
 
-  // Mark this block as a linkable destination if it does not contain
-  // any unresolved CALL's
-  if (m_unresolved_jumps[start_addr].empty())
-  {
-    m_block_links[start_addr] = m_block_link_entry;
-
-    for (size_t i = 0; i < 0xffff; ++i)
-    {
-      if (!m_unresolved_jumps[i].empty())
-      {
-        // Check if there were any blocks waiting for this block to be linkable
-        size_t size = m_unresolved_jumps[i].size();
-        m_unresolved_jumps[i].remove(start_addr);
-        if (m_unresolved_jumps[i].size() < size)
-        {
-          // Mark the block to be recompiled again
-          m_blocks[i] = (DSPCompiledCode)m_stub_entry_point;
-          m_block_links[i] = nullptr;
-          m_block_size[i] = 0;
-        }
-      }
-    }
-  }
+  m_blocks[start_addr] = (DSPCompiledCode)entryPoint;
+  m_block_links[start_addr] = m_block_link_entry;
 
   if (m_block_size[start_addr] == 0)
   {
@@ -395,23 +374,6 @@ void DSPEmitter::Compile(u16 start_addr)
 void DSPEmitter::CompileCurrent(DSPEmitter& emitter)
 {
   emitter.Compile(emitter.m_dsp_core.DSPState().pc);
-
-  bool retry = true;
-
-  while (retry)
-  {
-    retry = false;
-    for (size_t i = 0; i < 0xffff; ++i)
-    {
-      if (!emitter.m_unresolved_jumps[i].empty())
-      {
-        const u16 address_to_compile = emitter.m_unresolved_jumps[i].front();
-        emitter.Compile(address_to_compile);
-        if (!emitter.m_unresolved_jumps[i].empty())
-          retry = true;
-      }
-    }
-  }
 }
 
 const u8* DSPEmitter::CompileStub()
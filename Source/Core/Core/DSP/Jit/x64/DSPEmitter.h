@@ -3,9 +3,7 @@
 
 #pragma once
 
-#include <array>
 #include <cstddef>
-#include <list>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -321,8 +319,6 @@ private:
   std::vector<Block> m_block_links;
   Block m_block_link_entry;
 
-  std::array<std::list<u16>, MAX_BLOCKS> m_unresolved_jumps;
-
   u16 m_cycles_left = 0;
 
   // The index of the last stored ext value (compile time).
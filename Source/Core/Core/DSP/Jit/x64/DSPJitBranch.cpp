@@ -116,40 +116,43 @@ void DSPEmitter::WriteBranchExit()
 
 void DSPEmitter::WriteBlockLink(u16 dest)
 {
-  // Jump directly to the called block if it has already been compiled.
-  if (!(dest >= m_start_address && dest <= m_compile_pc))
-  {
-    if (m_block_links[dest] != nullptr)
-    {
-      m_gpr.FlushRegs();
-      // Check if we have enough cycles to execute the next block
-      MOV(64, R(RAX), ImmPtr(&m_cycles_left));
-      MOV(16, R(ECX), MatR(RAX));
-      CMP(16, R(ECX), Imm16(m_block_size[m_start_address] + m_block_size[dest]));
-      FixupBranch notEnoughCycles = J_CC(CC_BE);
-
-      SUB(16, R(ECX), Imm16(m_block_size[m_start_address]));
-      MOV(16, MatR(RAX), R(ECX));
-      JMP(m_block_links[dest], Jump::Near);
-      SetJumpTarget(notEnoughCycles);
-    }
-    else
-    {
-      // The destination has not been compiled yet.  Add it to the list
-      // of blocks that this block is waiting on.
-      m_unresolved_jumps[m_start_address].push_back(dest);
-    }
-  }
+  // Idle skip blocks have to go back to the dispatcher, which is what makes them skip cycles.
+  if (m_dsp_core.DSPState().GetAnalyzer().IsIdleSkip(m_start_address))
+    return;
+
+  // Only link forward. Linked blocks skip the dispatcher's interrupt and halt checks, so a loop
+  // has to go back through the dispatcher on every iteration, or a polling loop that isn't an
+  // idle skip would delay interrupts until the end of the cycle slice.
+  if (dest <= m_start_address)
+    return;
+
+  // The destination is looked up at run time, so that blocks can link to blocks which have not
+  // been compiled yet, and links never point to a block which has been invalidated by an IRAM
+  // DMA.
+  m_gpr.FlushRegs();
+  MOV(64, R(RAX), ImmPtr(&m_block_links[dest]));
+  MOV(64, R(RDX), MatR(RAX));
+  TEST(64, R(RDX), R(RDX));
+  FixupBranch not_compiled = J_CC(CC_Z);
+
+  // Check if we have enough cycles to execute the next block
+  MOV(64, R(RAX), ImmPtr(&m_block_size[dest]));
+  MOVZX(32, 16, ECX, MatR(RAX));
+  ADD(32, R(ECX), Imm32(m_block_size[m_start_address]));
+  MOV(64, R(RAX), ImmPtr(&m_cycles_left));
+  CMP(16, MatR(RAX), R(ECX));
+  FixupBranch not_enough_cycles = J_CC(CC_BE);
+
+  SUB(16, MatR(RAX), Imm16(m_block_size[m_start_address]));
+  JMPptr(R(RDX));
+  SetJumpTarget(not_compiled);
+  SetJumpTarget(not_enough_cycles);
 }
 
 void DSPEmitter::r_jcc(const UDSPInstruction opc)
 {
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
-
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
@@ -192,11 +195,7 @@ void DSPEmitter::r_call(const UDSPInstruction opc)
   MOV(16, R(DX), Imm16(m_compile_pc + 2));
   dsp_reg_store_stack(StackRegister::Call);
   const u16 dest = m_dsp_core.DSPState().ReadIMEM(m_compile_pc + 1);
-  const DSPOPCTemplate* opcode = GetOpTemplate(opc);
-
-  // If the block is unconditional, attempt to link block
-  if (opcode->uncond_branch)
-    WriteBlockLink(dest);
+  WriteBlockLink(dest);
   MOV(16, M_SDSP_pc(), Imm16(dest));
   WriteBranchExit();
 }
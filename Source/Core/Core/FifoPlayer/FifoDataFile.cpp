@@ -99,9 +99,9 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+void FifoDataFile::AddFrame(FifoFrameInfo frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  m_Frames.push_back(std::move(frameInfo));
 }
 
 bool FifoDataFile::Save(const std::string& filename)
@@ -171,6 +171,7 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteBytes(&header, sizeof(FileHeader));
 
   // Write frames list
+  WrittenDataMap written_data;
   for (unsigned int i = 0; i < m_Frames.size(); ++i)
   {
     const FifoFrameInfo& srcFrame = m_Frames[i];
@@ -180,7 +181,7 @@ bool FifoDataFile::Save(const std::string& filename)
     u64 dataOffset = file.Tell();
     file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, written_data, file);
 
     FileFrameInfo dstFrame;
     dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
@@ -317,6 +318,7 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_exram_size_real = header.mem2_size;
 
   // Read frames
+  ReadDataMap read_data;
   for (u32 i = 0; i < header.frameCount; ++i)
   {
     u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
@@ -334,12 +336,12 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
 
     ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+                      dstFrame.memoryUpdates, read_data, file);
 
     if (!file.IsGood())
       return panic_failed_to_read();
 
-    dataFile->AddFrame(dstFrame);
+    dataFile->AddFrame(std::move(dstFrame));
   }
 
   return dataFile;
@@ -365,7 +367,7 @@ bool FifoDataFile::GetFlag(u32 flag) const
 }
 
 u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+                                     WrittenDataMap& writtenData, File::IOFile& file)
 {
   // Add space for memory update list
   u64 updateListOffset = file.Tell();
@@ -375,15 +377,19 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
   {
     const MemoryUpdate& srcUpdate = memUpdates[i];
 
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+    // Write memory, unless the same buffer has already been written by an earlier update
+    const auto [it, inserted] = writtenData.try_emplace(srcUpdate.data.get(), 0);
+    if (inserted)
+    {
+      file.Seek(0, File::SeekOrigin::End);
+      it->second = file.Tell();
+      file.WriteBytes(srcUpdate.data->data(), srcUpdate.data->size());
+    }
 
     FileMemoryUpdate dstUpdate;
     dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
-    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.dataOffset = it->second;
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data->size());
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.type = static_cast<u8>(srcUpdate.type);
 
@@ -396,7 +402,8 @@ u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates
 }
 
 void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                     std::vector<MemoryUpdate>& memUpdates, File::IOFile& file)
+                                     std::vector<MemoryUpdate>& memUpdates, ReadDataMap& readData,
+                                     File::IOFile& file)
 {
   memUpdates.resize(numUpdates);
 
@@ -410,10 +417,17 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     MemoryUpdate& dstUpdate = memUpdates[i];
     dstUpdate.address = srcUpdate.address;
     dstUpdate.fifoPosition = srcUpdate.fifoPosition;
-    dstUpdate.data.resize(srcUpdate.dataSize);
     dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
 
-    file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
+    // Updates written from the same buffer share their data offset; load that data only once
+    auto& data = readData[srcUpdate.dataOffset];
+    if (!data || data->size() != srcUpdate.dataSize)
+    {
+      auto new_data = std::make_shared<std::vector<u8>>(srcUpdate.dataSize);
+      file.Seek(srcUpdate.dataOffset, File::SeekOrigin::Begin);
+      file.ReadBytes(new_data->data(), srcUpdate.dataSize);
+      data = std::move(new_data);
+    }
+    dstUpdate.data = data;
   }
 }
@@ -6,6 +6,7 @@
 #include <array>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -28,7 +29,8 @@ struct MemoryUpdate
 
   u32 fifoPosition = 0;
   u32 address = 0;
-  std::vector<u8> data;
+  // Updates with identical contents share the same buffer, so it must never be modified.
+  std::shared_ptr<const std::vector<u8>> data;
   Type type{};
 };
 
@@ -72,7 +74,7 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
-  void AddFrame(const FifoFrameInfo& frameInfo);
+  void AddFrame(FifoFrameInfo frameInfo);
   const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
   u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
   bool Save(const std::string& filename);
@@ -90,9 +92,16 @@ private:
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  // Memory update contents are stored once per unique buffer; later updates sharing a buffer
+  // point at the same data offset.
+  using WrittenDataMap = std::unordered_map<const std::vector<u8>*, u64>;
+  using ReadDataMap = std::unordered_map<u64, std::shared_ptr<const std::vector<u8>>>;
+
+  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, WrittenDataMap& writtenData,
+                         File::IOFile& file);
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
-                                std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+                                std::vector<MemoryUpdate>& memUpdates, ReadDataMap& readData,
+                                File::IOFile& file);
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
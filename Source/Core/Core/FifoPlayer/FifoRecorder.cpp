@@ -6,6 +6,8 @@
 #include <algorithm>
 #include <cstring>
 
+#include <xxhash.h>
+
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
@@ -220,6 +222,10 @@ FifoRecorder::~FifoRecorder() = default;
 
 void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 {
+  // Flush any frames still pending from a previous recording before the file is replaced
+  m_frame_writer.Reset("FIFO Recorder Writer",
+                       [this](RecordedFrame frame) { AddRecordedFrame(std::move(frame)); });
+
   std::lock_guard lk(m_mutex);
 
   m_File = std::make_unique<FifoDataFile>();
@@ -242,6 +248,7 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
 
   std::fill(m_Ram.begin(), m_Ram.end(), 0);
   std::fill(m_ExRam.begin(), m_ExRam.end(), 0);
+  m_memory_store.clear();
 
   m_File->SetIsWii(m_system.IsWii());
 
@@ -333,21 +340,17 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
 
   if (m_FrameEnded && !m_FifoData.empty())
   {
-    m_CurrentFrame.fifoData = m_FifoData;
+    const size_t fifo_data_size = m_FifoData.size();
+    m_CurrentFrame.fifoData = std::move(m_FifoData);
 
-    {
-      std::lock_guard lk(m_mutex);
-
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
-
-      if (m_FinishedCb && m_RequestedRecordingEnd)
-        m_FinishedCb();
-    }
+    // The file will be responsible for freeing the memory allocated for each frame's fifoData.
+    // Frames that were queued before the end of the recording was requested may still be written
+    // after that, so only the frame after which nothing more is recorded finishes the recording.
+    m_frame_writer.Push({.frame = std::move(m_CurrentFrame), .is_last = m_SkipFutureData});
 
     m_CurrentFrame.memoryUpdates.clear();
     m_FifoData.clear();
+    m_FifoData.reserve(fifo_data_size);
     m_FrameEnded = false;
   }
 
@@ -381,8 +384,7 @@ void FifoRecorder::UseMemory(u32 address, u32 size, MemoryUpdate::Type type, boo
     memUpdate.address = address;
     memUpdate.fifoPosition = (u32)(m_FifoData.size());
     memUpdate.type = type;
-    memUpdate.data.resize(size);
-    std::copy(newData, newData + size, memUpdate.data.begin());
+    memUpdate.data = StoreMemoryData(newData, size);
 
     m_CurrentFrame.memoryUpdates.push_back(std::move(memUpdate));
   }
@@ -393,6 +395,33 @@ void FifoRecorder::UseMemory(u32 address, u32 size, MemoryUpdate::Type type, boo
   }
 }
 
+std::shared_ptr<const std::vector<u8>> FifoRecorder::StoreMemoryData(const u8* data, u32 size)
+{
+  // Games commonly upload the same textures and vertex data over and over again, so only keep one
+  // copy of each distinct buffer instead of recording the same contents every time.
+  auto& stored = m_memory_store[XXH3_64bits(data, size)];
+  if (stored && stored->size() == size && std::equal(data, data + size, stored->begin()))
+    return stored;
+
+  auto new_data = std::make_shared<const std::vector<u8>>(data, data + size);
+
+  // On a hash collision, the buffer already in the store is kept
+  if (!stored)
+    stored = new_data;
+
+  return new_data;
+}
+
+void FifoRecorder::AddRecordedFrame(RecordedFrame frame)
+{
+  std::lock_guard lk(m_mutex);
+
+  m_File->AddFrame(std::move(frame.frame));
+
+  if (m_FinishedCb && frame.is_last)
+    m_FinishedCb();
+}
+
 void FifoRecorder::EndFrame(u32 fifoStart, u32 fifoEnd)
 {
   // m_IsRecording is assumed to be true at this point, otherwise this function would not be called
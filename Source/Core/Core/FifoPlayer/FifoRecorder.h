@@ -6,10 +6,12 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/HookableEvent.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/FifoPlayer/FifoDataFile.h"
 
 namespace Core
@@ -62,6 +64,20 @@ private:
 
   void RecordInitialVideoMemory();
 
+  // Returns a buffer holding a copy of the given memory, reusing a previously recorded buffer if
+  // one with identical contents exists.
+  std::shared_ptr<const std::vector<u8>> StoreMemoryData(const u8* data, u32 size);
+
+  struct RecordedFrame
+  {
+    FifoFrameInfo frame;
+    // Nothing is recorded after this frame, so the recording is finished once it's in the file
+    bool is_last = false;
+  };
+
+  // Called from the frame writer thread
+  void AddRecordedFrame(RecordedFrame frame);
+
   // Accessed from both GUI and video threads
 
   std::recursive_mutex m_mutex;
@@ -84,8 +100,14 @@ private:
   std::vector<u8> m_FifoData;
   std::vector<u8> m_Ram;
   std::vector<u8> m_ExRam;
+  // Content-addressed store of recorded memory, keyed by hash
+  std::unordered_map<u64, std::shared_ptr<const std::vector<u8>>> m_memory_store;
 
   Common::EventHook m_end_of_frame_event;
 
   Core::System& m_system;
+
+  // Hands completed frames over to the file off the video thread.
+  // Declared last so that pending frames are flushed before anything else is destroyed.
+  Common::WorkQueueThread<RecordedFrame> m_frame_writer;
 };
@@ -23,6 +23,8 @@
 
 #include "Core/HW/DSP.h"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #include "AudioCommon/AudioCommon.h"
@@ -592,6 +594,31 @@ u8 DSPManager::ReadARAM(u32 address) const
   }
 }
 
+void DSPManager::ReadARAMBlock(u32 address, u8* dest, u32 size) const
+{
+  if (size == 0)
+    return;
+
+  // On Wii, addresses without the ARAM bit go to main memory
+  if (m_aram.wii_mode && ((address & 0x10000000) == 0 || ((address + size - 1) & 0x10000000) == 0))
+  {
+    for (u32 i = 0; i < size; ++i)
+      dest[i] = ReadARAM(address + i);
+    return;
+  }
+
+  // A single copy, unless the block wraps around the end of ARAM
+  while (size != 0)
+  {
+    const u32 offset = address & m_aram.mask;
+    const u32 length = std::min(size, m_aram.mask - offset + 1);
+    std::memcpy(dest, m_aram.ptr + offset, length);
+    address += length;
+    dest += length;
+    size -= length;
+  }
+}
+
 void DSPManager::WriteARAM(u8 value, u32 address)
 {
   // TODO: verify this on Wii
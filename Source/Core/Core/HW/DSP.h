@@ -93,6 +93,8 @@ public:
 
   // Audio/DSP Helper
   u8 ReadARAM(u32 address) const;
+  // Same as calling ReadARAM for each of <size> consecutive bytes
+  void ReadARAMBlock(u32 address, u8* dest, u32 size) const;
   void WriteARAM(u8 value, u32 address);
 
   // Debugger Helper
@@ -7,6 +7,7 @@
 #include <array>
 #include <cstring>
 #include <iterator>
+#include <thread>
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
@@ -15,6 +16,7 @@
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/Swap.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/Core.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
@@ -49,6 +51,14 @@ void AXUCode::InitializeShared()
 {
   m_mail_handler.PushMail(DSP_INIT, true);
 
+  if (Config::Get(Config::MAIN_DSP_PARALLEL_AX_VOICES))
+  {
+    // A few threads are enough even for games with many voices, and leave the other cores to the
+    // rest of the emulator.
+    const u32 threads = std::clamp(std::thread::hardware_concurrency(), 2u, 4u);
+    m_voice_workers = std::make_unique<AXVoiceWorkers>(threads - 1);
+  }
+
   LoadResamplingCoefficients(false, 0);
 }
 
@@ -418,17 +428,11 @@ void AXUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPB pb;
-
   auto& memory = m_dsphle->GetSystem().GetMemory();
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
-
-    ReadPB(memory, pb_addr, pb, m_crc);
 
+  // Processes one PB for the whole frame. Doesn't touch any state of the ucode, so that it can be
+  // called from the voice worker threads.
+  const auto process_pb = [&](AXPB& pb, AXBuffers buffers, HLEAccelerator* accelerator) {
     u32 updates_addr = HILO_TO_32(pb.updates.data);
     u16* updates = (u16*)HLEMemory_Get_Pointer(memory, updates_addr);
 
@@ -436,15 +440,35 @@ void AXUCode::ProcessPBList(u32 pb_addr)
     {
       ApplyUpdatesForMs(curr_ms, pb, pb.updates.num_updates, updates);
 
-      ProcessVoice(static_cast<HLEAccelerator*>(m_accelerator.get()), pb, buffers, spms,
-                   ConvertMixerControl(pb.mixer_control),
+      ProcessVoice(accelerator, pb, buffers, spms, ConvertMixerControl(pb.mixer_control),
                    m_coeffs_checksum ? m_coeffs.data() : nullptr);
 
       // Forward the buffers
       for (auto& ptr : buffers.ptrs)
         ptr += spms;
     }
+  };
+
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround}};
 
+  if (m_voice_workers)
+  {
+    static constexpr std::array<u32, 9> buffer_sizes = {
+        spms * 5, spms * 5, spms * 5, spms * 5, spms * 5, spms * 5, spms * 5, spms * 5, spms * 5};
+    if (ProcessPBListInParallel(m_dsphle, pb_addr, m_crc, buffers, buffer_sizes.data(),
+                                m_voice_workers.get(), m_accelerator.get(), process_pb))
+    {
+      return;
+    }
+  }
+
+  AXPB pb;
+  while (pb_addr)
+  {
+    ReadPB(memory, pb_addr, pb, m_crc);
+    process_pb(pb, buffers, static_cast<HLEAccelerator*>(m_accelerator.get()));
     WritePB(memory, pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
@@ -28,6 +28,11 @@ namespace DSP
 class Accelerator;
 }
 
+namespace DSP::HLE
+{
+class AXVoiceWorkers;
+}
+
 namespace DSP::HLE
 {
 class DSPHLE;
@@ -110,6 +115,9 @@ protected:
 
   std::unique_ptr<Accelerator> m_accelerator;
 
+  // Only created if voices should be processed in parallel
+  std::unique_ptr<AXVoiceWorkers> m_voice_workers;
+
   // Constructs without any GC-specific state, so it can be used by the deriving AXWii.
   AXUCode(DSPHLE* dsphle, u32 crc, bool dummy);
 
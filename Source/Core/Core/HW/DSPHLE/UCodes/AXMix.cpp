@@ -0,0 +1,221 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+#include <algorithm>
+
+#include "Common/CommonTypes.h"
+
+#if defined(_M_X86_64)
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE::AXMix
+{
+void MixAddGeneric(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta,
+                   s16* dpop)
+{
+  u16 vol = *volume;
+  for (u32 i = 0; i < count; ++i)
+  {
+    s64 sample = input[i];
+    sample *= vol;
+    sample >>= 15;
+    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
+
+    out[i] += (s16)sample;
+    vol += volume_delta;
+
+    *dpop = (s16)sample;
+  }
+  *volume = vol;
+}
+
+void ApplyVolumeGeneric(s16* samples, u32 count, s16* volume, s16 volume_delta, bool is_signed)
+{
+  s16 vol = *volume;
+  for (u32 i = 0; i < count; ++i)
+  {
+    const s32 factor = is_signed ? s32(vol) : s32(u16(vol));
+    const s32 sample = ((s32)samples[i] * factor) >> 15;
+    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
+    vol += volume_delta;
+  }
+  *volume = vol;
+}
+
+// The products of a sample and a volume always fit in 32 bits, so four samples are processed at
+// a time in 32-bit lanes. Each lane holds the 16-bit volume for its own sample, which is advanced
+// by four steps per iteration and wrapped to 16 bits just like the scalar volume.
+
+#if defined(_M_X86_64)
+FUNCTION_TARGET_SSR41
+static void MixAddSSE41(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta,
+                        s16* dpop)
+{
+  const u16 vol = *volume;
+  const u32 vector_count = count & ~3u;
+  if (vector_count != 0)
+  {
+    const __m128i mask = _mm_set1_epi32(0xFFFF);
+    const __m128i step = _mm_set1_epi32(u16(volume_delta * 4));
+    const __m128i min = _mm_set1_epi32(-32767);
+    const __m128i max = _mm_set1_epi32(32767);
+    __m128i vols = _mm_setr_epi32(vol, u16(vol + volume_delta), u16(vol + volume_delta * 2),
+                                  u16(vol + volume_delta * 3));
+    __m128i samples = _mm_setzero_si128();
+
+    for (u32 i = 0; i < vector_count; i += 4)
+    {
+      const __m128i in =
+          _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i)));
+      samples = _mm_srai_epi32(_mm_mullo_epi32(in, vols), 15);
+      samples = _mm_min_epi32(_mm_max_epi32(samples, min), max);
+
+      __m128i* dst = reinterpret_cast<__m128i*>(out + i);
+      _mm_storeu_si128(dst, _mm_add_epi32(_mm_loadu_si128(dst), samples));
+      vols = _mm_and_si128(_mm_add_epi32(vols, step), mask);
+    }
+
+    *dpop = s16(_mm_extract_epi32(samples, 3));
+    *volume = u16(vol + volume_delta * vector_count);
+  }
+
+  MixAddGeneric(out + vector_count, input + vector_count, count - vector_count, volume,
+                volume_delta, dpop);
+}
+
+FUNCTION_TARGET_SSR41
+static void ApplyVolumeSSE41(s16* samples, u32 count, s16* volume, s16 volume_delta,
+                             bool is_signed)
+{
+  const u16 vol = *volume;
+  const u16 delta = volume_delta;
+  const u32 vector_count = count & ~3u;
+  if (vector_count != 0)
+  {
+    const __m128i mask = _mm_set1_epi32(0xFFFF);
+    const __m128i step = _mm_set1_epi32(u16(delta * 4));
+    const __m128i min = _mm_set1_epi32(-32767);
+    const __m128i max = _mm_set1_epi32(32767);
+    const int shift = is_signed ? 16 : 0;
+    __m128i vols =
+        _mm_setr_epi32(vol, u16(vol + delta), u16(vol + delta * 2), u16(vol + delta * 3));
+
+    for (u32 i = 0; i < vector_count; i += 4)
+    {
+      __m128i* data = reinterpret_cast<__m128i*>(samples + i);
+      const __m128i in = _mm_cvtepi16_epi32(_mm_loadl_epi64(data));
+      // Sign extend the volumes if they are signed
+      const __m128i factors =
+          _mm_sra_epi32(_mm_sll_epi32(vols, _mm_cvtsi32_si128(shift)), _mm_cvtsi32_si128(shift));
+      __m128i result = _mm_srai_epi32(_mm_mullo_epi32(in, factors), 15);
+      result = _mm_min_epi32(_mm_max_epi32(result, min), max);
+
+      _mm_storel_epi64(data, _mm_packs_epi32(result, result));
+      vols = _mm_and_si128(_mm_add_epi32(vols, step), mask);
+    }
+
+    *volume = s16(u16(vol + delta * vector_count));
+  }
+
+  ApplyVolumeGeneric(samples + vector_count, count - vector_count, volume, volume_delta,
+                     is_signed);
+}
+#elif defined(_M_ARM_64)
+static void MixAddNEON(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta,
+                       s16* dpop)
+{
+  const u16 vol = *volume;
+  const u32 vector_count = count & ~3u;
+  if (vector_count != 0)
+  {
+    const int32x4_t mask = vdupq_n_s32(0xFFFF);
+    const int32x4_t step = vdupq_n_s32(u16(volume_delta * 4));
+    const int32x4_t min = vdupq_n_s32(-32767);
+    const int32x4_t max = vdupq_n_s32(32767);
+    const s32 initial_vols[4] = {vol, u16(vol + volume_delta), u16(vol + volume_delta * 2),
+                                 u16(vol + volume_delta * 3)};
+    int32x4_t vols = vld1q_s32(initial_vols);
+    int32x4_t samples = vdupq_n_s32(0);
+
+    for (u32 i = 0; i < vector_count; i += 4)
+    {
+      const int32x4_t in = vmovl_s16(vld1_s16(input + i));
+      samples = vshrq_n_s32(vmulq_s32(in, vols), 15);
+      samples = vminq_s32(vmaxq_s32(samples, min), max);
+
+      vst1q_s32(out + i, vaddq_s32(vld1q_s32(out + i), samples));
+      vols = vandq_s32(vaddq_s32(vols, step), mask);
+    }
+
+    *dpop = s16(vgetq_lane_s32(samples, 3));
+    *volume = u16(vol + volume_delta * vector_count);
+  }
+
+  MixAddGeneric(out + vector_count, input + vector_count, count - vector_count, volume,
+                volume_delta, dpop);
+}
+
+static void ApplyVolumeNEON(s16* samples, u32 count, s16* volume, s16 volume_delta,
+                            bool is_signed)
+{
+  const u16 vol = *volume;
+  const u16 delta = volume_delta;
+  const u32 vector_count = count & ~3u;
+  if (vector_count != 0)
+  {
+    const int32x4_t mask = vdupq_n_s32(0xFFFF);
+    const int32x4_t step = vdupq_n_s32(u16(delta * 4));
+    const int32x4_t min = vdupq_n_s32(-32767);
+    const int32x4_t max = vdupq_n_s32(32767);
+    const s32 initial_vols[4] = {vol, u16(vol + delta), u16(vol + delta * 2),
+                                 u16(vol + delta * 3)};
+    int32x4_t vols = vld1q_s32(initial_vols);
+
+    for (u32 i = 0; i < vector_count; i += 4)
+    {
+      const int32x4_t in = vmovl_s16(vld1_s16(samples + i));
+      // Sign extend the volumes if they are signed
+      const int32x4_t factors = is_signed ? vshrq_n_s32(vshlq_n_s32(vols, 16), 16) : vols;
+      int32x4_t result = vshrq_n_s32(vmulq_s32(in, factors), 15);
+      result = vminq_s32(vmaxq_s32(result, min), max);
+
+      vst1_s16(samples + i, vmovn_s32(result));
+      vols = vandq_s32(vaddq_s32(vols, step), mask);
+    }
+
+    *volume = s16(u16(vol + delta * vector_count));
+  }
+
+  ApplyVolumeGeneric(samples + vector_count, count - vector_count, volume, volume_delta,
+                     is_signed);
+}
+#endif
+
+void MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return MixAddSSE41(out, input, count, volume, volume_delta, dpop);
+#elif defined(_M_ARM_64)
+  return MixAddNEON(out, input, count, volume, volume_delta, dpop);
+#endif
+  MixAddGeneric(out, input, count, volume, volume_delta, dpop);
+}
+
+void ApplyVolume(s16* samples, u32 count, s16* volume, s16 volume_delta, bool is_signed)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return ApplyVolumeSSE41(samples, count, volume, volume_delta, is_signed);
+#elif defined(_M_ARM_64)
+  return ApplyVolumeNEON(samples, count, volume, volume_delta, is_signed);
+#endif
+  ApplyVolumeGeneric(samples, count, volume, volume_delta, is_signed);
+}
+}  // namespace DSP::HLE::AXMix
@@ -0,0 +1,26 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Per-sample mixing loops shared by AX GC and AX Wii. They are split out of AXVoice.h so that
+// they can use SIMD instructions without being compiled twice, and so that they can be tested on
+// their own. The vectorized versions produce exactly the same output as the generic ones.
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE::AXMix
+{
+// Multiplies <count> samples by a 1.15 volume which is advanced by volume_delta after each sample,
+// and adds them to an output buffer. The last mixed sample is stored in dpop.
+void MixAdd(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta, s16* dpop);
+
+// Multiplies <count> samples in place by a 1.15 volume which is advanced by volume_delta after
+// each sample. The volume is interpreted as signed on GameCube and as unsigned on Wii.
+void ApplyVolume(s16* samples, u32 count, s16* volume, s16 volume_delta, bool is_signed);
+
+// Reference implementations, always used on CPUs without the needed instruction sets.
+void MixAddGeneric(int* out, const s16* input, u32 count, u16* volume, u16 volume_delta,
+                   s16* dpop);
+void ApplyVolumeGeneric(s16* samples, u32 count, s16* volume, s16 volume_delta, bool is_signed);
+}  // namespace DSP::HLE::AXMix
@@ -12,15 +12,20 @@
 #endif
 
 #include <algorithm>
-#include <functional>
+#include <array>
+#include <iterator>
 #include <memory>
+#include <vector>
 
+#include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Core/DSP/DSPAccelerator.h"
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/DSP.h"
 #include "Core/HW/DSPHLE/UCodes/AX.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
 #include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
@@ -191,6 +196,11 @@ protected:
 
   u8 ReadMemory(u32 address) override { return m_dsp.ReadARAM(address); }
 
+  void ReadMemoryBlock(u32 address, u8* dest, u32 size) override
+  {
+    m_dsp.ReadARAMBlock(address, dest, size);
+  }
+
   void WriteMemory(u32 address, u8 value) override { m_dsp.WriteARAM(value, address); }
 
 private:
@@ -210,14 +220,6 @@ void AcceleratorSetup(HLEAccelerator* accelerator, PB_TYPE* pb)
   accelerator->SetPredScale(pb->adpcm.pred_scale);
 }
 
-// Reads a sample from the accelerator. Also handles looping and
-// disabling streams that reached the end (this is done by an exception raised
-// by the accelerator on real hardware).
-u16 AcceleratorGetSample(HLEAccelerator* accelerator)
-{
-  return accelerator->Read(accelerator->acc_pb->adpcm.coefs);
-}
-
 // Reads samples from the input callback, resamples them to <count> samples at
 // the wanted sample rate (computed from the ratio, see below).
 //
@@ -238,7 +240,11 @@ u16 AcceleratorGetSample(HLEAccelerator* accelerator)
 // We start getting samples not from sample 0, but 0.<curr_pos_frac>. This
 // avoids discontinuities in the audio stream, especially with very low ratios
 // which interpolate a lot of values between two "real" samples.
-u32 ResampleAudio(std::function<s16(u32)> input_callback, s16* output, u32 count, s16* last_samples,
+//
+// The callback is a template parameter rather than a std::function, since it
+// is called once per input sample and should be inlined.
+template <typename InputCallback>
+u32 ResampleAudio(const InputCallback& input_callback, s16* output, u32 count, s16* last_samples,
                   u32 curr_pos, u32 ratio, int srctype, const s16* coeffs)
 {
   int read_samples_count = 0;
@@ -359,9 +365,40 @@ void GetInputSamples(HLEAccelerator* accelerator, PB_TYPE& pb, s16* samples, u16
 
   if (coeffs)
     coeffs += pb.coef_select * 0x200;
-  u32 curr_pos = ResampleAudio([accelerator](u32) { return AcceleratorGetSample(accelerator); },
-                               samples, count, pb.src.last_samples, pb.src.cur_addr_frac,
-                               HILO_TO_32(pb.src.ratio), pb.src_type, coeffs);
+
+  // The resampler consumes a known number of input samples, which are read from the accelerator in
+  // batches. Exactly that many are read, so that the accelerator ends up in the same state as if
+  // they had been read one by one. Looping and disabling streams that reached the end is handled
+  // by the accelerator (this is done by an exception raised by the accelerator on real hardware).
+  const u32 ratio = HILO_TO_32(pb.src.ratio);
+  u32 remaining = count;
+  if (pb.src_type == SRCTYPE_LINEAR || pb.src_type == SRCTYPE_POLYPHASE)
+  {
+    remaining = 0;
+    u32 pos = pb.src.cur_addr_frac;
+    for (u32 i = 0; i < count; ++i)
+    {
+      pos += ratio;
+      remaining += pos >> 16;
+      pos &= 0xFFFF;
+    }
+  }
+
+  std::array<s16, 64> decoded;
+  u32 decoded_count = 0;
+  u32 decoded_pos = 0;
+  const auto get_sample = [&](u32) -> u16 {
+    if (decoded_pos == decoded_count)
+    {
+      decoded_count = std::min<u32>(remaining, static_cast<u32>(decoded.size()));
+      accelerator->ReadSamples(decoded.data(), decoded_count, pb.adpcm.coefs);
+      remaining -= decoded_count;
+      decoded_pos = 0;
+    }
+    return decoded[decoded_pos++];
+  };
+  u32 curr_pos = ResampleAudio(get_sample, samples, count, pb.src.last_samples,
+                               pb.src.cur_addr_frac, ratio, pb.src_type, coeffs);
   pb.src.cur_addr_frac = (curr_pos & 0xFFFF);
 
   // Update current position, YN1, YN2 and pred scale in the PB.
@@ -375,27 +412,10 @@ void GetInputSamples(HLEAccelerator* accelerator, PB_TYPE& pb, s16* samples, u16
 // Add samples to an output buffer, with optional volume ramping.
 void MixAdd(int* out, const s16* input, u32 count, VolumeData* vd, s16* dpop, bool ramp)
 {
-  u16& volume = vd->volume;
-  u16 volume_delta = vd->volume_delta;
-
-  // If volume ramping is disabled, set volume_delta to 0. That way, the
+  // If volume ramping is disabled, use a volume_delta of 0. That way, the
   // mixing loop can avoid testing if volume ramping is enabled at each step,
   // and just add volume_delta.
-  if (!ramp)
-    volume_delta = 0;
-
-  for (u32 i = 0; i < count; ++i)
-  {
-    s64 sample = input[i];
-    sample *= volume;
-    sample >>= 15;
-    sample = std::clamp((s32)sample, -32767, 32767);  // -32768 ?
-
-    out[i] += (s16)sample;
-    volume += volume_delta;
-
-    *dpop = (s16)sample;
-  }
+  AXMix::MixAdd(out, input, count, &vd->volume, ramp ? vd->volume_delta : 0, dpop);
 }
 
 // Execute a low pass filter on the samples using one history value. Returns
@@ -421,19 +441,15 @@ void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb, const AXBuffers& buf
   GetInputSamples(accelerator, pb, samples, count, coeffs);
 
   // Apply a global volume ramp using the volume envelope parameters.
-  for (u32 i = 0; i < count; ++i)
-  {
 #ifdef AX_GC
-    // signed on GameCube
-    const s32 volume = (s16)pb.vol_env.cur_volume;
+  // signed on GameCube
+  constexpr bool signed_volume = true;
 #else
-    // unsigned on Wii
-    const s32 volume = (u16)pb.vol_env.cur_volume;
+  // unsigned on Wii
+  constexpr bool signed_volume = false;
 #endif
-    const s32 sample = ((s32)samples[i] * volume) >> 15;
-    samples[i] = std::clamp(sample, -32767, 32767);  // -32768 ?
-    pb.vol_env.cur_volume += pb.vol_env.cur_volume_delta;
-  }
+  AXMix::ApplyVolume(samples, count, &pb.vol_env.cur_volume, pb.vol_env.cur_volume_delta,
+                     signed_volume);
 
   // Optionally, execute a low pass filter
   if (pb.lpf.enabled)
@@ -574,6 +590,138 @@ void ProcessVoice(HLEAccelerator* accelerator, PB_TYPE& pb, const AXBuffers& buf
 #endif
 }
 
+// Parallel processing isn't worth waking up the worker threads for short PB lists, and the
+// length limit catches lists that loop back on themselves.
+constexpr size_t MIN_PARALLEL_PBS = 8;
+constexpr size_t MAX_PARALLEL_PBS = 1024;
+
+// Processes the voices of a PB list on several threads. process_pb must handle a single PB for
+// the whole frame, like the loop body of ProcessPBList. Each voice is mixed into its own buffers,
+// which are added to the output buffers in list order afterwards, and the PBs are written back in
+// list order too, so the result is exactly the same as when processing the voices one by one.
+//
+// Returns false without having changed anything if the list can't be processed this way, in
+// which case the caller has to process it serially.
+template <typename ProcessPB>
+bool ProcessPBListInParallel(DSPHLE* dsphle, u32 pb_addr, u32 crc, const AXBuffers& output,
+                             const u32* buffer_sizes, AXVoiceWorkers* workers,
+                             Accelerator* main_accelerator, const ProcessPB& process_pb)
+{
+  struct Voice
+  {
+    u32 addr;
+    PB_TYPE pb;
+    bool used_accelerator;
+    std::array<u8, 32> accelerator_state;
+  };
+
+  auto& system = dsphle->GetSystem();
+  auto& memory = system.GetMemory();
+
+  std::vector<Voice> voices;
+  while (pb_addr)
+  {
+    if (voices.size() == MAX_PARALLEL_PBS)
+      return false;
+
+    Voice& voice = voices.emplace_back();
+    voice.addr = pb_addr;
+    ReadPB(memory, pb_addr, voice.pb, crc);
+    pb_addr = HILO_TO_32(voice.pb.next_pb);
+  }
+
+  if (voices.size() < MIN_PARALLEL_PBS)
+    return false;
+
+  // When processing serially, each PB is written back before the next one is read, so the PBs
+  // must not overlap.
+  std::vector<u32> addresses(voices.size());
+  std::transform(voices.begin(), voices.end(), addresses.begin(),
+                 [](const Voice& voice) { return voice.addr; });
+  std::sort(addresses.begin(), addresses.end());
+  for (size_t i = 1; i < addresses.size(); ++i)
+  {
+    if (addresses[i] - addresses[i - 1] < sizeof(PB_TYPE))
+      return false;
+  }
+
+  // Analytics aren't thread safe, so report this quirk before ProcessVoice would
+  for (const Voice& voice : voices)
+  {
+    if (voice.pb.initial_time_delay.on)
+      DolphinAnalytics::Instance().ReportGameQuirk(GameQuirk::USES_AX_INITIAL_TIME_DELAY);
+  }
+
+  const size_t buffer_count = std::size(output.ptrs);
+  u32 voice_buffer_size = 0;
+  for (size_t i = 0; i < buffer_count; ++i)
+    voice_buffer_size += buffer_sizes[i];
+
+  while (workers->accelerators.size() < workers->GetThreadCount())
+    workers->accelerators.push_back(std::make_unique<HLEAccelerator>(system.GetDSP()));
+  workers->voice_buffers.resize(voices.size() * voice_buffer_size);
+
+  workers->Run(static_cast<u32>(voices.size()), [&](u32 index, u32 thread) {
+    Voice& voice = voices[index];
+
+    int* ptr = &workers->voice_buffers[index * voice_buffer_size];
+    std::fill_n(ptr, voice_buffer_size, 0);
+    AXBuffers buffers;
+    for (size_t i = 0; i < buffer_count; ++i)
+    {
+      buffers.ptrs[i] = ptr;
+      ptr += buffer_sizes[i];
+    }
+
+    auto* accelerator = static_cast<HLEAccelerator*>(workers->accelerators[thread].get());
+    accelerator->acc_pb = nullptr;
+    process_pb(voice.pb, buffers, accelerator);
+
+    // Remember the state the accelerator was left in, so that the main accelerator can end up in
+    // the same state as after serial processing.
+    voice.used_accelerator = accelerator->acc_pb != nullptr;
+    if (voice.used_accelerator)
+    {
+      u8* state_ptr = voice.accelerator_state.data();
+      PointerWrap p(&state_ptr, voice.accelerator_state.size(), PointerWrap::Mode::Write);
+      accelerator->DoState(p);
+    }
+  });
+
+  // Updates could in theory have changed a link of the list. Since nothing has been written yet,
+  // it's not too late to fall back to serial processing.
+  for (size_t i = 0; i < voices.size(); ++i)
+  {
+    const u32 expected_next = i + 1 < voices.size() ? voices[i + 1].addr : 0;
+    if (HILO_TO_32(voices[i].pb.next_pb) != expected_next)
+      return false;
+  }
+
+  const auto last_used = std::find_if(voices.rbegin(), voices.rend(),
+                                      [](const Voice& voice) { return voice.used_accelerator; });
+  if (last_used != voices.rend())
+  {
+    u8* state_ptr = last_used->accelerator_state.data();
+    PointerWrap p(&state_ptr, last_used->accelerator_state.size(), PointerWrap::Mode::Read);
+    main_accelerator->DoState(p);
+  }
+
+  for (size_t index = 0; index < voices.size(); ++index)
+  {
+    const int* ptr = &workers->voice_buffers[index * voice_buffer_size];
+    for (size_t i = 0; i < buffer_count; ++i)
+    {
+      for (u32 j = 0; j < buffer_sizes[i]; ++j)
+        output.ptrs[i][j] += ptr[j];
+      ptr += buffer_sizes[i];
+    }
+
+    WritePB(memory, voices[index].addr, voices[index].pb, crc);
+  }
+
+  return true;
+}
+
 }  // namespace
 }  // inline namespace AXGC/AXWii
 }  // namespace DSP::HLE
@@ -0,0 +1,79 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
+
+#include <fmt/format.h>
+
+#include "Common/Thread.h"
+#include "Core/DSP/DSPAccelerator.h"
+
+namespace DSP::HLE
+{
+AXVoiceWorkers::AXVoiceWorkers(u32 worker_count)
+{
+  m_threads.reserve(worker_count);
+  for (u32 i = 0; i < worker_count; ++i)
+    m_threads.emplace_back(&AXVoiceWorkers::WorkerThread, this, i + 1);
+}
+
+AXVoiceWorkers::~AXVoiceWorkers()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_exit = true;
+  }
+  m_work_cv.notify_all();
+
+  for (std::thread& thread : m_threads)
+    thread.join();
+}
+
+void AXVoiceWorkers::Run(u32 count, const std::function<void(u32 index, u32 thread)>& function)
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_function = &function;
+    m_count = count;
+    m_next_index = 0;
+    m_busy_workers = static_cast<u32>(m_threads.size());
+    ++m_generation;
+  }
+  m_work_cv.notify_all();
+
+  RunIndices(0);
+
+  std::unique_lock lk(m_mutex);
+  m_done_cv.wait(lk, [this] { return m_busy_workers == 0; });
+  m_function = nullptr;
+}
+
+void AXVoiceWorkers::RunIndices(u32 thread)
+{
+  for (u32 i = m_next_index++; i < m_count; i = m_next_index++)
+    (*m_function)(i, thread);
+}
+
+void AXVoiceWorkers::WorkerThread(u32 thread)
+{
+  Common::SetCurrentThreadName(fmt::format("AX Voice Worker {}", thread).c_str());
+
+  u64 last_generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_work_cv.wait(lk, [&] { return m_exit || m_generation != last_generation; });
+      if (m_exit)
+        return;
+      last_generation = m_generation;
+    }
+
+    RunIndices(thread);
+
+    std::lock_guard lk(m_mutex);
+    if (--m_busy_workers == 0)
+      m_done_cv.notify_one();
+  }
+}
+}  // namespace DSP::HLE
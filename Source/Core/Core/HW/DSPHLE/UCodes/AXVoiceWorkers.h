@@ -0,0 +1,64 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace DSP
+{
+class Accelerator;
+}
+
+namespace DSP::HLE
+{
+// A few threads that AX uses to process the voices of a PB list in parallel. The threads are kept
+// around for as long as the ucode is running, since a PB list is processed every few milliseconds.
+class AXVoiceWorkers
+{
+public:
+  explicit AXVoiceWorkers(u32 worker_count);
+  ~AXVoiceWorkers();
+
+  AXVoiceWorkers(const AXVoiceWorkers&) = delete;
+  AXVoiceWorkers& operator=(const AXVoiceWorkers&) = delete;
+
+  // Including the calling thread, which takes part in Run
+  u32 GetThreadCount() const { return static_cast<u32>(m_threads.size()) + 1; }
+
+  // Calls function(index, thread) once for every index below count, and returns when all calls
+  // have returned. The thread argument is below GetThreadCount() and is unique among the calls
+  // that run at the same time.
+  void Run(u32 count, const std::function<void(u32 index, u32 thread)>& function);
+
+  // Scratch space for the caller, kept here so that it can be reused between PB lists.
+  // There is one accelerator per thread.
+  std::vector<std::unique_ptr<Accelerator>> accelerators;
+  std::vector<int> voice_buffers;
+
+private:
+  void WorkerThread(u32 thread);
+  void RunIndices(u32 thread);
+
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  u64 m_generation = 0;
+  u32 m_busy_workers = 0;
+  bool m_exit = false;
+
+  const std::function<void(u32, u32)>* m_function = nullptr;
+  u32 m_count = 0;
+  std::atomic<u32> m_next_index = 0;
+};
+}  // namespace DSP::HLE
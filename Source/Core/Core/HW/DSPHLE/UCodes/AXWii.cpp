@@ -425,21 +425,11 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
   // 32KHz to 48KHz, but AX always process at 32KHz.
   constexpr u32 spms = 32;
 
-  AXPBWii pb;
-
   auto& memory = m_dsphle->GetSystem().GetMemory();
-  while (pb_addr)
-  {
-    AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
-                          m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
-                          m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
-                          m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
-                          m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
-                          m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
-                          m_samples_wm3,       m_samples_aux3}};
-
-    ReadPB(memory, pb_addr, pb, m_crc);
 
+  // Processes one PB for the whole frame. Doesn't touch any state of the ucode, so that it can be
+  // called from the voice worker threads.
+  const auto process_pb = [&](AXPBWii& pb, AXBuffers buffers, HLEAccelerator* accelerator) {
     u16 num_updates[3];
     u16 updates[1024];
     u32 updates_addr;
@@ -448,7 +438,7 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
       for (int curr_ms = 0; curr_ms < 3; ++curr_ms)
       {
         ApplyUpdatesForMs(curr_ms, pb, num_updates, updates);
-        ProcessVoice(static_cast<HLEAccelerator*>(m_accelerator.get()), pb, buffers, spms,
+        ProcessVoice(accelerator, pb, buffers, spms,
                      ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                      m_coeffs_checksum ? m_coeffs.data() : nullptr);
 
@@ -460,11 +450,35 @@ void AXWiiUCode::ProcessPBList(u32 pb_addr)
     }
     else
     {
-      ProcessVoice(static_cast<HLEAccelerator*>(m_accelerator.get()), pb, buffers, 96,
-                   ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
+      ProcessVoice(accelerator, pb, buffers, 96, ConvertMixerControl(HILO_TO_32(pb.mixer_control)),
                    m_coeffs_checksum ? m_coeffs.data() : nullptr);
     }
+  };
 
+  const AXBuffers buffers = {{m_samples_main_left, m_samples_main_right, m_samples_main_surround,
+                              m_samples_auxA_left, m_samples_auxA_right, m_samples_auxA_surround,
+                              m_samples_auxB_left, m_samples_auxB_right, m_samples_auxB_surround,
+                              m_samples_auxC_left, m_samples_auxC_right, m_samples_auxC_surround,
+                              m_samples_wm0,       m_samples_aux0,       m_samples_wm1,
+                              m_samples_aux1,      m_samples_wm2,        m_samples_aux2,
+                              m_samples_wm3,       m_samples_aux3}};
+
+  if (m_voice_workers)
+  {
+    static constexpr std::array<u32, 20> buffer_sizes = {
+        96, 96, 96, 96, 96, 96, 96, 96, 96, 96, 96, 96, 18, 18, 18, 18, 18, 18, 18, 18};
+    if (ProcessPBListInParallel(m_dsphle, pb_addr, m_crc, buffers, buffer_sizes.data(),
+                                m_voice_workers.get(), m_accelerator.get(), process_pb))
+    {
+      return;
+    }
+  }
+
+  AXPBWii pb;
+  while (pb_addr)
+  {
+    ReadPB(memory, pb_addr, pb, m_crc);
+    process_pb(pb, buffers, static_cast<HLEAccelerator*>(m_accelerator.get()));
     WritePB(memory, pb_addr, pb, m_crc);
     pb_addr = HILO_TO_32(pb.next_pb);
   }
@@ -3,11 +3,11 @@
 
 #pragma once
 
-#include <algorithm>
 #include <array>
 
 #include "Common/CommonTypes.h"
 #include "Core/HW/DSPHLE/UCodes/UCodes.h"
+#include "Core/HW/DSPHLE/UCodes/ZeldaMix.h"
 
 namespace Core
 {
@@ -58,13 +58,7 @@ private:
   template <size_t N, size_t B>
   void ApplyVolumeInPlace(std::array<s16, N>* buf, u16 vol)
   {
-    for (size_t i = 0; i < N; ++i)
-    {
-      s32 tmp = (u32)(*buf)[i] * (u32)vol;
-      tmp >>= 16 - B;
-
-      (*buf)[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
-    }
+    ZeldaMix::ApplyVolume(buf->data(), N, vol, 16 - B);
   }
   template <size_t N>
   void ApplyVolumeInPlace_1_15(std::array<s16, N>* buf, u16 vol)
@@ -89,24 +83,14 @@ private:
     if (!vol && !step)
       return vol;
 
-    for (size_t i = 0; i < N; ++i)
-    {
-      (*dst)[i] += ((vol >> 16) * src[i]) >> 16;
-      vol += step;
-    }
-
-    return vol;
+    return ZeldaMix::AddWithVolumeRamp(dst->data(), src.data(), N, vol, step);
   }
 
   // Does not use std::array because it needs to be able to process partial
   // buffers. Volume is in 1.15 format.
   void AddBuffersWithVolume(s16* dst, const s16* src, size_t count, u16 vol)
   {
-    while (count--)
-    {
-      s32 vol_src = ((s32)*src++ * (s32)vol) >> 15;
-      *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
-    }
+    ZeldaMix::AddWithVolume(dst, src, count, vol);
   }
 
   // Whether the frame needs to be prepared or not.
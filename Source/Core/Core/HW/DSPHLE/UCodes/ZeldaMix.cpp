@@ -0,0 +1,384 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/DSPHLE/UCodes/ZeldaMix.h"
+
+#include <algorithm>
+
+#include "Common/CommonTypes.h"
+
+#if defined(_M_X86_64)
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+namespace DSP::HLE::ZeldaMix
+{
+void ApplyVolumeGeneric(s16* samples, size_t count, u16 volume, u32 shift)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    s32 tmp = (u32)samples[i] * (u32)volume;
+    tmp >>= shift;
+
+    samples[i] = (s16)std::clamp(tmp, -0x8000, 0x7FFF);
+  }
+}
+
+void AddWithVolumeGeneric(s16* dst, const s16* src, size_t count, u16 volume)
+{
+  while (count--)
+  {
+    s32 vol_src = ((s32)*src++ * (s32)volume) >> 15;
+    *dst++ += std::clamp(vol_src, -0x8000, 0x7FFF);
+  }
+}
+
+s32 AddWithVolumeRampGeneric(s16* dst, const s16* src, size_t count, s32 volume, s32 step)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    dst[i] += ((volume >> 16) * src[i]) >> 16;
+    volume = s32(u32(volume) + u32(step));
+  }
+  return volume;
+}
+
+u32 ResampleGeneric(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio, const s16* coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    // We have 0x40 * 4 coeffs that need to be selected based on the
+    // most significant bits of the fractional part of the position. 12
+    // bits >> 6 = 6 bits = 0x40. Multiply by 4 since there are 4
+    // consecutive coeffs.
+    const s16* sample_coeffs = &coeffs[((pos & 0xFFF) >> 6) * 4];
+    const s16* input = &src[pos >> 12];
+
+    s64 dst_sample_unclamped = 0;
+    for (size_t j = 0; j < 4; ++j)
+      dst_sample_unclamped += (s64)2 * sample_coeffs[j] * input[j];
+    dst_sample_unclamped >>= 16;
+
+    dst[i] = (s16)std::clamp<s64>(dst_sample_unclamped, -0x8000, 0x7FFF);
+
+    pos += ratio;
+  }
+  return pos;
+}
+
+void ApplyFilterGeneric(s16* samples, size_t count, const s16* coeffs)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    s32 sample = 0;
+    for (size_t j = 0; j < 8; ++j)
+      sample += (s32)samples[i + j] * coeffs[j];
+    sample >>= 15;
+    samples[i] = std::clamp(sample, -0x8000, 0x7FFF);
+  }
+}
+
+// All products of a sample and a volume or coefficient fit in 32 bits, and every result is
+// clamped to 16 bits, which the saturating packs do for free. The vectorized loops process four
+// samples at a time and leave the rest to the generic versions.
+//
+// Resampling sums four products of two s16 values, which can need up to 34 bits, so the sums are
+// done in 64-bit lanes. The final shift keeps the result well within 32 bits.
+
+#if defined(_M_X86_64)
+FUNCTION_TARGET_SSR41
+static void ApplyVolumeSSE41(s16* samples, size_t count, u16 volume, u32 shift)
+{
+  const size_t vector_count = count & ~size_t(3);
+  const __m128i vol = _mm_set1_epi32(volume);
+  const __m128i shift_count = _mm_cvtsi32_si128(shift);
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    __m128i* data = reinterpret_cast<__m128i*>(samples + i);
+    const __m128i in = _mm_cvtepi16_epi32(_mm_loadl_epi64(data));
+    const __m128i result = _mm_sra_epi32(_mm_mullo_epi32(in, vol), shift_count);
+    _mm_storel_epi64(data, _mm_packs_epi32(result, result));
+  }
+
+  ApplyVolumeGeneric(samples + vector_count, count - vector_count, volume, shift);
+}
+
+FUNCTION_TARGET_SSR41
+static void AddWithVolumeSSE41(s16* dst, const s16* src, size_t count, u16 volume)
+{
+  const size_t vector_count = count & ~size_t(3);
+  const __m128i vol = _mm_set1_epi32(volume);
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    const __m128i in =
+        _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+    const __m128i scaled = _mm_srai_epi32(_mm_mullo_epi32(in, vol), 15);
+
+    __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+    _mm_storel_epi64(out, _mm_add_epi16(_mm_loadl_epi64(out), _mm_packs_epi32(scaled, scaled)));
+  }
+
+  AddWithVolumeGeneric(dst + vector_count, src + vector_count, count - vector_count, volume);
+}
+
+FUNCTION_TARGET_SSR41
+static s32 AddWithVolumeRampSSE41(s16* dst, const s16* src, size_t count, s32 volume, s32 step)
+{
+  const size_t vector_count = count & ~size_t(3);
+  if (vector_count != 0)
+  {
+    const u32 vol = u32(volume);
+    const u32 delta = u32(step);
+    const __m128i step4 = _mm_set1_epi32(s32(delta * 4));
+    __m128i vols = _mm_setr_epi32(s32(vol), s32(vol + delta), s32(vol + delta * 2),
+                                  s32(vol + delta * 3));
+
+    for (size_t i = 0; i < vector_count; i += 4)
+    {
+      const __m128i in =
+          _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i)));
+      const __m128i scaled = _mm_srai_epi32(_mm_mullo_epi32(_mm_srai_epi32(vols, 16), in), 16);
+
+      __m128i* out = reinterpret_cast<__m128i*>(dst + i);
+      _mm_storel_epi64(out, _mm_add_epi16(_mm_loadl_epi64(out), _mm_packs_epi32(scaled, scaled)));
+      vols = _mm_add_epi32(vols, step4);
+    }
+
+    volume = s32(vol + delta * u32(vector_count));
+  }
+
+  return AddWithVolumeRampGeneric(dst + vector_count, src + vector_count, count - vector_count,
+                                  volume, step);
+}
+
+// Sums the four products of one output sample into the two 64-bit lanes of the result.
+FUNCTION_TARGET_SSR41
+static inline __m128i ResampleProductsSSE41(const s16* src, u32 pos, const s16* coeffs)
+{
+  const __m128i in =
+      _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&src[pos >> 12])));
+  const __m128i c = _mm_cvtepi16_epi32(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&coeffs[((pos & 0xFFF) >> 6) * 4])));
+  const __m128i products = _mm_mullo_epi32(in, c);
+  return _mm_add_epi64(_mm_cvtepi32_epi64(products),
+                       _mm_cvtepi32_epi64(_mm_unpackhi_epi64(products, products)));
+}
+
+FUNCTION_TARGET_SSR41
+static u32 ResampleSSE41(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                         const s16* coeffs)
+{
+  const size_t vector_count = count & ~size_t(3);
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    const __m128i p0 = ResampleProductsSSE41(src, pos, coeffs);
+    const __m128i p1 = ResampleProductsSSE41(src, pos + ratio, coeffs);
+    const __m128i p2 = ResampleProductsSSE41(src, pos + ratio * 2, coeffs);
+    const __m128i p3 = ResampleProductsSSE41(src, pos + ratio * 3, coeffs);
+    pos += ratio * 4;
+
+    // (2 * sum) >> 16. A logical shift is fine since only the low 32 bits of each lane are kept.
+    const __m128i sum01 = _mm_srli_epi64(
+        _mm_add_epi64(_mm_unpacklo_epi64(p0, p1), _mm_unpackhi_epi64(p0, p1)), 15);
+    const __m128i sum23 = _mm_srli_epi64(
+        _mm_add_epi64(_mm_unpacklo_epi64(p2, p3), _mm_unpackhi_epi64(p2, p3)), 15);
+    const __m128i sums = _mm_castps_si128(_mm_shuffle_ps(
+        _mm_castsi128_ps(sum01), _mm_castsi128_ps(sum23), _MM_SHUFFLE(2, 0, 2, 0)));
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packs_epi32(sums, sums));
+  }
+
+  return ResampleGeneric(dst + vector_count, count - vector_count, src, pos, ratio, coeffs);
+}
+
+FUNCTION_TARGET_SSR41
+static void ApplyFilterSSE41(s16* samples, size_t count, const s16* coeffs)
+{
+  const size_t vector_count = count & ~size_t(3);
+  const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(coeffs));
+  const auto filter = [&](const s16* in) {
+    return _mm_madd_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), c);
+  };
+
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    // All inputs are loaded before the outputs overwrite samples[i..i+3].
+    const __m128i s0 = filter(samples + i);
+    const __m128i s1 = filter(samples + i + 1);
+    const __m128i s2 = filter(samples + i + 2);
+    const __m128i s3 = filter(samples + i + 3);
+    const __m128i sums =
+        _mm_srai_epi32(_mm_hadd_epi32(_mm_hadd_epi32(s0, s1), _mm_hadd_epi32(s2, s3)), 15);
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(samples + i), _mm_packs_epi32(sums, sums));
+  }
+
+  ApplyFilterGeneric(samples + vector_count, count - vector_count, coeffs);
+}
+#elif defined(_M_ARM_64)
+static void ApplyVolumeNEON(s16* samples, size_t count, u16 volume, u32 shift)
+{
+  const size_t vector_count = count & ~size_t(3);
+  const int32x4_t vol = vdupq_n_s32(volume);
+  const int32x4_t shift_count = vdupq_n_s32(-s32(shift));
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    const int32x4_t in = vmovl_s16(vld1_s16(samples + i));
+    vst1_s16(samples + i, vqmovn_s32(vshlq_s32(vmulq_s32(in, vol), shift_count)));
+  }
+
+  ApplyVolumeGeneric(samples + vector_count, count - vector_count, volume, shift);
+}
+
+static void AddWithVolumeNEON(s16* dst, const s16* src, size_t count, u16 volume)
+{
+  const size_t vector_count = count & ~size_t(3);
+  const int32x4_t vol = vdupq_n_s32(volume);
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    const int32x4_t in = vmovl_s16(vld1_s16(src + i));
+    const int16x4_t scaled = vqmovn_s32(vshrq_n_s32(vmulq_s32(in, vol), 15));
+    vst1_s16(dst + i, vadd_s16(vld1_s16(dst + i), scaled));
+  }
+
+  AddWithVolumeGeneric(dst + vector_count, src + vector_count, count - vector_count, volume);
+}
+
+static s32 AddWithVolumeRampNEON(s16* dst, const s16* src, size_t count, s32 volume, s32 step)
+{
+  const size_t vector_count = count & ~size_t(3);
+  if (vector_count != 0)
+  {
+    const u32 vol = u32(volume);
+    const u32 delta = u32(step);
+    const int32x4_t step4 = vdupq_n_s32(s32(delta * 4));
+    const s32 initial_vols[4] = {s32(vol), s32(vol + delta), s32(vol + delta * 2),
+                                 s32(vol + delta * 3)};
+    int32x4_t vols = vld1q_s32(initial_vols);
+
+    for (size_t i = 0; i < vector_count; i += 4)
+    {
+      const int32x4_t in = vmovl_s16(vld1_s16(src + i));
+      const int32x4_t scaled = vshrq_n_s32(vmulq_s32(vshrq_n_s32(vols, 16), in), 16);
+      vst1_s16(dst + i, vadd_s16(vld1_s16(dst + i), vmovn_s32(scaled)));
+      vols = vaddq_s32(vols, step4);
+    }
+
+    volume = s32(vol + delta * u32(vector_count));
+  }
+
+  return AddWithVolumeRampGeneric(dst + vector_count, src + vector_count, count - vector_count,
+                                  volume, step);
+}
+
+// Sums the four products of one output sample into the two 64-bit lanes of the result.
+static inline int64x2_t ResampleProductsNEON(const s16* src, u32 pos, const s16* coeffs)
+{
+  const int16x4_t in = vld1_s16(&src[pos >> 12]);
+  const int16x4_t c = vld1_s16(&coeffs[((pos & 0xFFF) >> 6) * 4]);
+  return vpaddlq_s32(vmull_s16(in, c));
+}
+
+static u32 ResampleNEON(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                        const s16* coeffs)
+{
+  const size_t vector_count = count & ~size_t(3);
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    const int64x2_t p0 = ResampleProductsNEON(src, pos, coeffs);
+    const int64x2_t p1 = ResampleProductsNEON(src, pos + ratio, coeffs);
+    const int64x2_t p2 = ResampleProductsNEON(src, pos + ratio * 2, coeffs);
+    const int64x2_t p3 = ResampleProductsNEON(src, pos + ratio * 3, coeffs);
+    pos += ratio * 4;
+
+    // (2 * sum) >> 16
+    const int32x4_t sums =
+        vcombine_s32(vqshrn_n_s64(vpaddq_s64(p0, p1), 15), vqshrn_n_s64(vpaddq_s64(p2, p3), 15));
+    vst1_s16(dst + i, vqmovn_s32(sums));
+  }
+
+  return ResampleGeneric(dst + vector_count, count - vector_count, src, pos, ratio, coeffs);
+}
+
+static void ApplyFilterNEON(s16* samples, size_t count, const s16* coeffs)
+{
+  const size_t vector_count = count & ~size_t(3);
+  const int16x4_t c_low = vld1_s16(coeffs);
+  const int16x4_t c_high = vld1_s16(coeffs + 4);
+  const auto filter = [&](const s16* in) {
+    return vmlal_s16(vmull_s16(vld1_s16(in), c_low), vld1_s16(in + 4), c_high);
+  };
+
+  for (size_t i = 0; i < vector_count; i += 4)
+  {
+    // All inputs are loaded before the outputs overwrite samples[i..i+3].
+    const int32x4_t s0 = filter(samples + i);
+    const int32x4_t s1 = filter(samples + i + 1);
+    const int32x4_t s2 = filter(samples + i + 2);
+    const int32x4_t s3 = filter(samples + i + 3);
+    const int32x4_t sums = vshrq_n_s32(vpaddq_s32(vpaddq_s32(s0, s1), vpaddq_s32(s2, s3)), 15);
+    vst1_s16(samples + i, vqmovn_s32(sums));
+  }
+
+  ApplyFilterGeneric(samples + vector_count, count - vector_count, coeffs);
+}
+#endif
+
+void ApplyVolume(s16* samples, size_t count, u16 volume, u32 shift)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return ApplyVolumeSSE41(samples, count, volume, shift);
+#elif defined(_M_ARM_64)
+  return ApplyVolumeNEON(samples, count, volume, shift);
+#endif
+  ApplyVolumeGeneric(samples, count, volume, shift);
+}
+
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 volume)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return AddWithVolumeSSE41(dst, src, count, volume);
+#elif defined(_M_ARM_64)
+  return AddWithVolumeNEON(dst, src, count, volume);
+#endif
+  AddWithVolumeGeneric(dst, src, count, volume);
+}
+
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 volume, s32 step)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return AddWithVolumeRampSSE41(dst, src, count, volume, step);
+#elif defined(_M_ARM_64)
+  return AddWithVolumeRampNEON(dst, src, count, volume, step);
+#endif
+  return AddWithVolumeRampGeneric(dst, src, count, volume, step);
+}
+
+u32 Resample(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio, const s16* coeffs)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return ResampleSSE41(dst, count, src, pos, ratio, coeffs);
+#elif defined(_M_ARM_64)
+  return ResampleNEON(dst, count, src, pos, ratio, coeffs);
+#endif
+  return ResampleGeneric(dst, count, src, pos, ratio, coeffs);
+}
+
+void ApplyFilter(s16* samples, size_t count, const s16* coeffs)
+{
+#if defined(_M_X86_64)
+  if (cpu_info.bSSE4_1)
+    return ApplyFilterSSE41(samples, count, coeffs);
+#elif defined(_M_ARM_64)
+  return ApplyFilterNEON(samples, count, coeffs);
+#endif
+  ApplyFilterGeneric(samples, count, coeffs);
+}
+}  // namespace DSP::HLE::ZeldaMix
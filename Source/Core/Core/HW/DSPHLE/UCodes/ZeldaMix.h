@@ -0,0 +1,42 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Per-sample loops of the Zelda ucode audio renderer. They live in their own file so that they can
+// use SIMD instructions and be tested on their own, like AXMix. The vectorized versions produce
+// exactly the same output as the generic ones.
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace DSP::HLE::ZeldaMix
+{
+// Multiplies samples in place by an unsigned fixed point volume, shifting the products right by
+// <shift> bits (15 for 1.15 volumes, 12 for 4.12 volumes).
+void ApplyVolume(s16* samples, size_t count, u16 volume, u32 shift);
+
+// Adds samples multiplied by a 1.15 volume to another buffer.
+void AddWithVolume(s16* dst, const s16* src, size_t count, u16 volume);
+
+// Adds samples multiplied by a 16.16 volume which ramps by <step> after each sample to another
+// buffer. Returns the volume after the last sample.
+s32 AddWithVolumeRamp(s16* dst, const s16* src, size_t count, s32 volume, s32 step);
+
+// Resamples <count> output samples with 4 tap filters chosen by the fractional part of the 20.12
+// position. Reads src[(pos >> 12) + 3] for the last output sample. Returns the final position.
+u32 Resample(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio, const s16* coeffs);
+
+// Applies an 8 tap FIR filter in place. samples must hold count + 7 samples, the first <count> of
+// which are replaced.
+void ApplyFilter(s16* samples, size_t count, const s16* coeffs);
+
+// Reference implementations, always used on CPUs without the needed instruction sets.
+void ApplyVolumeGeneric(s16* samples, size_t count, u16 volume, u32 shift);
+void AddWithVolumeGeneric(s16* dst, const s16* src, size_t count, u16 volume);
+s32 AddWithVolumeRampGeneric(s16* dst, const s16* src, size_t count, s32 volume, s32 step);
+u32 ResampleGeneric(s16* dst, size_t count, const s16* src, u32 pos, u32 ratio,
+                    const s16* coeffs);
+void ApplyFilterGeneric(s16* samples, size_t count, const s16* coeffs);
+}  // namespace DSP::HLE::ZeldaMix
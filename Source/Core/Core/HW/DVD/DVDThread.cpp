@@ -21,6 +21,7 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -32,6 +33,7 @@
 #include "Core/System.h"
 
 #include "DiscIO/Enums.h"
+#include "DiscIO/ReadAheadCache.h"
 #include "DiscIO/Volume.h"
 
 namespace DVD
@@ -55,6 +57,12 @@ void DVDThread::Start()
   // much, because this will never get exposed to the emulated game.
   m_next_id = 0;
 
+  const int read_ahead_mib = Config::Get(Config::MAIN_DVD_READ_AHEAD_MIB);
+  if (read_ahead_mib > 0)
+    m_read_ahead = std::make_unique<DiscIO::ReadAheadCache>(u64(read_ahead_mib) * 1024 * 1024);
+  else
+    m_read_ahead.reset();
+
   StartDVDThread();
 }
 
@@ -68,6 +76,12 @@ void DVDThread::StartDVDThread()
 void DVDThread::Stop()
 {
   StopDVDThread();
+  if (m_read_ahead)
+  {
+    m_read_ahead->Clear();
+    m_read_ahead->LogStats();
+    m_read_ahead.reset();
+  }
   m_disc.reset();
 }
 
@@ -114,7 +128,10 @@ void DVDThread::DoState(PointerWrap& p)
     if (had_disc)
       PanicAlertFmtT("An inserted disc was expected but not found.");
     else
+    {
+      std::lock_guard lk(m_disc_mutex);
       m_disc.reset();
+    }
   }
 
   // TODO: Savestates can be smaller if the buffers of results aren't saved,
@@ -131,6 +148,9 @@ void DVDThread::DoState(PointerWrap& p)
 void DVDThread::SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  std::lock_guard lk(m_disc_mutex);
+  if (m_read_ahead)
+    m_read_ahead->Clear();
   m_disc = std::move(disc);
 }
 
@@ -160,12 +180,14 @@ u64 DVDThread::PartitionOffsetToRawOffset(u64 offset, const DiscIO::Partition& p
 IOS::ES::TMDReader DVDThread::GetTMD(const DiscIO::Partition& partition)
 {
   WaitUntilIdle();
+  std::lock_guard lk(m_disc_mutex);
   return m_disc->GetTMD(partition);
 }
 
 IOS::ES::TicketReader DVDThread::GetTicket(const DiscIO::Partition& partition)
 {
   WaitUntilIdle();
+  std::lock_guard lk(m_disc_mutex);
   return m_disc->GetTicket(partition);
 }
 
@@ -175,6 +197,7 @@ bool DVDThread::IsInsertedDiscRunning()
     return false;
 
   WaitUntilIdle();
+  std::lock_guard lk(m_disc_mutex);
 
   return SConfig::GetInstance().GetGameID() == m_disc->GetGameID();
 }
@@ -186,6 +209,7 @@ bool DVDThread::UpdateRunningGameMetadata(const DiscIO::Partition& partition,
     return false;
 
   WaitUntilIdle();
+  std::lock_guard lk(m_disc_mutex);
 
   if (title_id)
   {
@@ -342,11 +366,19 @@ void DVDThread::DVDThreadMain()
     ReadRequest request;
     while (m_request_queue.Pop(request))
     {
-      m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
-
       std::vector<u8> buffer(request.length);
-      if (!m_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      {
+        std::lock_guard lk(m_disc_mutex);
+        m_file_logger.Log(*m_disc, request.partition, request.dvd_offset);
+
+        const bool success =
+            m_read_ahead ? m_read_ahead->Read(*m_disc, request.dvd_offset, request.length,
+                                              buffer.data(), request.partition) :
+                           m_disc->Read(request.dvd_offset, request.length, buffer.data(),
+                                        request.partition);
+        if (!success)
+          buffer.resize(0);
+      }
 
       request.realtime_done_us = Common::Timer::NowUs();
 
@@ -356,6 +388,16 @@ void DVDThread::DVDThreadMain()
       if (m_dvd_thread_exiting.IsSet())
         return;
     }
+
+    // While the emulated drive is busy or idle, read ahead of sequential reads one block at a
+    // time, so that new requests don't have to wait long. The lock is only held for one block at
+    // a time, so that the CPU thread doesn't have to wait long either.
+    while (m_request_queue.Empty() && !m_dvd_thread_exiting.IsSet())
+    {
+      std::lock_guard lk(m_disc_mutex);
+      if (!m_read_ahead || !m_disc || !m_read_ahead->PrefetchNext(*m_disc))
+        break;
+    }
   }
 }
 }  // namespace DVD
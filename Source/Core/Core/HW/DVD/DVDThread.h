@@ -5,6 +5,7 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <thread>
 #include <utility>
@@ -18,6 +19,7 @@
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
 
+#include "DiscIO/ReadAheadCache.h"
 #include "DiscIO/Volume.h"
 
 class PointerWrap;
@@ -141,6 +143,14 @@ private:
 
   std::unique_ptr<DiscIO::Volume> m_disc;
 
+  // Volume isn't thread-safe. The DVD thread holds this for every read from m_disc, including
+  // the ones it reads ahead while it is otherwise idle, and the CPU thread holds it whenever it
+  // reads from or replaces m_disc.
+  std::mutex m_disc_mutex;
+
+  // Only accessed while holding m_disc_mutex
+  std::unique_ptr<DiscIO::ReadAheadCache> m_read_ahead;
+
   FileMonitor::FileLogger m_file_logger;
 
   Core::System& m_system;
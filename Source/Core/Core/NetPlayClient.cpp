@@ -869,6 +869,7 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
 
     packet >> m_net_settings.efb_access_enable;
     packet >> m_net_settings.bbox_enable;
+    packet >> m_net_settings.bbox_cpu;
     packet >> m_net_settings.force_progressive;
     packet >> m_net_settings.efb_to_texture_enable;
     packet >> m_net_settings.xfb_to_texture_enable;
@@ -910,6 +911,7 @@ void NetPlayClient::OnStartGame(sf::Packet& packet)
     packet >> m_net_settings.defer_efb_copies;
     packet >> m_net_settings.efb_access_tile_size;
     packet >> m_net_settings.efb_access_defer_invalidation;
+    packet >> m_net_settings.efb_access_predictive;
     packet >> m_net_settings.savedata_load;
     packet >> m_net_settings.savedata_write;
     packet >> m_net_settings.savedata_sync_all_wii;
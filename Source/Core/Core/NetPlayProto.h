@@ -53,6 +53,7 @@ struct NetSettings
 
   bool efb_access_enable = false;
   bool bbox_enable = false;
+  bool bbox_cpu = false;
   bool force_progressive = false;
   bool efb_to_texture_enable = false;
   bool xfb_to_texture_enable = false;
@@ -94,6 +95,7 @@ struct NetSettings
   bool defer_efb_copies = false;
   int efb_access_tile_size = 0;
   bool efb_access_defer_invalidation = false;
+  bool efb_access_predictive = false;
 
   bool savedata_load = false;
   bool savedata_write = false;
@@ -1398,6 +1398,7 @@ bool NetPlayServer::SetupNetSettings()
 
   settings.efb_access_enable = Config::Get(Config::GFX_HACK_EFB_ACCESS_ENABLE);
   settings.bbox_enable = Config::Get(Config::GFX_HACK_BBOX_ENABLE);
+  settings.bbox_cpu = Config::Get(Config::GFX_HACK_BBOX_CPU);
   settings.force_progressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   settings.efb_to_texture_enable = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
   settings.xfb_to_texture_enable = Config::Get(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
@@ -1441,6 +1442,7 @@ bool NetPlayServer::SetupNetSettings()
   settings.defer_efb_copies = Config::Get(Config::GFX_HACK_DEFER_EFB_COPIES);
   settings.efb_access_tile_size = Config::Get(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE);
   settings.efb_access_defer_invalidation = Config::Get(Config::GFX_HACK_EFB_DEFER_INVALIDATION);
+  settings.efb_access_predictive = Config::Get(Config::GFX_HACK_EFB_ACCESS_PREDICTIVE);
 
   settings.savedata_load = Config::Get(Config::NETPLAY_SAVEDATA_LOAD);
   settings.savedata_write = settings.savedata_load && Config::Get(Config::NETPLAY_SAVEDATA_WRITE);
@@ -1607,6 +1609,7 @@ bool NetPlayServer::StartGame()
 
   spac << m_settings.efb_access_enable;
   spac << m_settings.bbox_enable;
+  spac << m_settings.bbox_cpu;
   spac << m_settings.force_progressive;
   spac << m_settings.efb_to_texture_enable;
   spac << m_settings.xfb_to_texture_enable;
@@ -1648,6 +1651,7 @@ bool NetPlayServer::StartGame()
   spac << m_settings.defer_efb_copies;
   spac << m_settings.efb_access_tile_size;
   spac << m_settings.efb_access_defer_invalidation;
+  spac << m_settings.efb_access_predictive;
   spac << m_settings.savedata_load;
   spac << m_settings.savedata_write;
   spac << m_settings.savedata_sync_all_wii;
@@ -11,6 +11,8 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <thread>
 #include <utility>
@@ -27,7 +29,9 @@
 #include "Common/Event.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/StringUtil.h"
 #include "Common/Thread.h"
 #include "Common/TimeUtil.h"
 #include "Common/Timer.h"
@@ -36,6 +40,7 @@
 
 #include "Core/AchievementManager.h"
 #include "Core/Config/AchievementSettings.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
@@ -47,6 +52,7 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateDelta.h"
 #include "Core/System.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -79,9 +85,14 @@ struct CompressAndDumpState_args
 {
   std::vector<u8> buffer_vector;
   std::string filename;
+  bool delta = false;
   std::shared_ptr<Common::Event> state_write_done_event;
 };
 
+// The chain of delta states that the next SaveDeltaAs() adds to. Only used by the savestate worker
+// thread while it's running.
+static DeltaChain s_delta_chain;
+
 // Protects against simultaneous reads and writes to the final savestate location from multiple
 // threads.
 static std::mutex s_save_thread_mutex;
@@ -103,6 +114,10 @@ constexpr u32 STATE_VERSION = 168;  // Last changed in PR 12639
 // Increase this if the StateExtendedHeader definition changes
 constexpr u32 EXTENDED_HEADER_VERSION = 1;  // Last changed in PR 12217
 
+// Delta states have a StateDeltaHeader after the base header. Full states keep using the old
+// version, so that they can still be loaded by older builds.
+constexpr u32 DELTA_HEADER_VERSION = 2;
+
 // Change this if we ever need to store more data in the extended header
 constexpr u32 COMPRESSED_DATA_OFFSET = 0;
 
@@ -296,6 +311,7 @@ static std::string SystemTimeAsDoubleToString(double time)
 }
 
 static std::string MakeStateFilename(int number);
+static void RebaseDependentStates(const std::string& filename);
 
 static std::vector<SlotWithTimestamp> GetUsedSlotsWithTimestamp()
 {
@@ -355,27 +371,31 @@ static void CompressBufferToFile(const u8* raw_buffer, u64 size, File::IOFile& f
 static void CreateExtendedHeader(StateExtendedHeader& extended_header, size_t uncompressed_size)
 {
   StateExtendedBaseHeader& base_header = extended_header.base_header;
-  base_header.header_version = EXTENDED_HEADER_VERSION;
+  base_header.header_version =
+      extended_header.base_filename.empty() ? EXTENDED_HEADER_VERSION : DELTA_HEADER_VERSION;
   base_header.compression_type =
       s_use_compression ? CompressionType::LZ4 : CompressionType::Uncompressed;
   base_header.payload_offset = COMPRESSED_DATA_OFFSET;
   base_header.uncompressed_size = uncompressed_size;
 
   // If more fields are added to StateExtendedHeader, set them here.
+  extended_header.delta_header.base_filename_length =
+      static_cast<u32>(extended_header.base_filename.length());
 }
 
-static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
+// <extended_header> only needs the delta fields set, if any
+static void WriteHeadersToFile(StateExtendedHeader& extended_header, size_t uncompressed_size,
+                               double time, File::IOFile& f)
 {
   StateHeader header{};
   SConfig::GetInstance().GetGameID().copy(header.legacy_header.game_id,
                                           std::size(header.legacy_header.game_id));
-  header.legacy_header.time = GetSystemTimeAsDouble();
+  header.legacy_header.time = time;
 
   header.version_header.version_cookie = COOKIE_BASE + STATE_VERSION;
   header.version_string = Common::GetScmRevStr();
   header.version_header.version_string_length = static_cast<u32>(header.version_string.length());
 
-  StateExtendedHeader extended_header{};
   CreateExtendedHeader(extended_header, uncompressed_size);
 
   f.WriteArray(&header.legacy_header, 1);
@@ -384,13 +404,39 @@ static void WriteHeadersToFile(size_t uncompressed_size, File::IOFile& f)
 
   f.WriteArray(&extended_header.base_header, 1);
   // If StateExtendedHeader is amended to include more than the base, add WriteBytes() calls here.
+  if (extended_header.base_header.header_version == DELTA_HEADER_VERSION)
+  {
+    f.WriteArray(&extended_header.delta_header, 1);
+    f.WriteString(extended_header.base_filename);
+  }
 }
 
 static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args& save_args)
 {
-  const u8* const buffer_data = save_args.buffer_vector.data();
-  const size_t buffer_size = save_args.buffer_vector.size();
   const std::string& filename = save_args.filename;
+  const std::string last_state_filename = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
+  const auto start_time = Clock::now();
+
+  s_delta_chain.ForgetFiles(filename, File::Exists(filename) ? last_state_filename : "");
+
+  // Delta states that build on the state being replaced couldn't be loaded anymore
+  if (File::Exists(filename))
+    RebaseDependentStates(filename);
+
+  StateExtendedHeader extended_header{};
+  std::vector<u8> delta;
+  const std::optional<DeltaBase> delta_base =
+      save_args.delta ? s_delta_chain.Add(filename, save_args.buffer_vector, &delta) :
+                        std::nullopt;
+  const bool is_delta = delta_base.has_value();
+  if (is_delta)
+  {
+    extended_header.delta_header.base_checksum = delta_base->checksum;
+    extended_header.delta_header.chain_length = delta_base->chain_length;
+    extended_header.base_filename = delta_base->filename;
+  }
+  const u8* const buffer_data = is_delta ? delta.data() : save_args.buffer_vector.data();
+  const size_t buffer_size = is_delta ? delta.size() : save_args.buffer_vector.size();
 
   // Find free temporary filename.
   // TODO: The file exists check and the actual opening of the file should be atomic, we don't have
@@ -410,7 +456,7 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     return;
   }
 
-  WriteHeadersToFile(buffer_size, f);
+  WriteHeadersToFile(extended_header, buffer_size, GetSystemTimeAsDouble(), f);
 
   if (s_use_compression)
     CompressBufferToFile(buffer_data, buffer_size, f);
@@ -418,9 +464,16 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
     f.WriteBytes(buffer_data, buffer_size);
 
   if (!f.IsGood())
+  {
     Core::DisplayMessage("Failed to write state file", 2000);
+    if (save_args.delta)
+      s_delta_chain.Reset();
+  }
+
+  INFO_LOG_FMT(CORE, "Wrote {} state of {} bytes to {} bytes in {} ms", is_delta ? "delta" : "full",
+               save_args.buffer_vector.size(), f.Tell(),
+               std::chrono::duration_cast<DT_ms>(Clock::now() - start_time).count());
 
-  const std::string last_state_filename = File::GetUserPath(D_STATESAVES_IDX) + "lastState.sav";
   const std::string last_state_dtmname = last_state_filename + ".dtm";
   const std::string dtmname = filename + ".dtm";
 
@@ -472,7 +525,7 @@ static void CompressAndDumpState(Core::System& system, CompressAndDumpState_args
   Host_UpdateMainFrame();
 }
 
-void SaveAs(Core::System& system, const std::string& filename, bool wait)
+static void SaveStateAs(Core::System& system, const std::string& filename, bool wait, bool delta)
 {
   std::unique_lock lk(s_load_or_save_in_progress_mutex, std::try_to_lock);
   if (!lk)
@@ -508,6 +561,7 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
           CompressAndDumpState_args save_args;
           save_args.buffer_vector = std::move(current_buffer);
           save_args.filename = filename;
+          save_args.delta = delta;
           if (wait)
           {
             sync_event = std::make_shared<Common::Event>();
@@ -534,6 +588,16 @@ void SaveAs(Core::System& system, const std::string& filename, bool wait)
       true);
 }
 
+void SaveAs(Core::System& system, const std::string& filename, bool wait)
+{
+  SaveStateAs(system, filename, wait, false);
+}
+
+void SaveDeltaAs(Core::System& system, const std::string& filename, bool wait)
+{
+  SaveStateAs(system, filename, wait, true);
+}
+
 static bool GetVersionFromLZO(StateHeader& header, File::IOFile& f)
 {
   // Just read the first block, since it will contain the full revision string
@@ -772,44 +836,57 @@ static bool ValidateHeaders(const StateHeader& header)
   return success;
 }
 
-static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+// Reads the headers which follow the ones read by ReadStateHeaderFromFile
+static bool ReadExtendedHeader(File::IOFile& f, StateExtendedHeader& extended_header)
 {
-  File::IOFile f;
-
-  {
-    // If a state is currently saving, wait for that to end or time out.
-    std::unique_lock lk(s_state_writes_in_queue_mutex);
-    if (s_state_writes_in_queue != 0)
-    {
-      if (!s_state_write_queue_is_empty.wait_for(lk, std::chrono::seconds(3),
-                                                 []() { return s_state_writes_in_queue == 0; }))
-      {
-        Core::DisplayMessage(
-            "A previous state saving operation is still in progress, cancelling load.", 2000);
-        return;
-      }
-    }
-    f.Open(filename, "rb");
-  }
-
-  StateHeader header;
-  if (!ReadStateHeaderFromFile(header, f) || !ValidateHeaders(header))
-    return;
-
-  StateExtendedHeader extended_header;
   if (!f.ReadArray(&extended_header.base_header, 1))
   {
     PanicAlertFmt("Unable to read state header");
-    return;
+    return false;
   }
   // If StateExtendedHeader is amended to include more than the base, add ReadBytes() calls here.
 
-  if (extended_header.base_header.header_version != EXTENDED_HEADER_VERSION)
+  const u16 header_version = extended_header.base_header.header_version;
+  if (header_version != EXTENDED_HEADER_VERSION && header_version != DELTA_HEADER_VERSION)
   {
     PanicAlertFmt("State header corrupted");
-    return;
+    return false;
+  }
+
+  if (header_version == DELTA_HEADER_VERSION)
+  {
+    if (!f.ReadArray(&extended_header.delta_header, 1))
+    {
+      PanicAlertFmt("Unable to read state delta header");
+      return false;
+    }
+
+    const StateDeltaHeader& delta_header = extended_header.delta_header;
+    extended_header.base_filename.resize(delta_header.base_filename_length);
+    if (!f.ReadBytes(extended_header.base_filename.data(), delta_header.base_filename_length))
+    {
+      PanicAlertFmt("Unable to read state delta header");
+      return false;
+    }
   }
 
+  return true;
+}
+
+// Reads the payload of the state file <f>, and what it's based on if it's a delta state. The
+// headers are only checked against the running game and Dolphin version if <validate> is set.
+static bool ReadStatePayload(File::IOFile& f, bool validate, std::vector<u8>& ret_data,
+                             std::optional<DeltaBase>* base)
+{
+  StateHeader header;
+  if (!ReadStateHeaderFromFile(header, f) || (validate && !ValidateHeaders(header)))
+    return false;
+
+  StateExtendedHeader extended_header;
+  if (!ReadExtendedHeader(f, extended_header))
+    return false;
+  const bool is_delta = extended_header.base_header.header_version == DELTA_HEADER_VERSION;
+
   std::vector<u8> buffer;
 
   switch (extended_header.base_header.compression_type)
@@ -818,7 +895,7 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
   {
     Core::DisplayMessage("Decompressing State...", 500);
     if (!DecompressLZ4(buffer, extended_header.base_header.uncompressed_size, f))
-      return;
+      return false;
 
     break;
   }
@@ -827,12 +904,14 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
     u64 header_len = sizeof(StateHeaderLegacy) + sizeof(StateHeaderVersion) +
                      header.version_header.version_string_length + sizeof(StateExtendedBaseHeader) +
                      extended_header.base_header.payload_offset;
+    if (is_delta)
+      header_len += sizeof(StateDeltaHeader) + extended_header.delta_header.base_filename_length;
 
     u64 file_size = f.GetSize();
     if (file_size < header_len)
     {
       PanicAlertFmt("State header length corrupted");
-      return;
+      return false;
     }
 
     const auto size = static_cast<size_t>(file_size - header_len);
@@ -841,17 +920,175 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
     if (!f.ReadBytes(buffer.data(), size))
     {
       PanicAlertFmt("Error reading bytes: {0}", size);
-      return;
+      return false;
     }
     break;
   }
   default:
     PanicAlertFmt("Unknown compression type {0}", extended_header.base_header.compression_type);
-    return;
+    return false;
+  }
+
+  if (is_delta)
+  {
+    *base = DeltaBase{.filename = std::move(extended_header.base_filename),
+                      .chain_length = extended_header.delta_header.chain_length,
+                      .checksum = extended_header.delta_header.base_checksum};
+  }
+  else
+  {
+    base->reset();
   }
 
   // all good
   ret_data.swap(buffer);
+  return true;
+}
+
+// Reads the state in the already opened <f>, applying it to the states it builds on if it's a
+// delta state.
+static bool ReadStateFile(const std::string& filename, File::IOFile& f, bool validate,
+                          std::vector<u8>& ret_data)
+{
+  bool first_file = true;
+  const auto read_payload = [&](const std::string& name, std::vector<u8>* payload,
+                                std::optional<DeltaBase>* base) {
+    if (std::exchange(first_file, false))
+      return ReadStatePayload(f, validate, *payload, base);
+
+    File::IOFile base_file(name, "rb");
+    return ReadStatePayload(base_file, validate, *payload, base);
+  };
+
+  switch (ReadDeltaChain(filename, MAX_DELTA_CHAIN_LENGTH, read_payload, &ret_data))
+  {
+  case DeltaChainResult::Success:
+    return true;
+  case DeltaChainResult::ReadFailed:
+    // Already reported by ReadStatePayload
+    return false;
+  case DeltaChainResult::ChainCorrupted:
+    PanicAlertFmt("State delta chain corrupted");
+    return false;
+  case DeltaChainResult::BaseReplaced:
+    Core::DisplayMessage("A state that this state builds on has been replaced",
+                         OSD::Duration::NORMAL);
+    return false;
+  case DeltaChainResult::DeltaCorrupted:
+    PanicAlertFmt("State delta corrupted");
+    return false;
+  }
+
+  return false;
+}
+
+bool ReadStateData(const std::string& filename, std::vector<u8>* state)
+{
+  File::IOFile f(filename, "rb");
+  return ReadStateFile(filename, f, false, *state);
+}
+
+// Returns the filename of the state that the state in <filename> builds on, if it's a delta
+// state, and sets <time> to when the state in <filename> was saved
+static std::optional<std::string> ReadBaseFilename(const std::string& filename, double* time)
+{
+  File::IOFile f(filename, "rb");
+
+  // Legacy states can't be delta states, and getting their version would need decompression
+  StateHeader header;
+  if (!ReadStateHeaderFromFile(header, f, false) || header.legacy_header.lzo_size != 0)
+    return std::nullopt;
+
+  StateExtendedHeader extended_header;
+  if (!f.Seek(0, File::SeekOrigin::Begin) || !ReadStateHeaderFromFile(header, f) ||
+      !ReadExtendedHeader(f, extended_header) ||
+      extended_header.base_header.header_version != DELTA_HEADER_VERSION)
+  {
+    return std::nullopt;
+  }
+
+  *time = header.legacy_header.time;
+  return PathToString(StringToPath(filename).parent_path() /
+                      StringToPath(extended_header.base_filename));
+}
+
+// Saves the slots which are delta states of <filename> in full, keeping their timestamps, so that
+// they can still be loaded after <filename> is replaced. Slots which build on those in turn don't
+// need to be touched, since the states they build on stay the same.
+static void RebaseDependentStates(const std::string& filename)
+{
+  for (int slot = 1; slot <= (int)NUM_STATES; ++slot)
+  {
+    const std::string dependent_filename = MakeStateFilename(slot);
+    if (dependent_filename == filename || !File::Exists(dependent_filename))
+      continue;
+
+    double time;
+    const std::optional<std::string> base_filename = ReadBaseFilename(dependent_filename, &time);
+    std::error_code error;
+    if (!base_filename ||
+        !std::filesystem::equivalent(StringToPath(*base_filename), StringToPath(filename), error))
+    {
+      continue;
+    }
+
+    const std::string display_name = StringToPath(dependent_filename).filename().string();
+    std::vector<u8> state;
+    if (!ReadStateData(dependent_filename, &state))
+    {
+      Core::DisplayMessage(fmt::format("{} can't be loaded anymore, since the state it builds on "
+                                       "is being replaced",
+                                       display_name),
+                           4000);
+      continue;
+    }
+
+    const std::string temp_filename = dependent_filename + ".tmp";
+    File::IOFile f(temp_filename, "wb");
+    StateExtendedHeader extended_header{};
+    WriteHeadersToFile(extended_header, state.size(), time, f);
+    if (s_use_compression)
+      CompressBufferToFile(state.data(), state.size(), f);
+    else
+      f.WriteBytes(state.data(), state.size());
+
+    std::lock_guard lk(s_save_thread_mutex);
+    if (!f.IsGood() || !f.Close() || !File::Rename(temp_filename, dependent_filename))
+    {
+      File::Delete(temp_filename);
+      Core::DisplayMessage(fmt::format("Failed to save {} in full before replacing the state it "
+                                       "builds on",
+                                       display_name),
+                           4000);
+      continue;
+    }
+
+    INFO_LOG_FMT(CORE, "Saved {} in full, since the state it builds on is being replaced",
+                 dependent_filename);
+  }
+}
+
+static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_data)
+{
+  File::IOFile f;
+
+  {
+    // If a state is currently saving, wait for that to end or time out.
+    std::unique_lock lk(s_state_writes_in_queue_mutex);
+    if (s_state_writes_in_queue != 0)
+    {
+      if (!s_state_write_queue_is_empty.wait_for(lk, std::chrono::seconds(3),
+                                                 []() { return s_state_writes_in_queue == 0; }))
+      {
+        Core::DisplayMessage(
+            "A previous state saving operation is still in progress, cancelling load.", 2000);
+        return;
+      }
+    }
+    f.Open(filename, "rb");
+  }
+
+  ReadStateFile(filename, f, true, ret_data);
 }
 
 void LoadAs(Core::System& system, const std::string& filename)
@@ -946,6 +1183,9 @@ void SetOnAfterLoadCallback(AfterLoadCallbackFunc callback)
 
 void Init(Core::System& system)
 {
+  // Deltas must not build on the states of whatever ran before
+  s_delta_chain.Reset();
+
   s_save_thread.Reset("Savestate Worker", [&system](CompressAndDumpState_args args) {
     CompressAndDumpState(system, args);
 
@@ -963,6 +1203,7 @@ void Init(Core::System& system)
 void Shutdown()
 {
   s_save_thread.Shutdown();
+  s_delta_chain.Reset();
 
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
@@ -981,7 +1222,7 @@ static std::string MakeStateFilename(int number)
 
 void Save(Core::System& system, int slot, bool wait)
 {
-  SaveAs(system, MakeStateFilename(slot), wait);
+  SaveStateAs(system, MakeStateFilename(slot), wait, Config::Get(Config::MAIN_SAVE_STATE_DELTAS));
 }
 
 void Load(Core::System& system, int slot)
@@ -72,9 +72,26 @@ static_assert(offsetof(StateExtendedBaseHeader, payload_offset) == 4);
 static_assert(offsetof(StateExtendedBaseHeader, uncompressed_size) == 8);
 static_assert(std::is_trivially_copyable_v<StateExtendedBaseHeader>);
 
+// Follows the base header of delta states, whose payload is a delta against the state in the
+// base file rather than a full state. See StateDelta.h.
+struct StateDeltaHeader
+{
+  u64 base_checksum;
+  // The number of deltas between the keyframe of the chain and this state, including this one
+  u32 chain_length;
+  u32 base_filename_length;
+};
+constexpr size_t DELTA_HEADER_SIZE = sizeof(StateDeltaHeader);
+static_assert(DELTA_HEADER_SIZE == 16);
+static_assert(std::is_trivially_copyable_v<StateDeltaHeader>);
+
 struct StateExtendedHeader
 {
   StateExtendedBaseHeader base_header;
+  // Only present in delta states
+  StateDeltaHeader delta_header;
+  // Relative to the directory of the delta state, unless it's on another drive
+  std::string base_filename;
   // Feel free to add new fields here, adjusting COMPRESSED_DATA_OFFSET accordingly, as well as
   // CreateExtendedHeader(). Add the appropriate IOFile read/write calls within LoadFileStateData()
   // and WriteHeadersToFile()
@@ -106,6 +123,18 @@ void Load(Core::System& system, int slot);
 void SaveAs(Core::System& system, const std::string& filename, bool wait = false);
 void LoadAs(Core::System& system, const std::string& filename);
 
+// Like SaveAs, but only stores the pages of the state that changed since the last state saved
+// with this function, which makes frequent saves much smaller. The first state of a chain (the
+// keyframe) is a full state, and a new chain is started when the current one gets long or a
+// delta wouldn't be much smaller than a full state. Loading a delta state loads the states it
+// builds on too, so the whole chain has to be kept. Delta states can be loaded with LoadAs.
+// Save uses this when Config::MAIN_SAVE_STATE_DELTAS is set.
+void SaveDeltaAs(Core::System& system, const std::string& filename, bool wait = false);
+
+// Reads the serialized state in <filename>, along with the states it builds on if it's a delta
+// state, without checking which game or Dolphin version it was saved with. For tools.
+bool ReadStateData(const std::string& filename, std::vector<u8>* state);
+
 void SaveToBuffer(Core::System& system, std::vector<u8>& buffer);
 void LoadFromBuffer(Core::System& system, std::vector<u8>& buffer);
 
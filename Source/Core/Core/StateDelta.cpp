@@ -0,0 +1,221 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+#include <utility>
+
+#include <xxhash.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace State
+{
+namespace
+{
+// A delta is this header, followed by the indices of the stored pages and then their contents.
+// Keeping the indices apart from the contents lets LZ4 compress them better.
+struct DeltaHeader
+{
+  u64 state_size;
+  u32 num_pages;
+  u32 reserved;
+};
+static_assert(sizeof(DeltaHeader) == 16);
+static_assert(std::is_trivially_copyable_v<DeltaHeader>);
+
+size_t GetPageCount(u64 state_size)
+{
+  return static_cast<size_t>((state_size + DELTA_PAGE_SIZE - 1) / DELTA_PAGE_SIZE);
+}
+
+size_t GetPageLength(u64 state_size, size_t page)
+{
+  return static_cast<size_t>(std::min<u64>(DELTA_PAGE_SIZE, state_size - page * DELTA_PAGE_SIZE));
+}
+}  // namespace
+
+std::vector<u64> HashStatePages(std::span<const u8> state)
+{
+  std::vector<u64> hashes(GetPageCount(state.size()));
+  for (size_t page = 0; page < hashes.size(); ++page)
+    hashes[page] = XXH3_64bits(state.data() + page * DELTA_PAGE_SIZE,
+                               GetPageLength(state.size(), page));
+  return hashes;
+}
+
+u64 GetStateChecksum(std::span<const u64> page_hashes)
+{
+  return XXH3_64bits(page_hashes.data(), page_hashes.size_bytes());
+}
+
+size_t CreateStateDelta(std::span<const u8> state, std::span<const u64> page_hashes,
+                        std::span<const u64> base_page_hashes, std::vector<u8>* delta)
+{
+  // Pages past the end of the base state have no hash to match. A partial last page only matches
+  // if the base state ends at the same place, as the hashes of different lengths differ.
+  std::vector<u32> changed_pages;
+  for (size_t page = 0; page < page_hashes.size(); ++page)
+  {
+    if (page >= base_page_hashes.size() || page_hashes[page] != base_page_hashes[page])
+      changed_pages.push_back(static_cast<u32>(page));
+  }
+
+  const DeltaHeader header{.state_size = state.size(),
+                           .num_pages = static_cast<u32>(changed_pages.size()),
+                           .reserved = 0};
+
+  size_t size = sizeof(header) + changed_pages.size() * sizeof(u32);
+  for (const u32 page : changed_pages)
+    size += GetPageLength(state.size(), page);
+
+  delta->resize(size);
+  u8* out = delta->data();
+  std::memcpy(out, &header, sizeof(header));
+  out += sizeof(header);
+  std::memcpy(out, changed_pages.data(), changed_pages.size() * sizeof(u32));
+  out += changed_pages.size() * sizeof(u32);
+  for (const u32 page : changed_pages)
+  {
+    const size_t length = GetPageLength(state.size(), page);
+    std::memcpy(out, state.data() + page * DELTA_PAGE_SIZE, length);
+    out += length;
+  }
+
+  return changed_pages.size();
+}
+
+bool ApplyStateDelta(std::span<const u8> delta, std::vector<u8>* state)
+{
+  DeltaHeader header;
+  if (delta.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, delta.data(), sizeof(header));
+
+  const size_t page_count = GetPageCount(header.state_size);
+  if (header.num_pages > page_count ||
+      delta.size() < sizeof(header) + u64{header.num_pages} * sizeof(u32))
+  {
+    return false;
+  }
+
+  std::vector<u32> pages(header.num_pages);
+  std::memcpy(pages.data(), delta.data() + sizeof(header), pages.size() * sizeof(u32));
+
+  // Check the whole delta before touching the state
+  size_t data_size = 0;
+  for (size_t i = 0; i < pages.size(); ++i)
+  {
+    if (pages[i] >= page_count || (i != 0 && pages[i] <= pages[i - 1]))
+      return false;
+    data_size += GetPageLength(header.state_size, pages[i]);
+  }
+  const u8* data = delta.data() + sizeof(header) + pages.size() * sizeof(u32);
+  if (static_cast<size_t>(delta.data() + delta.size() - data) != data_size)
+    return false;
+
+  // Any pages the state grew by are stored in the delta, since the base has no hashes for them
+  state->resize(static_cast<size_t>(header.state_size));
+  for (const u32 page : pages)
+  {
+    const size_t length = GetPageLength(header.state_size, page);
+    std::memcpy(state->data() + page * DELTA_PAGE_SIZE, data, length);
+    data += length;
+  }
+
+  return true;
+}
+
+void DeltaChain::ForgetFiles(const std::string& filename, const std::string& backup_filename)
+{
+  const auto contains = [this](const std::string& name) {
+    return std::find(m_filenames.begin(), m_filenames.end(), name) != m_filenames.end();
+  };
+  if (contains(filename) || contains(backup_filename))
+    Reset();
+}
+
+void DeltaChain::Reset()
+{
+  m_filenames.clear();
+  m_page_hashes.clear();
+}
+
+std::optional<DeltaBase> DeltaChain::Add(const std::string& filename, std::span<const u8> state,
+                                         std::vector<u8>* delta)
+{
+  std::vector<u64> page_hashes = HashStatePages(state);
+  const size_t chain_length = m_filenames.size();
+
+  if (chain_length != 0 && chain_length <= MAX_DELTA_CHAIN_LENGTH)
+  {
+    const size_t changed_pages = CreateStateDelta(state, page_hashes, m_page_hashes, delta);
+
+    // Loading a delta means loading its whole chain, which isn't worth it for small savings
+    if (delta->size() <= state.size() / 2)
+    {
+      const std::filesystem::path path = StringToPath(filename);
+      const std::filesystem::path base_path = StringToPath(m_filenames.back());
+      const std::filesystem::path relative_path =
+          base_path.lexically_relative(path.parent_path());
+
+      DeltaBase base{.filename = PathToString(relative_path.empty() ? base_path : relative_path),
+                     .chain_length = static_cast<u32>(chain_length),
+                     .checksum = GetStateChecksum(m_page_hashes)};
+
+      INFO_LOG_FMT(CORE, "Delta state {}: {} of {} pages changed", filename, changed_pages,
+                   page_hashes.size());
+
+      m_filenames.push_back(filename);
+      m_page_hashes = std::move(page_hashes);
+      return base;
+    }
+  }
+
+  m_filenames = {filename};
+  m_page_hashes = std::move(page_hashes);
+  return std::nullopt;
+}
+
+DeltaChainResult ReadDeltaChain(const std::string& filename, u32 max_chain_length,
+                                const ReadStatePayloadFunction& read_payload,
+                                std::vector<u8>* state)
+{
+  std::vector<u8> payload;
+  std::optional<DeltaBase> base;
+  if (!read_payload(filename, &payload, &base))
+    return DeltaChainResult::ReadFailed;
+
+  if (!base)
+  {
+    state->swap(payload);
+    return DeltaChainResult::Success;
+  }
+
+  if (base->chain_length == 0 || base->chain_length > max_chain_length)
+    return DeltaChainResult::ChainCorrupted;
+
+  const std::string base_filename =
+      PathToString(StringToPath(filename).parent_path() / StringToPath(base->filename));
+  std::vector<u8> base_state;
+  const DeltaChainResult result =
+      ReadDeltaChain(base_filename, base->chain_length - 1, read_payload, &base_state);
+  if (result != DeltaChainResult::Success)
+    return result;
+
+  if (GetStateChecksum(HashStatePages(base_state)) != base->checksum)
+    return DeltaChainResult::BaseReplaced;
+
+  if (!ApplyStateDelta(payload, &base_state))
+    return DeltaChainResult::DeltaCorrupted;
+
+  state->swap(base_state);
+  return DeltaChainResult::Success;
+}
+}  // namespace State
@@ -0,0 +1,93 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Page-granular deltas between serialized savestates. Pages are compared through their hashes,
+// so that the previous state of a delta chain doesn't have to be kept in memory to save the next.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+constexpr size_t DELTA_PAGE_SIZE = 0x1000;
+
+// A chain gets a new keyframe after this many deltas, which bounds the time it takes to load one
+constexpr u32 MAX_DELTA_CHAIN_LENGTH = 16;
+
+// Hashes every DELTA_PAGE_SIZE bytes of <state>. The last page may be shorter.
+std::vector<u64> HashStatePages(std::span<const u8> state);
+
+// Identifies a whole state through the hashes of its pages.
+u64 GetStateChecksum(std::span<const u64> page_hashes);
+
+// Replaces <delta> with the pages of <state> whose hashes differ from <base_page_hashes>, and
+// returns how many pages that was. <page_hashes> must be the hashes of <state>.
+size_t CreateStateDelta(std::span<const u8> state, std::span<const u64> page_hashes,
+                        std::span<const u64> base_page_hashes, std::vector<u8>* delta);
+
+// Turns <state>, which must be the base state of <delta>, into the state the delta was created
+// from. Returns false if the delta is malformed.
+bool ApplyStateDelta(std::span<const u8> delta, std::vector<u8>* state);
+
+// The state a delta state is created from
+struct DeltaBase
+{
+  // Relative to the directory of the delta state, unless it's on another drive
+  std::string filename;
+  // The number of deltas between the keyframe of the chain and the delta state, including it
+  u32 chain_length = 0;
+  // GetStateChecksum() of the base state
+  u64 checksum = 0;
+};
+
+// The chain of delta states that the next delta state is added to, starting with its keyframe.
+// Only the page hashes of the newest state are kept.
+class DeltaChain
+{
+public:
+  // Writing <filename> replaces it and moves <backup_filename> away, so a chain containing either
+  // couldn't be loaded anymore, and the next delta needs a new keyframe.
+  void ForgetFiles(const std::string& filename, const std::string& backup_filename);
+  void Reset();
+
+  // Makes <state>, which is about to be saved to <filename>, the newest state of the chain.
+  // Returns the base of the delta that <delta> is replaced with if that's worth saving instead of
+  // <state>, or nothing if <state> should be saved as it is, starting a new chain.
+  std::optional<DeltaBase> Add(const std::string& filename, std::span<const u8> state,
+                               std::vector<u8>* delta);
+
+  size_t GetLength() const { return m_filenames.size(); }
+
+private:
+  std::vector<std::string> m_filenames;
+  std::vector<u64> m_page_hashes;
+};
+
+enum class DeltaChainResult
+{
+  Success,
+  ReadFailed,
+  ChainCorrupted,
+  BaseReplaced,
+  DeltaCorrupted,
+};
+
+// Reads the payload of the state in a file, and what it's based on if it's a delta state.
+using ReadStatePayloadFunction = std::function<bool(
+    const std::string& filename, std::vector<u8>* payload, std::optional<DeltaBase>* base)>;
+
+// Reads the state in <filename> with <read_payload>, applying it to the states it builds on if
+// it's a delta. The state may be at most <max_chain_length> deltas away from its keyframe, which
+// also stops cyclic chains. <state> is only changed on success.
+DeltaChainResult ReadDeltaChain(const std::string& filename, u32 max_chain_length,
+                                const ReadStatePayloadFunction& read_payload,
+                                std::vector<u8>* state);
+}  // namespace State
@@ -4,6 +4,7 @@
 #include "DiscIO/Blob.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <limits>
 #include <memory>
@@ -61,74 +62,92 @@ std::string GetName(BlobType blob_type, bool translate)
   }
 }
 
+static std::atomic<u64> s_sector_reader_cache_size = 16 * 1024 * 1024;
+
+void SetSectorReaderCacheSize(u64 bytes)
+{
+  s_sector_reader_cache_size.store(bytes, std::memory_order_relaxed);
+}
+
 void SectorReader::SetSectorSize(int blocksize)
 {
   m_block_size = std::max(blocksize, 0);
-  for (auto& cache_entry : m_cache)
-  {
-    cache_entry.Reset();
-    cache_entry.data.resize(m_chunk_blocks * m_block_size);
-  }
+  m_cache->Clear();
 }
 
 void SectorReader::SetChunkSize(int block_cnt)
 {
   m_chunk_blocks = std::max(block_cnt, 1);
-  // Clear cache and resize the data arrays
-  SetSectorSize(m_block_size);
+  m_cache->Clear();
 }
 
 SectorReader::~SectorReader()
 {
 }
 
-const SectorReader::Cache* SectorReader::FindCacheLine(u64 block_num)
+void SectorReader::ShareCache(const SectorReader& other)
 {
-  auto itr = std::find_if(m_cache.begin(), m_cache.end(),
-                          [&](const Cache& entry) { return entry.Contains(block_num); });
-  if (itr == m_cache.end())
+  if (m_block_size == other.m_block_size && m_chunk_blocks == other.m_chunk_blocks)
+    m_cache = other.m_cache;
+}
+
+std::shared_ptr<const SectorReader::CacheLine> SectorReader::Cache::Find(u64 chunk_num)
+{
+  std::lock_guard lk(m_mutex);
+
+  const auto it = m_line_map.find(chunk_num);
+  if (it == m_line_map.end())
     return nullptr;
 
-  itr->MarkUsed();
-  return &*itr;
+  m_lines.splice(m_lines.begin(), m_lines, it->second);
+  return it->second->line;
 }
 
-SectorReader::Cache* SectorReader::GetEmptyCacheLine()
+void SectorReader::Cache::Insert(u64 chunk_num, std::shared_ptr<const CacheLine> line)
 {
-  Cache* oldest = &m_cache[0];
-  // Find the Least Recently Used cache line to replace.
-  std::for_each(m_cache.begin() + 1, m_cache.end(), [&](Cache& line) {
-    if (line.IsLessRecentlyUsedThan(*oldest))
-    {
-      oldest->ShiftLRU();
-      oldest = &line;
-      return;
-    }
-    line.ShiftLRU();
-  });
-  oldest->Reset();
-  return oldest;
+  std::lock_guard lk(m_mutex);
+
+  // Another reader sharing this cache may have read the same chunk in the meantime
+  if (m_line_map.contains(chunk_num))
+    return;
+
+  m_size += line->data.size();
+  m_lines.push_front(Entry{chunk_num, std::move(line)});
+  m_line_map.emplace(chunk_num, m_lines.begin());
+
+  const u64 capacity = s_sector_reader_cache_size.load(std::memory_order_relaxed);
+  while (m_size > capacity && m_lines.size() > 1)
+  {
+    const Entry& oldest = m_lines.back();
+    m_size -= oldest.line->data.size();
+    m_line_map.erase(oldest.chunk_num);
+    m_lines.pop_back();
+  }
 }
 
-const SectorReader::Cache* SectorReader::GetCacheLine(u64 block_num)
+void SectorReader::Cache::Clear()
 {
-  if (auto entry = FindCacheLine(block_num))
-    return entry;
-
-  // Cache miss. Fault in the missing entry.
-  Cache* cache = GetEmptyCacheLine();
-  // We only read aligned chunks, this avoids duplicate overlapping entries.
-  u64 chunk_idx = block_num / m_chunk_blocks;
-  u32 blocks_read = ReadChunk(cache->data.data(), chunk_idx);
-  if (!blocks_read)
+  std::lock_guard lk(m_mutex);
+
+  m_lines.clear();
+  m_line_map.clear();
+  m_size = 0;
+}
+
+std::shared_ptr<const SectorReader::CacheLine> SectorReader::GetCacheLine(u64 chunk_num)
+{
+  if (std::shared_ptr<const CacheLine> line = m_cache->Find(chunk_num))
+    return line;
+
+  // Cache miss. Fault in the missing chunk.
+  auto line = std::make_shared<CacheLine>();
+  line->data.resize(static_cast<size_t>(m_chunk_blocks) * m_block_size);
+  line->num_blocks = ReadChunk(line->data.data(), chunk_num);
+  if (!line->num_blocks)
     return nullptr;
-  cache->Fill(chunk_idx * m_chunk_blocks, blocks_read);
 
-  // Secondary check for out-of-bounds read.
-  // If we got less than m_chunk_blocks, we may still have missed.
-  // We do this after the cache fill since the cache line itself is
-  // fine, the problem is being asked to read past the end of the disk.
-  return cache->Contains(block_num) ? cache : nullptr;
+  m_cache->Insert(chunk_num, line);
+  return line;
 }
 
 bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
@@ -144,16 +163,24 @@ bool SectorReader::Read(u64 offset, u64 size, u8* out_ptr)
   {
     block = offset / m_block_size;
 
-    const Cache* cache = GetCacheLine(block);
-    if (!cache)
+    // We only read aligned chunks, this avoids duplicate overlapping entries.
+    const u64 chunk_num = block / m_chunk_blocks;
+    const std::shared_ptr<const CacheLine> line = GetCacheLine(chunk_num);
+    if (!line)
+      return false;
+
+    // If we got less than m_chunk_blocks, we may still have missed, since
+    // we may have been asked to read past the end of the disk.
+    const u64 block_in_chunk = block - chunk_num * m_chunk_blocks;
+    if (block_in_chunk >= line->num_blocks)
       return false;
 
     // Cache entries are aligned chunks, we may not want to read from the start
-    u32 read_offset = static_cast<u32>(block - cache->block_idx) * m_block_size + position_in_block;
-    u32 can_read = m_block_size * cache->num_blocks - read_offset;
+    u32 read_offset = static_cast<u32>(block_in_chunk) * m_block_size + position_in_block;
+    u32 can_read = m_block_size * line->num_blocks - read_offset;
     u32 was_read = static_cast<u32>(std::min<u64>(can_read, remain));
 
-    std::copy(cache->data.begin() + read_offset, cache->data.begin() + read_offset + was_read,
+    std::copy(line->data.begin() + read_offset, line->data.begin() + read_offset + was_read,
               out_ptr);
 
     offset += was_read;
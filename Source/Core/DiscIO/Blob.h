@@ -13,11 +13,13 @@
 // detect whether the file is a compressed blob, or just a big hunk of data, or a drive, and
 // automatically do the right thing.
 
-#include <array>
 #include <functional>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
@@ -129,53 +131,43 @@ protected:
   // overridden in derived classes where possible.
   virtual bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr);
 
+  // Makes this reader use the cache of another reader of the same file,
+  // so that readers created with CopyReader don't have to fill their own caches.
+  void ShareCache(const SectorReader& other);
+
 private:
-  struct Cache
+  struct CacheLine
   {
     std::vector<u8> data;
-    u64 block_idx = 0;
     u32 num_blocks = 0;
+  };
 
-    // [Pseudo-] Least Recently Used Shift Register
-    // When an empty cache line is needed, the line with the lowest value
-    // is taken and reset; the LRU register is then shifted down 1 place
-    // on all lines (low bit discarded). When a line is used, the high bit
-    // is set marking it as most recently used.
-    u32 lru_sreg = 0;
+  // Least recently used cache of chunks, indexed by chunk number.
+  // Can be shared by several readers on different threads.
+  class Cache
+  {
+  public:
+    std::shared_ptr<const CacheLine> Find(u64 chunk_num);
+    void Insert(u64 chunk_num, std::shared_ptr<const CacheLine> line);
+    void Clear();
 
-    void Reset()
-    {
-      block_idx = 0;
-      num_blocks = 0;
-      lru_sreg = 0;
-    }
-    void Fill(u64 block, u32 count)
+  private:
+    struct Entry
     {
-      block_idx = block;
-      num_blocks = count;
-      // NOTE: Setting only the high bit means the newest line will
-      //   be selected for eviction if every line in the cache was
-      //   touched. This gives MRU behavior which is probably
-      //   desirable in that case.
-      MarkUsed();
-    }
-    bool Contains(u64 block) const { return block >= block_idx && block - block_idx < num_blocks; }
-    void MarkUsed() { lru_sreg |= 0x80000000; }
-    void ShiftLRU() { lru_sreg >>= 1; }
-    bool IsLessRecentlyUsedThan(const Cache& other) const { return lru_sreg < other.lru_sreg; }
+      u64 chunk_num;
+      std::shared_ptr<const CacheLine> line;
+    };
+
+    std::mutex m_mutex;
+    // Most recently used first
+    std::list<Entry> m_lines;
+    std::unordered_map<u64, std::list<Entry>::iterator> m_line_map;
+    u64 m_size = 0;
   };
 
-  // Gets the cache line that contains the given block, or nullptr.
-  // NOTE: The cache record only lasts until it expires (next GetEmptyCacheLine)
-  const Cache* FindCacheLine(u64 block_num);
-
-  // Finds the least recently used cache line, resets and returns it.
-  Cache* GetEmptyCacheLine();
-
-  // Combines FindCacheLine with GetEmptyCacheLine and ReadChunk.
-  // Always returns a valid cache line (loading the data if needed).
-  // May return nullptr only if the cache missed and the read failed.
-  const Cache* GetCacheLine(u64 block_num);
+  // Returns the cached chunk, reading it if needed.
+  // Returns nullptr only if the cache missed and the read failed.
+  std::shared_ptr<const CacheLine> GetCacheLine(u64 chunk_num);
 
   // Read all bytes from a chunk of blocks into a buffer.
   // Returns the number of blocks read (may be less than m_chunk_blocks
@@ -183,12 +175,14 @@ private:
   // evenly divisible into chunks). Returns zero if it fails.
   u32 ReadChunk(u8* buffer, u64 chunk_num);
 
-  static constexpr int CACHE_LINES = 32;
   u32 m_block_size = 0;    // Bytes in a sector/block
   u32 m_chunk_blocks = 1;  // Number of sectors/blocks in a chunk
-  std::array<Cache, CACHE_LINES> m_cache;
+  std::shared_ptr<Cache> m_cache = std::make_shared<Cache>();
 };
 
+// Sets how many bytes of chunks the cache of a SectorReader (and its copies) may hold.
+void SetSectorReaderCacheSize(u64 bytes);
+
 // Factory function - examines the path to choose the right type of BlobReader, and returns one.
 std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename);
 
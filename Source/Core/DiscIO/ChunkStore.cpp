@@ -0,0 +1,217 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ChunkStore.h"
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+#include "Common/Swap.h"
+
+namespace DiscIO
+{
+static std::string GetIndexPath(const std::string& directory)
+{
+  return directory + "/chunks.idx";
+}
+
+std::string ChunkStore::GetDataPath(const std::string& directory)
+{
+  return directory + "/chunks.bin";
+}
+
+ChunkStore::ChunkStore(File::IOFile data_file, File::IOFile index_file)
+    : m_data_file(std::move(data_file)), m_index_file(std::move(index_file))
+{
+}
+
+std::unique_ptr<ChunkStore> ChunkStore::Open(const std::string& directory)
+{
+  if (!File::CreateDirs(directory))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to create chunk store {}", directory);
+    return nullptr;
+  }
+
+  const std::string index_path = GetIndexPath(directory);
+  const u64 data_size = File::GetSize(GetDataPath(directory));
+
+  std::vector<IndexEntry> entries;
+  bool index_damaged = false;
+  {
+    File::IOFile index_file(index_path, "rb");
+    if (index_file)
+    {
+      const u64 index_size = index_file.GetSize();
+      entries.resize(index_size / sizeof(IndexEntry));
+      if (!index_file.ReadArray(entries.data(), entries.size()))
+      {
+        ERROR_LOG_FMT(DISCIO, "Failed to read the index of chunk store {}", directory);
+        return nullptr;
+      }
+
+      // An entry that was only partially written would misalign all entries appended after it
+      index_damaged = index_size % sizeof(IndexEntry) != 0;
+    }
+  }
+
+  // The data of a chunk is written before its entry, but the data may still not have made it to
+  // the disk if writing was interrupted
+  const size_t removed_entries = std::erase_if(entries, [data_size](const IndexEntry& entry) {
+    const u64 offset = Common::swap64(entry.offset);
+    return offset > data_size || Common::swap32(entry.size) > data_size - offset;
+  });
+  index_damaged |= removed_entries != 0;
+
+  if (index_damaged)
+  {
+    WARN_LOG_FMT(DISCIO, "Repairing the index of chunk store {}", directory);
+    File::IOFile index_file(index_path, "wb");
+    if (!index_file || !index_file.WriteArray(entries.data(), entries.size()))
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to repair the index of chunk store {}", directory);
+      return nullptr;
+    }
+  }
+
+  std::map<Common::SHA1::Digest, IndexEntry> index;
+  for (const IndexEntry& entry : entries)
+    index.emplace(entry.hash, entry);
+
+  File::IOFile data_file(GetDataPath(directory), "ab");
+  File::IOFile index_file(index_path, "ab");
+  if (!data_file || !index_file)
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to open chunk store {}", directory);
+    return nullptr;
+  }
+
+  std::unique_ptr<ChunkStore> store(new ChunkStore(std::move(data_file), std::move(index_file)));
+  store->m_index = std::move(index);
+  store->m_data_size = store->m_data_file.GetSize();
+  return store;
+}
+
+std::optional<u64> ChunkStore::Add(const u8* data, u32 size)
+{
+  const Common::SHA1::Digest hash = Common::SHA1::CalculateDigest(data, size);
+
+  const auto it = m_index.find(hash);
+  if (it != m_index.end() && Common::swap32(it->second.size) == size)
+  {
+    m_reused_bytes += size;
+    return Common::swap64(it->second.offset);
+  }
+
+  const u64 offset = m_data_size;
+  if (!m_data_file.WriteBytes(data, size))
+    return std::nullopt;
+  m_data_size += size;
+
+  const IndexEntry entry{hash, Common::swap64(offset), Common::swap32(size)};
+  if (!m_index_file.WriteArray(&entry, 1))
+    return std::nullopt;
+
+  m_index.emplace(hash, entry);
+  m_added_bytes += size;
+  return offset;
+}
+
+bool ChunkStore::Flush()
+{
+  return m_data_file.Flush() && m_index_file.Flush();
+}
+
+std::optional<PackedInfo> ReadPackedInfo(File::IOFile* file, const std::string& path)
+{
+  const u64 file_size = file->GetSize();
+  PackedFooter footer;
+  if (file_size < sizeof(footer) ||
+      !file->Seek(file_size - sizeof(footer), File::SeekOrigin::Begin) ||
+      !file->ReadArray(&footer, 1) || footer.magic != PACKED_MAGIC)
+  {
+    return std::nullopt;
+  }
+
+  if (Common::swap32(footer.version) != PACKED_VERSION)
+  {
+    ERROR_LOG_FMT(DISCIO, "Unsupported packed file version {} in {}",
+                  Common::swap32(footer.version), path);
+    return std::nullopt;
+  }
+
+  PackedInfo info;
+  info.metadata_size = Common::swap64(footer.metadata_size);
+
+  const u64 refs_offset = Common::swap64(footer.refs_offset);
+  const u32 number_of_refs = Common::swap32(footer.number_of_refs);
+  const u32 store_path_size = Common::swap32(footer.store_path_size);
+  if (refs_offset != info.metadata_size + store_path_size ||
+      refs_offset + static_cast<u64>(number_of_refs) * sizeof(PackedRef) + sizeof(footer) !=
+          file_size)
+  {
+    return std::nullopt;
+  }
+
+  std::string store_path(store_path_size, '\0');
+  std::vector<PackedRef> refs(number_of_refs);
+  if (!file->Seek(info.metadata_size, File::SeekOrigin::Begin) ||
+      !file->ReadBytes(store_path.data(), store_path.size()) ||
+      !file->ReadArray(refs.data(), refs.size()))
+  {
+    return std::nullopt;
+  }
+
+  // The store path is relative to the directory containing the packed file
+  const std::filesystem::path store_fs_path = StringToPath(store_path);
+  if (store_fs_path.is_relative())
+    info.store_path = PathToString(StringToPath(path).parent_path() / store_fs_path);
+  else
+    info.store_path = std::move(store_path);
+
+  for (const PackedRef& ref : refs)
+    info.refs.emplace(Common::swap64(ref.offset_in_file), Common::swap64(ref.offset_in_store));
+
+  return info;
+}
+
+bool WritePackedInfo(File::IOFile* file, const std::string& path, const PackedInfo& info)
+{
+  std::error_code error;
+  const std::filesystem::path directory =
+      std::filesystem::absolute(StringToPath(path), error).parent_path();
+  std::string store_path =
+      PathToString(std::filesystem::proximate(StringToPath(info.store_path), directory, error));
+  if (error)
+    store_path = info.store_path;
+  UnifyPathSeparators(store_path);
+
+  std::vector<PackedRef> refs;
+  refs.reserve(info.refs.size());
+  for (const auto& [offset_in_file, offset_in_store] : info.refs)
+    refs.push_back({Common::swap64(offset_in_file), Common::swap64(offset_in_store)});
+
+  PackedFooter footer;
+  footer.metadata_size = Common::swap64(info.metadata_size);
+  footer.refs_offset = Common::swap64(info.metadata_size + store_path.size());
+  footer.number_of_refs = Common::swap32(static_cast<u32>(refs.size()));
+  footer.store_path_size = Common::swap32(static_cast<u32>(store_path.size()));
+  footer.version = Common::swap32(PACKED_VERSION);
+  footer.magic = PACKED_MAGIC;
+
+  return file->Seek(info.metadata_size, File::SeekOrigin::Begin) &&
+         file->WriteBytes(store_path.data(), store_path.size()) &&
+         file->WriteArray(refs.data(), refs.size()) && file->WriteArray(&footer, 1);
+}
+}  // namespace DiscIO
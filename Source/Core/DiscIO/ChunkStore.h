@@ -0,0 +1,98 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/IOFile.h"
+
+namespace DiscIO
+{
+// A directory of deduplicated chunks of data, which packed WIA/RVZ files refer to instead of
+// containing their compressed groups themselves. Identical groups in different files (such as
+// the different regions or revisions of a game) are only stored once.
+//
+// The chunks are appended to one data file, and an index file maps the hash of each chunk to its
+// location. Chunks are never removed. Only one process may add chunks to a store at a time.
+class ChunkStore
+{
+public:
+  static std::unique_ptr<ChunkStore> Open(const std::string& directory);
+
+  // Returns the offset of the chunk in the data file, adding it to the store if it isn't there
+  std::optional<u64> Add(const u8* data, u32 size);
+  bool Flush();
+
+  u64 GetAddedBytes() const { return m_added_bytes; }
+  u64 GetReusedBytes() const { return m_reused_bytes; }
+
+  static std::string GetDataPath(const std::string& directory);
+
+private:
+#pragma pack(push, 1)
+  struct IndexEntry
+  {
+    Common::SHA1::Digest hash;
+    u64 offset;
+    u32 size;
+  };
+  static_assert(sizeof(IndexEntry) == 0x20, "Wrong size for chunk store index entry");
+#pragma pack(pop)
+
+  ChunkStore(File::IOFile data_file, File::IOFile index_file);
+
+  File::IOFile m_data_file;
+  File::IOFile m_index_file;
+  std::map<Common::SHA1::Digest, IndexEntry> m_index;
+  u64 m_data_size = 0;
+
+  u64 m_added_bytes = 0;
+  u64 m_reused_bytes = 0;
+};
+
+// Stored at the very end of a packed WIA/RVZ file. Everything in front of the groups is copied
+// from the original file, followed by the path of the chunk store and then a table that maps the
+// offset of each group in the original file to its offset in the chunk store.
+#pragma pack(push, 1)
+struct PackedFooter
+{
+  u64 metadata_size;
+  u64 refs_offset;
+  u32 number_of_refs;
+  u32 store_path_size;
+  u32 version;
+  u32 magic;
+};
+static_assert(sizeof(PackedFooter) == 0x20, "Wrong size for packed footer");
+
+struct PackedRef
+{
+  u64 offset_in_file;
+  u64 offset_in_store;
+};
+static_assert(sizeof(PackedRef) == 0x10, "Wrong size for packed ref");
+#pragma pack(pop)
+
+constexpr u32 PACKED_MAGIC = 0x4B434150;  // "PACK" (byteswapped to little endian)
+constexpr u32 PACKED_VERSION = 1;
+
+struct PackedInfo
+{
+  // Absolute, or relative to the current directory
+  std::string store_path;
+  u64 metadata_size;
+  // Offset in the original file -> offset in the chunk store's data file
+  std::map<u64, u64> refs;
+};
+
+// Returns nullopt if the file doesn't end with a valid PackedFooter
+std::optional<PackedInfo> ReadPackedInfo(File::IOFile* file, const std::string& path);
+
+bool WritePackedInfo(File::IOFile* file, const std::string& path, const PackedInfo& info);
+}  // namespace DiscIO
@@ -76,7 +76,10 @@ CompressedBlobReader::~CompressedBlobReader()
 
 std::unique_ptr<BlobReader> CompressedBlobReader::CopyReader() const
 {
-  return Create(m_file.Duplicate("rb"), m_file_name);
+  std::unique_ptr<CompressedBlobReader> reader = Create(m_file.Duplicate("rb"), m_file_name);
+  if (reader)
+    reader->ShareCache(*this);
+  return reader;
 }
 
 // IMPORTANT: Calling this function invalidates all earlier pointers gotten from this function.
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
@@ -22,11 +23,13 @@
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/MsgHandler.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Core/Boot/DolReader.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/DirectoryScanCache.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/VolumeWii.h"
@@ -97,9 +100,9 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer, DirectoryBlobReade
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      File::IOFile* file = blob->GetHostFile(content.m_filename);
+      if (!file || !file->Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
+          !file->ReadBytes(*buffer, bytes_to_read))
       {
         return false;
       }
@@ -544,6 +547,36 @@ BlobType DirectoryBlobReader::GetBlobType() const
   return BlobType::DIRECTORY;
 }
 
+File::IOFile* DirectoryBlobReader::GetHostFile(const std::string& path)
+{
+  const auto it = std::find_if(m_host_files.begin(), m_host_files.end(),
+                               [&path](const auto& host_file) { return host_file.first == path; });
+  if (it != m_host_files.end())
+  {
+    m_host_files.splice(m_host_files.begin(), m_host_files, it);
+    return &m_host_files.front().second;
+  }
+
+  File::IOFile file(path, "rb");
+  if (!file)
+    return nullptr;
+
+  // The FST may have been built from a cached directory listing that predates the file being
+  // overwritten in place
+  if (!RevalidateCachedFile(path, file.GetSize()))
+  {
+    ERROR_LOG_FMT(DISCIO, "{} has changed size since its directory listing was cached", path);
+    PanicAlertFmtT("The size of \"{0}\" has changed since the file list of this game was cached.\n"
+                   "\nRestart the game to use the changed file.",
+                   path);
+  }
+
+  if (m_host_files.size() >= MAX_OPEN_HOST_FILES)
+    m_host_files.pop_back();
+  m_host_files.emplace_front(path, std::move(file));
+  return &m_host_files.front().second;
+}
+
 std::unique_ptr<BlobReader> DirectoryBlobReader::CopyReader() const
 {
   return std::unique_ptr<DirectoryBlobReader>(new DirectoryBlobReader(*this));
@@ -1084,7 +1117,8 @@ static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::F
 void DirectoryBlobPartition::BuildFSTFromFolder(const std::string& fst_root_path, u64 fst_address,
                                                 std::vector<u8>* disc_header)
 {
-  auto nodes = ConvertFSTEntriesToBuilderNodes(File::ScanDirectoryTree(fst_root_path, true));
+  auto nodes = ConvertFSTEntriesToBuilderNodes(ScanDirectoryTreeCached(fst_root_path, true));
+  SaveDirectoryScanCache();
   BuildFST(std::move(nodes), fst_address, disc_header);
 }
 
@@ -6,16 +6,19 @@
 #include <array>
 #include <cstddef>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -23,7 +26,6 @@
 namespace File
 {
 struct FSTEntry;
-class IOFile;
 }  // namespace File
 
 namespace DiscIO
@@ -313,6 +315,10 @@ private:
 
   DiscIO::VolumeDisc* GetWrappedVolume() { return m_wrapped_volume.get(); }
 
+  // Host files are only opened once their contents are first read. The most recently read ones
+  // are kept open, since games usually issue many reads for the same file in a row.
+  File::IOFile* GetHostFile(const std::string& path);
+
   // For GameCube:
   DirectoryBlobPartition m_gamecube_pseudopartition;
 
@@ -327,6 +333,9 @@ private:
   u64 m_data_size;
 
   std::unique_ptr<DiscIO::VolumeDisc> m_wrapped_volume;
+
+  static constexpr size_t MAX_OPEN_HOST_FILES = 8;
+  std::list<std::pair<std::string, File::IOFile>> m_host_files;
 };
 
 }  // namespace DiscIO
@@ -0,0 +1,308 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/DirectoryScanCache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace DiscIO
+{
+namespace
+{
+struct CachedEntry
+{
+  std::string name;
+  bool is_directory = false;
+  u64 size = 0;
+  // Only set for files, so that files overwritten in place can be detected when they're opened
+  s64 modification_time = 0;
+};
+
+struct CachedDirectory
+{
+  s64 modification_time = 0;
+  std::vector<CachedEntry> entries;
+};
+}  // namespace
+
+// Last changed when the layout of the cache file changed
+constexpr u32 CACHE_REVISION = 2;
+
+// A directory that was changed this recently could be changed again without getting a different
+// modification time (FAT only stores it with a precision of two seconds), so it isn't cached yet.
+constexpr auto MIN_AGE_FOR_CACHING = std::chrono::seconds(2);
+
+static std::atomic<bool> s_caching_enabled = false;
+
+static std::mutex s_mutex;
+static std::map<std::string, CachedDirectory> s_directories;
+static bool s_loaded = false;
+static bool s_dirty = false;
+
+static std::string GetCachePath()
+{
+  return File::GetUserPath(D_CACHE_IDX) + "directories.cache";
+}
+
+static void DoState(PointerWrap& p)
+{
+  u32 revision = CACHE_REVISION;
+  p.Do(revision);
+  if (revision != CACHE_REVISION)
+  {
+    p.SetMeasureMode();
+    return;
+  }
+
+  const auto do_directory = [](PointerWrap& pw, CachedDirectory& directory) {
+    pw.Do(directory.modification_time);
+    pw.DoEachElement(directory.entries, [](PointerWrap& pe, CachedEntry& entry) {
+      pe.Do(entry.name);
+      pe.Do(entry.is_directory);
+      pe.Do(entry.size);
+      pe.Do(entry.modification_time);
+    });
+  };
+
+  u32 count = static_cast<u32>(s_directories.size());
+  p.Do(count);
+  if (p.IsReadMode())
+  {
+    s_directories.clear();
+    for (; count != 0 && p.IsReadMode(); --count)
+    {
+      std::string path;
+      CachedDirectory directory;
+      p.Do(path);
+      do_directory(p, directory);
+      s_directories.emplace(std::move(path), std::move(directory));
+    }
+  }
+  else
+  {
+    for (auto& [path, directory] : s_directories)
+    {
+      std::string key = path;
+      p.Do(key);
+      do_directory(p, directory);
+    }
+  }
+}
+
+static void LoadIfNeeded()
+{
+  if (s_loaded)
+    return;
+  s_loaded = true;
+
+  std::string buffer;
+  if (!File::ReadFileToString(GetCachePath(), buffer))
+    return;
+
+  u8* ptr = reinterpret_cast<u8*>(buffer.data());
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
+  DoState(p);
+  if (!p.IsReadMode())
+  {
+    INFO_LOG_FMT(DISCIO, "Discarding outdated or corrupted directory scan cache");
+    s_directories.clear();
+  }
+}
+
+static std::optional<s64> GetModificationTime(const std::string& path, bool* can_cache = nullptr)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), error);
+  if (error)
+    return std::nullopt;
+
+  if (can_cache)
+    *can_cache = std::filesystem::file_time_type::clock::now() - time >= MIN_AGE_FOR_CACHING;
+  return static_cast<s64>(time.time_since_epoch().count());
+}
+
+// Returns nullopt if the directory can't be listed, in which case the caller should fall back to
+// an uncached scan so that errors are handled exactly like before.
+static std::optional<std::vector<CachedEntry>> ListDirectory(const std::string& directory)
+{
+  bool can_cache;
+  const std::optional<s64> modification_time = GetModificationTime(directory, &can_cache);
+  if (!modification_time)
+  {
+    if (s_directories.erase(directory) != 0)
+      s_dirty = true;
+    return std::nullopt;
+  }
+
+  const auto it = s_directories.find(directory);
+  if (it != s_directories.end() && it->second.modification_time == *modification_time)
+    return it->second.entries;
+
+  const File::FSTEntry listing = File::ScanDirectoryTree(directory, false);
+  std::vector<CachedEntry> entries;
+  entries.reserve(listing.children.size());
+  for (const File::FSTEntry& child : listing.children)
+  {
+    if (child.isDirectory)
+      entries.push_back({child.virtualName, true, 0, 0});
+    else
+      entries.push_back({child.virtualName, false, child.size,
+                         GetModificationTime(child.physicalName).value_or(0)});
+  }
+
+  if (can_cache)
+  {
+    s_directories.insert_or_assign(directory, CachedDirectory{*modification_time, entries});
+    s_dirty = true;
+  }
+  else if (it != s_directories.end())
+  {
+    s_directories.erase(it);
+    s_dirty = true;
+  }
+
+  return entries;
+}
+
+static std::optional<File::FSTEntry> Scan(const std::string& directory, bool recursive)
+{
+  std::optional<std::vector<CachedEntry>> entries = ListDirectory(directory);
+  if (!entries)
+    return std::nullopt;
+
+  File::FSTEntry parent;
+  parent.isDirectory = true;
+  parent.physicalName = directory;
+  parent.children.reserve(entries->size());
+
+  const bool add_separator = !directory.empty() && directory.back() != '/';
+  for (CachedEntry& entry : *entries)
+  {
+    std::string physical_name = add_separator ? directory + '/' + entry.name :
+                                                directory + entry.name;
+
+    File::FSTEntry child;
+    if (entry.is_directory && recursive)
+    {
+      std::optional<File::FSTEntry> subdirectory = Scan(physical_name, true);
+      child = subdirectory ? std::move(*subdirectory) :
+                             File::ScanDirectoryTree(physical_name, true);
+      parent.size += child.size;
+    }
+    else if (!entry.is_directory)
+    {
+      child.size = entry.size;
+    }
+
+    child.isDirectory = entry.is_directory;
+    child.physicalName = std::move(physical_name);
+    child.virtualName = std::move(entry.name);
+    parent.children.push_back(std::move(child));
+  }
+  parent.size += parent.children.size();
+
+  return parent;
+}
+
+File::FSTEntry ScanDirectoryTreeCached(const std::string& directory, bool recursive)
+{
+  if (!s_caching_enabled)
+    return File::ScanDirectoryTree(directory, recursive);
+
+  std::lock_guard lk(s_mutex);
+  LoadIfNeeded();
+
+  std::optional<File::FSTEntry> result = Scan(directory, recursive);
+  if (!result)
+    return File::ScanDirectoryTree(directory, recursive);
+  return std::move(*result);
+}
+
+bool RevalidateCachedFile(const std::string& path, u64 size)
+{
+  if (!s_caching_enabled)
+    return true;
+
+  const size_t separator = path.rfind('/');
+  if (separator == std::string::npos)
+    return true;
+  const std::string_view name = std::string_view(path).substr(separator + 1);
+
+  std::lock_guard lk(s_mutex);
+
+  // Only the directory that a scan was started from can be stored with a trailing separator
+  auto it = s_directories.find(path.substr(0, separator));
+  if (it == s_directories.end())
+    it = s_directories.find(path.substr(0, separator + 1));
+  if (it == s_directories.end())
+    return true;
+
+  const std::vector<CachedEntry>& entries = it->second.entries;
+  const auto entry = std::find_if(entries.begin(), entries.end(), [&](const CachedEntry& e) {
+    return !e.is_directory && e.name == name;
+  });
+  if (entry == entries.end())
+    return true;
+
+  const bool size_matches = entry->size == size;
+  if (size_matches && GetModificationTime(path) == entry->modification_time)
+    return true;
+
+  // The file was overwritten in place, which doesn't change the modification time of the directory
+  s_directories.erase(it);
+  s_dirty = true;
+  return size_matches;
+}
+
+void SaveDirectoryScanCache()
+{
+  std::lock_guard lk(s_mutex);
+  if (!s_dirty)
+    return;
+  s_dirty = false;
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoState(p_measure);
+
+  std::vector<u8> buffer(reinterpret_cast<size_t>(ptr));
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  DoState(p);
+
+  File::IOFile file(GetCachePath(), "wb");
+  if (!file || !file.WriteBytes(buffer.data(), buffer.size()))
+    ERROR_LOG_FMT(DISCIO, "Failed to write directory scan cache {}", GetCachePath());
+}
+
+void ShutdownDirectoryScanCache()
+{
+  SaveDirectoryScanCache();
+
+  std::lock_guard lk(s_mutex);
+  s_directories.clear();
+  s_loaded = false;
+}
+
+void SetDirectoryScanCaching(bool enabled)
+{
+  s_caching_enabled = enabled;
+}
+}  // namespace DiscIO
@@ -0,0 +1,35 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+
+namespace DiscIO
+{
+// Same as File::ScanDirectoryTree, but the listing of each directory is remembered along with the
+// modification time of the directory and reused for as long as that doesn't change. When nothing
+// has changed, only the directories have to be looked at instead of every file inside them.
+//
+// Overwriting an existing file in place doesn't change the modification time of its directory,
+// so the cached size of such a file is only found to be outdated by RevalidateCachedFile.
+File::FSTEntry ScanDirectoryTreeCached(const std::string& directory, bool recursive);
+
+// Compares the size and modification time of a file that is being opened with its cached listing,
+// and drops the listing of its directory if they don't match. Returns false if the size doesn't
+// match, in which case anything built from the cached listing used the wrong size for the file.
+bool RevalidateCachedFile(const std::string& path, u64 size);
+
+// Writes the cached listings to the cache directory if they have changed, so that they can be
+// reused the next time Dolphin starts.
+void SaveDirectoryScanCache();
+
+// Saves the cached listings and frees them. They're loaded from the cache directory again the next
+// time they're needed.
+void ShutdownDirectoryScanCache();
+
+void SetDirectoryScanCaching(bool enabled);
+}  // namespace DiscIO
@@ -4,20 +4,103 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <cstdio>
+#include <sys/mman.h>
+#endif
+
 #include "Common/Assert.h"
+#include "Common/CommonFuncs.h"
 #include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 
 namespace DiscIO
 {
+static std::atomic<bool> s_mapping_enabled = false;
+
+void SetPlainFileMapping(bool enabled)
+{
+  s_mapping_enabled.store(enabled, std::memory_order_relaxed);
+}
+
 PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+
+  if (s_mapping_enabled.load(std::memory_order_relaxed))
+    Map();
+}
+
+PlainFileReader::~PlainFileReader()
+{
+  Unmap();
+}
+
+void PlainFileReader::Map()
+{
+  if (m_size == 0 || m_size > std::numeric_limits<size_t>::max())
+    return;
+
+#ifdef _WIN32
+  const HANDLE file = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(m_file.GetHandle())));
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+  {
+    WARN_LOG_FMT(DISCIO, "Failed to map disc image, reading it normally: {}",
+                 Common::GetLastErrorString());
+    return;
+  }
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!data)
+  {
+    WARN_LOG_FMT(DISCIO, "Failed to map disc image, reading it normally: {}",
+                 Common::GetLastErrorString());
+    CloseHandle(mapping);
+    return;
+  }
+
+  m_mapping_handle = mapping;
+#else
+  void* data = mmap(nullptr, static_cast<size_t>(m_size), PROT_READ, MAP_SHARED,
+                    fileno(m_file.GetHandle()), 0);
+  if (data == MAP_FAILED)
+  {
+    WARN_LOG_FMT(DISCIO, "Failed to map disc image, reading it normally: {}",
+                 Common::LastStrerrorString());
+    return;
+  }
+#endif
+
+  m_mapped_data = static_cast<const u8*>(data);
+}
+
+void PlainFileReader::Unmap()
+{
+  if (!m_mapped_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_mapped_data);
+  CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  munmap(const_cast<u8*>(m_mapped_data), static_cast<size_t>(m_size));
+#endif
+
+  m_mapped_data = nullptr;
 }
 
 std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
@@ -35,6 +118,15 @@ std::unique_ptr<BlobReader> PlainFileReader::CopyReader() const
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapped_data)
+  {
+    if (offset > m_size || nbytes > m_size - offset)
+      return false;
+
+    std::memcpy(out_ptr, m_mapped_data + offset, static_cast<size_t>(nbytes));
+    return true;
+  }
+
   if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
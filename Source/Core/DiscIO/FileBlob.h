@@ -13,9 +13,17 @@
 
 namespace DiscIO
 {
+// Sets whether PlainFileReaders created from now on should memory map their files. Reads from a
+// mapped file are plain copies instead of a seek and a read call each, but an I/O error while
+// accessing a mapped file (such as a removed drive or a dropped network share) crashes the process
+// instead of failing the read.
+void SetPlainFileMapping(bool enabled);
+
 class PlainFileReader : public BlobReader
 {
 public:
+  ~PlainFileReader();
+
   static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
@@ -32,11 +40,22 @@ public:
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
 
+  bool IsMapped() const { return m_mapped_data != nullptr; }
+
 private:
   PlainFileReader(File::IOFile file);
 
+  void Map();
+  void Unmap();
+
   File::IOFile m_file;
   u64 m_size;
+
+  // If mapping the file fails, it is read using m_file instead
+  const u8* m_mapped_data = nullptr;
+#ifdef _WIN32
+  void* m_mapping_handle = nullptr;
+#endif
 };
 
 }  // namespace DiscIO
@@ -4,8 +4,10 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <utility>
 #include <variant>
@@ -29,6 +31,46 @@ enum class ConversionResultCode
 template <typename T>
 using ConversionResult = Common::Result<ConversionResultCode, T>;
 
+// Limits how many compress functions may run at the same time across all
+// MultithreadedCompressors in the process. There is no limit by default. Setting one lets
+// several conversions run at once, overlapping the reading and writing of one file with the
+// compression of another, without running more compression jobs than there are cores.
+class CompressionSlots
+{
+public:
+  // 0 means no limit
+  static void SetLimit(size_t limit)
+  {
+    {
+      std::lock_guard lk(s_mutex);
+      s_limit = limit;
+    }
+    s_cond_var.notify_all();
+  }
+
+  static void Acquire()
+  {
+    std::unique_lock lk(s_mutex);
+    s_cond_var.wait(lk, [] { return s_limit == 0 || s_in_use < s_limit; });
+    ++s_in_use;
+  }
+
+  static void Release()
+  {
+    {
+      std::lock_guard lk(s_mutex);
+      --s_in_use;
+    }
+    s_cond_var.notify_one();
+  }
+
+private:
+  static inline std::mutex s_mutex;
+  static inline std::condition_variable s_cond_var;
+  static inline size_t s_limit = 0;
+  static inline size_t s_in_use = 0;
+};
+
 // This class starts a number of compression threads and one output thread.
 // The set_up_compress_thread_state function is called at the start of each compression thread.
 // When CompressAndWrite is called, the compress function will be called on one of the
@@ -156,8 +198,10 @@ private:
       state->compress_done_event.Reset();
       state->compress_ready_event.Set();
 
+      CompressionSlots::Acquire();
       ConversionResult<OutputParameters> result =
           m_compress(&compress_thread_state, std::move(parameters));
+      CompressionSlots::Release();
 
       if (result)
       {
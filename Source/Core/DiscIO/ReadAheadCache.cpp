@@ -0,0 +1,140 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/ReadAheadCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "DiscIO/Volume.h"
+
+namespace DiscIO
+{
+// Number of back-to-back sequential reads before we start reading ahead
+constexpr u32 SEQUENTIAL_THRESHOLD = 2;
+
+ReadAheadCache::ReadAheadCache(u64 capacity)
+    : m_capacity_blocks(capacity / BLOCK_SIZE),
+      m_read_ahead(Common::AlignDown(capacity / 2, BLOCK_SIZE)), m_stream_partition(PARTITION_NONE)
+{
+}
+
+bool ReadAheadCache::Read(const Volume& volume, u64 offset, u64 length, u8* buffer,
+                          const Partition& partition)
+{
+  DetectSequentialRead(offset, length, partition);
+
+  if (length == 0)
+    return volume.Read(offset, length, buffer, partition);
+
+  const u64 first_block = offset / BLOCK_SIZE;
+  const u64 last_block = (offset + length - 1) / BLOCK_SIZE;
+  for (u64 i = first_block; i <= last_block; ++i)
+  {
+    if (!m_block_map.contains(BlockKey(partition, i)))
+    {
+      ++m_stats.misses;
+      return volume.Read(offset, length, buffer, partition);
+    }
+  }
+
+  for (u64 i = first_block; i <= last_block; ++i)
+  {
+    const auto it = m_block_map.find(BlockKey(partition, i))->second;
+    const u64 block_start = i * BLOCK_SIZE;
+    const u64 copy_start = std::max(offset, block_start);
+    const u64 copy_end = std::min(offset + length, block_start + BLOCK_SIZE);
+    std::memcpy(buffer + (copy_start - offset), it->data.data() + (copy_start - block_start),
+                copy_end - copy_start);
+
+    it->used = true;
+    m_blocks.splice(m_blocks.begin(), m_blocks, it);
+  }
+
+  ++m_stats.hits;
+  return true;
+}
+
+void ReadAheadCache::DetectSequentialRead(u64 offset, u64 length, const Partition& partition)
+{
+  const u64 end = offset + length;
+  if (partition == m_stream_partition && offset >= m_stream_end &&
+      offset - m_stream_end <= BLOCK_SIZE)
+  {
+    ++m_sequential_reads;
+  }
+  else
+  {
+    m_sequential_reads = 0;
+    m_stream_partition = partition;
+    m_prefetch_offset = 0;
+  }
+
+  m_stream_end = end;
+  m_prefetch_offset = std::max(m_prefetch_offset, Common::AlignDown(end, BLOCK_SIZE));
+}
+
+bool ReadAheadCache::PrefetchNext(const Volume& volume)
+{
+  if (m_sequential_reads < SEQUENTIAL_THRESHOLD || m_capacity_blocks == 0)
+    return false;
+
+  while (m_prefetch_offset < m_stream_end + m_read_ahead)
+  {
+    const u64 index = m_prefetch_offset / BLOCK_SIZE;
+    m_prefetch_offset += BLOCK_SIZE;
+    if (m_block_map.contains(BlockKey(m_stream_partition, index)))
+      continue;
+
+    std::vector<u8> data(BLOCK_SIZE);
+    if (!volume.Read(index * BLOCK_SIZE, BLOCK_SIZE, data.data(), m_stream_partition))
+    {
+      // Most likely the end of the partition. Wait for the next sequential stream.
+      m_sequential_reads = 0;
+      return false;
+    }
+
+    if (m_blocks.size() >= m_capacity_blocks)
+      Evict(std::prev(m_blocks.end()));
+
+    m_blocks.push_front(Block{m_stream_partition, index, std::move(data), false});
+    m_block_map.emplace(BlockKey(m_stream_partition, index), m_blocks.begin());
+    ++m_stats.prefetched_blocks;
+    return true;
+  }
+
+  return false;
+}
+
+void ReadAheadCache::Evict(std::list<Block>::iterator it)
+{
+  if (!it->used)
+    ++m_stats.wasted_blocks;
+
+  m_block_map.erase(BlockKey(it->partition, it->index));
+  m_blocks.erase(it);
+}
+
+void ReadAheadCache::Clear()
+{
+  while (!m_blocks.empty())
+    Evict(m_blocks.begin());
+
+  m_stream_partition = PARTITION_NONE;
+  m_stream_end = 0;
+  m_sequential_reads = 0;
+  m_prefetch_offset = 0;
+}
+
+void ReadAheadCache::LogStats() const
+{
+  INFO_LOG_FMT(DISCIO, "Read-ahead cache: {} hits, {} misses, {} blocks prefetched, {} wasted",
+               m_stats.hits, m_stats.misses, m_stats.prefetched_blocks, m_stats.wasted_blocks);
+}
+}  // namespace DiscIO
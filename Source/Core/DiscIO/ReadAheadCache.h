@@ -0,0 +1,75 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Volume.h"
+
+namespace DiscIO
+{
+// Caches data read ahead of sequential disc reads, so that reads from slow media or heavily
+// compressed images don't stall the reader. The cache is not thread-safe; it must only be used
+// from the thread that reads from the volume.
+class ReadAheadCache
+{
+public:
+  static constexpr u64 BLOCK_SIZE = 0x20000;
+
+  struct Stats
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 prefetched_blocks = 0;
+    // Prefetched blocks that were evicted or discarded without ever being read
+    u64 wasted_blocks = 0;
+  };
+
+  explicit ReadAheadCache(u64 capacity);
+
+  // Reads from the cache if the whole range is cached, otherwise from the volume.
+  bool Read(const Volume& volume, u64 offset, u64 length, u8* buffer, const Partition& partition);
+
+  // Reads the next block ahead of the current sequential stream of reads, if any.
+  // Returns false if there is nothing left to prefetch.
+  bool PrefetchNext(const Volume& volume);
+
+  void Clear();
+
+  const Stats& GetStats() const { return m_stats; }
+  void LogStats() const;
+
+private:
+  struct Block
+  {
+    Partition partition;
+    u64 index;
+    std::vector<u8> data;
+    bool used;
+  };
+
+  using BlockKey = std::pair<Partition, u64>;
+
+  void DetectSequentialRead(u64 offset, u64 length, const Partition& partition);
+  void Evict(std::list<Block>::iterator it);
+
+  const u64 m_capacity_blocks;
+  const u64 m_read_ahead;
+
+  // Most recently used first
+  std::list<Block> m_blocks;
+  std::map<BlockKey, std::list<Block>::iterator> m_block_map;
+
+  Partition m_stream_partition;
+  u64 m_stream_end = 0;
+  u32 m_sequential_reads = 0;
+  u64 m_prefetch_offset = 0;
+
+  Stats m_stats;
+};
+}  // namespace DiscIO
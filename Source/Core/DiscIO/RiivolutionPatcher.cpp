@@ -22,6 +22,7 @@
 #include "Core/PowerPC/MMU.h"
 #include "Core/System.h"
 #include "DiscIO/DirectoryBlob.h"
+#include "DiscIO/DirectoryScanCache.h"
 #include "DiscIO/RiivolutionParser.h"
 
 namespace DiscIO::Riivolution
@@ -117,35 +118,29 @@ FileDataLoaderHostFS::MakeAbsoluteFromRelative(std::string_view external_relativ
       ++depth;
 
       // Append path element to result string.
-      result += '/';
-      result += element;
-
       // Riivolution assumes a case-insensitive file system, which means it's possible that an XML
       // file references a 'file.bin' but the actual file is named 'File.bin' or 'FILE.BIN'. To
       // preserve this behavior, we modify the file path to match any existing file in the file
       // system, if one exists.
-      if (!::File::Exists(result))
+      const ::File::FSTEntry& possible_files = GetDirectoryListing(result);
+      const ::File::FSTEntry* match = FindInListing(possible_files, element);
+      if (!match)
       {
-        // Drop path element again so we can search in the directory.
-        result.erase(result.size() - element.size(), element.size());
-
-        // Re-attach an element that actually matches the capitalization in the host filesystem.
-        auto possible_files = ::File::ScanDirectoryTree(result, false);
-        bool found = false;
-        for (auto& f : possible_files.children)
-        {
-          if (Common::CaseInsensitiveEquals(element, f.virtualName))
-          {
-            result += f.virtualName;
-            found = true;
-            break;
-          }
-        }
-
-        // If there isn't any file that matches just use the given element.
-        if (!found)
-          result += element;
+        const auto it = std::find_if(
+            possible_files.children.begin(), possible_files.children.end(),
+            [&](const ::File::FSTEntry& f) {
+              return Common::CaseInsensitiveEquals(element, f.virtualName);
+            });
+        if (it != possible_files.children.end())
+          match = &*it;
       }
+
+      // If there isn't any file that matches just use the given element.
+      result += '/';
+      if (match)
+        result += match->virtualName;
+      else
+        result += element;
     }
 
     // If this was the last path element, we're done.
@@ -162,12 +157,47 @@ FileDataLoaderHostFS::MakeAbsoluteFromRelative(std::string_view external_relativ
   return result;
 }
 
+FileDataLoaderHostFS::~FileDataLoaderHostFS()
+{
+  SaveDirectoryScanCache();
+}
+
+const ::File::FSTEntry& FileDataLoaderHostFS::GetDirectoryListing(const std::string& directory)
+{
+  auto it = m_directory_listings.find(directory);
+  if (it == m_directory_listings.end())
+    it = m_directory_listings.emplace(directory, ScanDirectoryTreeCached(directory, false)).first;
+  return it->second;
+}
+
+const ::File::FSTEntry* FileDataLoaderHostFS::FindInListing(const ::File::FSTEntry& listing,
+                                                            std::string_view name)
+{
+  const auto it =
+      std::find_if(listing.children.begin(), listing.children.end(),
+                   [&](const ::File::FSTEntry& entry) { return entry.virtualName == name; });
+  return it != listing.children.end() ? &*it : nullptr;
+}
+
 std::optional<u64>
 FileDataLoaderHostFS::GetExternalFileSize(std::string_view external_relative_path)
 {
   auto path = MakeAbsoluteFromRelative(external_relative_path);
   if (!path)
     return std::nullopt;
+
+  // MakeAbsoluteFromRelative has already listed the directory, so there's usually no need to
+  // look at the file itself.
+  const size_t separator_position = path->rfind('/');
+  if (separator_position != std::string::npos)
+  {
+    const ::File::FSTEntry* entry =
+        FindInListing(GetDirectoryListing(path->substr(0, separator_position)),
+                      std::string_view(*path).substr(separator_position + 1));
+    if (entry)
+      return entry->isDirectory ? std::nullopt : std::make_optional(entry->size);
+  }
+
   ::File::FileInfo f(*path);
   if (!f.IsFile())
     return std::nullopt;
@@ -196,11 +226,11 @@ FileDataLoaderHostFS::GetFolderContents(std::string_view external_relative_path)
   auto path = MakeAbsoluteFromRelative(external_relative_path);
   if (!path)
     return {};
-  ::File::FSTEntry external_files = ::File::ScanDirectoryTree(*path, false);
+  const ::File::FSTEntry& external_files = GetDirectoryListing(*path);
   std::vector<FileDataLoader::Node> nodes;
   nodes.reserve(external_files.children.size());
-  for (auto& file : external_files.children)
-    nodes.emplace_back(FileDataLoader::Node{std::move(file.virtualName), file.isDirectory});
+  for (const auto& file : external_files.children)
+    nodes.emplace_back(FileDataLoader::Node{file.virtualName, file.isDirectory});
   return nodes;
 }
 
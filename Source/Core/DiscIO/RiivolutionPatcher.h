@@ -3,12 +3,14 @@
 
 #pragma once
 
+#include <map>
 #include <optional>
 #include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "Common/FileUtil.h"
 #include "DiscIO/DirectoryBlob.h"
 #include "DiscIO/RiivolutionParser.h"
 
@@ -53,6 +55,7 @@ public:
   // patch_root should be the 'root' attribute given in the 'patch' or 'wiiroot' XML element
   FileDataLoaderHostFS(std::string sd_root, const std::string& xml_path,
                        std::string_view patch_root);
+  ~FileDataLoaderHostFS() override;
 
   std::optional<u64> GetExternalFileSize(std::string_view external_relative_path) override;
   std::vector<u8> GetFileContents(std::string_view external_relative_path) override;
@@ -67,8 +70,15 @@ public:
 private:
   std::optional<std::string> MakeAbsoluteFromRelative(std::string_view external_relative_path);
 
+  // Patches tend to look up many files in the same few directories, so each directory is only
+  // listed once. The listings also persist between boots (see ScanDirectoryTreeCached).
+  const ::File::FSTEntry& GetDirectoryListing(const std::string& directory);
+  static const ::File::FSTEntry* FindInListing(const ::File::FSTEntry& listing,
+                                               std::string_view name);
+
   std::string m_sd_root;
   std::string m_patch_root;
+  std::map<std::string, ::File::FSTEntry> m_directory_listings;
 };
 
 enum class PatchIndex
@@ -4,12 +4,14 @@
 #include "DiscIO/VolumeVerifier.h"
 
 #include <algorithm>
+#include <atomic>
 #include <future>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
@@ -1078,6 +1080,26 @@ void VolumeVerifier::SetUpHashing()
   {
     m_sha1_context = Common::SHA1::CreateContext();
   }
+
+  if (!m_groups.empty())
+  {
+    // The thread running m_group_future checks blocks too, and each hash runs on a thread of its
+    // own, so only use the remaining hardware threads.
+    const size_t hash_thread_count = size_t(m_hashes_to_calculate.crc32) +
+                                     size_t(m_hashes_to_calculate.md5) +
+                                     size_t(m_hashes_to_calculate.sha1);
+    const size_t thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    m_block_thread_count =
+        thread_count > hash_thread_count + 1 ? thread_count - hash_thread_count - 1 : 0;
+
+    m_block_threads =
+        std::make_unique<Common::WorkQueueThread<std::function<void()>>[]>(m_block_thread_count);
+    for (size_t i = 0; i < m_block_thread_count; ++i)
+    {
+      m_block_threads[i].Reset("Block Verification",
+                               [](std::function<void()> function) { function(); });
+    }
+  }
 }
 
 void VolumeVerifier::WaitForAsyncOperations() const
@@ -1243,14 +1265,43 @@ void VolumeVerifier::Process()
     m_group_future = std::async(std::launch::async, [this, read_failed,
                                                      group_index = m_group_index] {
       const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
+      const size_t block_count = group.block_index_end - group.block_index_start;
+
+      std::vector<char> block_ok(block_count, false);
+      const auto check_block = [&](size_t i) {
+        block_ok[i] = !read_failed &&
+                      m_volume.CheckBlockIntegrity(group.block_index_start + i,
+                                                   m_data.data() + i * VolumeWii::BLOCK_TOTAL_SIZE,
+                                                   group.partition);
+      };
+
+      // The first block is checked on its own, since checking a block lazily initializes
+      // per-partition data (the key and the H3 table) which must not be initialized concurrently
+      if (block_count > 0)
+        check_block(0);
+
+      // The remaining blocks are independent of each other. This thread and the block threads
+      // each claim the next unchecked block, so a thread that gets slow blocks doesn't hold up the
+      // others.
+      const size_t helper_count =
+          std::min<size_t>(m_block_thread_count, block_count > 0 ? block_count - 1 : 0);
+      std::atomic<size_t> next_block = 1;
+      const auto check_remaining_blocks = [&] {
+        for (size_t i = next_block++; i < block_count; i = next_block++)
+          check_block(i);
+      };
+
+      for (size_t i = 0; i < helper_count; ++i)
+        m_block_threads[i].Push(check_remaining_blocks);
+      check_remaining_blocks();
+      for (size_t i = 0; i < helper_count; ++i)
+        m_block_threads[i].WaitForCompletion();
+
+      for (size_t i = 0; i < block_count; ++i)
       {
-        const u64 block_offset = group.offset + offset_in_group;
+        const u64 block_offset = group.offset + i * VolumeWii::BLOCK_TOTAL_SIZE;
 
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
+        if (block_ok[i])
         {
           m_biggest_verified_offset =
               std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <future>
 #include <map>
 #include <memory>
@@ -14,6 +15,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -192,6 +194,10 @@ private:
   u16 m_content_index = 0;
   std::vector<GroupToVerify> m_groups;
   size_t m_group_index = 0;  // Index in m_groups, not index in a specific partition
+  // Help m_group_future check the blocks of each group. Started once for the whole verification.
+  // We can't use std::vector for this, because WorkQueueThread is not movable
+  std::unique_ptr<Common::WorkQueueThread<std::function<void()>>[]> m_block_threads;
+  size_t m_block_thread_count = 0;
   std::map<Partition, size_t> m_block_errors;
   std::map<Partition, size_t> m_unused_block_errors;
 
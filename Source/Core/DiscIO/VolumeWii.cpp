@@ -611,8 +611,10 @@ bool VolumeWii::EncryptGroup(
   if (hash_exception_callback)
     hash_exception_callback(unencrypted_hashes.data());
 
-  const unsigned int threads =
-      std::min(BLOCKS_PER_GROUP, std::max<unsigned int>(1, std::thread::hardware_concurrency()));
+  // Give each thread enough blocks for EncryptBlocks to interleave them
+  constexpr size_t MIN_BLOCKS_PER_THREAD = 8;
+  const size_t threads = std::clamp<size_t>(std::thread::hardware_concurrency(), 1,
+                                            BLOCKS_PER_GROUP / MIN_BLOCKS_PER_THREAD);
 
   std::vector<std::future<void>> encryption_futures(threads);
 
@@ -623,16 +625,8 @@ bool VolumeWii::EncryptGroup(
     encryption_futures[i] = std::async(
         std::launch::async,
         [&unencrypted_data, &unencrypted_hashes, &aes_context, &out](size_t start, size_t end) {
-          for (size_t j = start; j < end; ++j)
-          {
-            u8* out_ptr = out->data() + j * BLOCK_TOTAL_SIZE;
-
-            aes_context->CryptIvZero(reinterpret_cast<u8*>(&unencrypted_hashes[j]), out_ptr,
-                                     BLOCK_HEADER_SIZE);
-
-            aes_context->Crypt(out_ptr + 0x3D0, unencrypted_data[j].data(),
-                               out_ptr + BLOCK_HEADER_SIZE, BLOCK_DATA_SIZE);
-          }
+          EncryptBlocks(&unencrypted_hashes[start], &unencrypted_data[start],
+                        out->data() + start * BLOCK_TOTAL_SIZE, end - start, *aes_context);
         },
         i * BLOCKS_PER_GROUP / threads, (i + 1) * BLOCKS_PER_GROUP / threads);
   }
@@ -653,4 +647,64 @@ void VolumeWii::DecryptBlockData(const u8* in, u8* out, Common::AES::Context* ae
   aes_context->Crypt(&in[0x3d0], &in[sizeof(HashBlock)], out, BLOCK_DATA_SIZE);
 }
 
+void VolumeWii::EncryptBlocks(const HashBlock* hashes, const std::array<u8, BLOCK_DATA_SIZE>* data,
+                              u8* out, size_t count, const Common::AES::Context& aes_context)
+{
+  std::array<const u8*, BLOCKS_PER_GROUP> ivs;
+  std::array<const u8*, BLOCKS_PER_GROUP> in;
+  std::array<u8*, BLOCKS_PER_GROUP> out_ptrs;
+
+  while (count > 0)
+  {
+    const size_t batch = std::min<size_t>(count, BLOCKS_PER_GROUP);
+
+    // The hashes are encrypted with a zero IV
+    for (size_t i = 0; i < batch; ++i)
+    {
+      in[i] = reinterpret_cast<const u8*>(&hashes[i]);
+      out_ptrs[i] = out + i * BLOCK_TOTAL_SIZE;
+    }
+    aes_context.CryptMultiple(nullptr, in.data(), out_ptrs.data(), batch, BLOCK_HEADER_SIZE);
+
+    // The data is encrypted with an IV taken from the encrypted hashes
+    for (size_t i = 0; i < batch; ++i)
+    {
+      ivs[i] = out + i * BLOCK_TOTAL_SIZE + 0x3d0;
+      in[i] = data[i].data();
+      out_ptrs[i] = out + i * BLOCK_TOTAL_SIZE + BLOCK_HEADER_SIZE;
+    }
+    aes_context.CryptMultiple(ivs.data(), in.data(), out_ptrs.data(), batch, BLOCK_DATA_SIZE);
+
+    hashes += batch;
+    data += batch;
+    out += batch * BLOCK_TOTAL_SIZE;
+    count -= batch;
+  }
+}
+
+void VolumeWii::DecryptBlocksData(const u8* in, std::array<u8, BLOCK_DATA_SIZE>* out, size_t count,
+                                  const Common::AES::Context& aes_context)
+{
+  std::array<const u8*, BLOCKS_PER_GROUP> ivs;
+  std::array<const u8*, BLOCKS_PER_GROUP> in_ptrs;
+  std::array<u8*, BLOCKS_PER_GROUP> out_ptrs;
+
+  while (count > 0)
+  {
+    const size_t batch = std::min<size_t>(count, BLOCKS_PER_GROUP);
+
+    for (size_t i = 0; i < batch; ++i)
+    {
+      ivs[i] = in + i * BLOCK_TOTAL_SIZE + 0x3d0;
+      in_ptrs[i] = in + i * BLOCK_TOTAL_SIZE + BLOCK_HEADER_SIZE;
+      out_ptrs[i] = out[i].data();
+    }
+    aes_context.CryptMultiple(ivs.data(), in_ptrs.data(), out_ptrs.data(), batch, BLOCK_DATA_SIZE);
+
+    in += batch * BLOCK_TOTAL_SIZE;
+    out += batch;
+    count -= batch;
+  }
+}
+
 }  // namespace DiscIO
@@ -109,6 +109,13 @@ public:
   static void DecryptBlockHashes(const u8* in, HashBlock* out, Common::AES::Context* aes_context);
   static void DecryptBlockData(const u8* in, u8* out, Common::AES::Context* aes_context);
 
+  // Batched versions of the above for consecutive blocks, which let the AES implementation work
+  // on several blocks at once. in and out point to BLOCK_TOTAL_SIZE sized encrypted blocks.
+  static void EncryptBlocks(const HashBlock* hashes, const std::array<u8, BLOCK_DATA_SIZE>* data,
+                            u8* out, size_t count, const Common::AES::Context& aes_context);
+  static void DecryptBlocksData(const u8* in, std::array<u8, BLOCK_DATA_SIZE>* out, size_t count,
+                                const Common::AES::Context& aes_context);
+
 protected:
   u32 GetOffsetShift() const override { return 2; }
 
@@ -5,12 +5,15 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <filesystem>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -26,9 +29,11 @@
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
+#include "Common/StringUtil.h"
 #include "Common/Swap.h"
 
 #include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStore.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/LaggedFibonacciGenerator.h"
@@ -77,6 +82,13 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
   }
 }
 
+static std::atomic<u64> s_cache_size = 32 * 1024 * 1024;
+
+void SetWIARVZCacheSize(u64 bytes)
+{
+  s_cache_size.store(bytes, std::memory_order_relaxed);
+}
+
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
     : m_file(std::move(file)), m_path(path), m_encryption_cache(this)
@@ -85,7 +97,11 @@ WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& pa
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  for (size_t i = 0; i < m_decompression_thread_count; ++i)
+    m_decompression_threads[i].Shutdown(true);
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -116,8 +132,18 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
 
   if (Common::swap64(m_header_1.wia_file_size) != m_file.GetSize())
   {
-    ERROR_LOG_FMT(DISCIO, "File size is incorrect for {}", path);
-    return false;
+    std::optional<PackedInfo> packed_info = ReadPackedInfo(&m_file, path);
+    if (!packed_info)
+    {
+      ERROR_LOG_FMT(DISCIO, "File size is incorrect for {}", path);
+      return false;
+    }
+
+    if (!OpenChunkStore(std::move(*packed_info), path) ||
+        !m_file.Seek(sizeof(m_header_1), File::SeekOrigin::Begin))
+    {
+      return false;
+    }
   }
 
   const u32 header_2_size = Common::swap32(m_header_1.header_2_size);
@@ -206,7 +232,7 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
 
   const u32 number_of_raw_data_entries = Common::swap32(m_header_2.number_of_raw_data_entries);
   m_raw_data_entries.resize(number_of_raw_data_entries);
-  Chunk& raw_data_entries =
+  Chunk raw_data_entries =
       ReadCompressedData(Common::swap64(m_header_2.raw_data_entries_offset),
                          Common::swap32(m_header_2.raw_data_entries_size),
                          number_of_raw_data_entries * sizeof(RawDataEntry), m_compression_type);
@@ -223,7 +249,7 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
 
   const u32 number_of_group_entries = Common::swap32(m_header_2.number_of_group_entries);
   m_group_entries.resize(number_of_group_entries);
-  Chunk& group_entries =
+  Chunk group_entries =
       ReadCompressedData(Common::swap64(m_header_2.group_entries_offset),
                          Common::swap32(m_header_2.group_entries_size),
                          number_of_group_entries * sizeof(GroupEntry), m_compression_type);
@@ -233,9 +259,50 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
   if (HasDataOverlap())
     return false;
 
+  if (IsPacked())
+  {
+    for (const GroupEntry& group : m_group_entries)
+    {
+      if (GetGroupDataSize(group) != 0 && !m_store_offsets.contains(GetGroupOffsetInFile(group)))
+      {
+        ERROR_LOG_FMT(DISCIO, "Packed file {} refers to a group missing from its chunk store",
+                      path);
+        return false;
+      }
+    }
+  }
+
   return true;
 }
 
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::OpenChunkStore(PackedInfo info, const std::string& path)
+{
+  m_store_data_path = ChunkStore::GetDataPath(info.store_path);
+  if (!m_store_file.Open(m_store_data_path, "rb"))
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to open the chunk store {} used by {}", info.store_path, path);
+    return false;
+  }
+
+  m_packed_metadata_size = info.metadata_size;
+  m_store_offsets = std::move(info.refs);
+  return true;
+}
+
+template <bool RVZ>
+u64 WIARVZFileReader<RVZ>::GetGroupOffsetInFile(const GroupEntry& group) const
+{
+  return static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+}
+
+template <bool RVZ>
+u32 WIARVZFileReader<RVZ>::GetGroupDataSize(const GroupEntry& group) const
+{
+  const u32 data_size = Common::swap32(group.data_size);
+  return RVZ ? data_size & 0x7FFFFFFF : data_size;
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::HasDataOverlap() const
 {
@@ -500,6 +567,7 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   data_offset -= skipped_data;
   data_size += skipped_data;
 
+  const u64 full_chunk_size = chunk_size;
   const u64 start_group_index = (*offset - data_offset) / chunk_size;
   for (u64 i = start_group_index; i < number_of_groups && (*size) > 0; ++i)
   {
@@ -507,42 +575,40 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
 
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
 
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
+    // If the game is reading through the data sequentially, it will most likely want the next
+    // groups soon too, so start decompressing them in parallel
+    const bool sequential = m_last_group_index != std::numeric_limits<u64>::max() &&
+                            total_group_index == m_last_group_index + 1;
+    m_last_group_index = total_group_index;
 
-      group_data_size &= 0x7FFFFFFF;
+    const std::shared_ptr<CachedChunk> chunk = GetGroupChunk(
+        total_group_index, chunk_size, exception_lists, group_offset_in_data, false);
 
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
+    if (sequential)
+    {
+      PrefetchGroups(group_index, i + 1, number_of_groups, full_chunk_size, data_size,
+                     exception_lists);
     }
 
-    if (group_data_size == 0)
+    if (!chunk)
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+      WaitUntilReady(*chunk);
 
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
-
-      if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
+      if (!chunk->chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        const GroupEntry& group = m_group_entries[total_group_index];
+        RemoveFromCache(GetGroupOffsetInFile(group));
         return false;
       }
 
@@ -552,7 +618,7 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
         const u16 additional_offset =
             static_cast<u16>(group_offset_in_data % VolumeWii::GROUP_DATA_SIZE /
                              VolumeWii::BLOCK_DATA_SIZE * VolumeWii::BLOCK_HEADER_SIZE);
-        chunk.GetHashExceptions(&m_exception_list, exception_list_index, additional_offset);
+        chunk->chunk.GetHashExceptions(&m_exception_list, exception_list_index, additional_offset);
         m_exception_list_last_group_index = total_group_index;
       }
     }
@@ -565,16 +631,155 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+// Returns nullptr if the group contains only zeroes
+template <bool RVZ>
+std::shared_ptr<typename WIARVZFileReader<RVZ>::CachedChunk>
+WIARVZFileReader<RVZ>::GetGroupChunk(u64 total_group_index, u64 chunk_size, u32 exception_lists,
+                                     u64 group_offset_in_data, bool prefetch)
+{
+  const GroupEntry group = m_group_entries[total_group_index];
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  if (group_data_size == 0)
+    return nullptr;
+
+  const u64 group_offset_in_file = GetGroupOffsetInFile(group);
+
+  const auto it = m_chunk_cache_map.find(group_offset_in_file);
+  if (it != m_chunk_cache_map.end())
+  {
+    m_chunk_cache.splice(m_chunk_cache.begin(), m_chunk_cache, it->second);
+    return it->second->chunk;
+  }
+
+  // The groups of packed files are read from the chunk store. Initialize has made sure that all
+  // of them are in it.
+  const u64 group_offset =
+      IsPacked() ? m_store_offsets.find(group_offset_in_file)->second : group_offset_in_file;
+
+  auto chunk = std::make_shared<CachedChunk>();
+  chunk->chunk = ReadCompressedData(group_offset, group_data_size, chunk_size, compression_type,
+                                    exception_lists, rvz_packed_size, group_offset_in_data);
+  if (IsPacked())
+    chunk->chunk.SetFile(&m_store_file);
+  chunk->memory_usage = chunk->chunk.GetMemoryUsage();
+  chunk->ready = !prefetch;
+
+  InsertIntoCache(group_offset_in_file, chunk);
+
+  if (prefetch)
+  {
+    m_decompression_threads[m_next_decompression_thread].Push(chunk);
+    m_next_decompression_thread = (m_next_decompression_thread + 1) % m_decompression_thread_count;
+  }
+
+  return chunk;
+}
+
 template <bool RVZ>
-typename WIARVZFileReader<RVZ>::Chunk&
+void WIARVZFileReader<RVZ>::PrefetchGroups(u32 group_index, u64 first_group, u32 number_of_groups,
+                                           u64 chunk_size, u64 data_size, u32 exception_lists)
+{
+  if (!m_decompression_threads)
+    StartDecompressionThreads();
+
+  const u64 end_group = std::min<u64>(number_of_groups, first_group + m_decompression_thread_count);
+  for (u64 i = first_group; i < end_group; ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    const u64 group_offset_in_data = i * chunk_size;
+    if (total_group_index >= m_group_entries.size() || group_offset_in_data >= data_size)
+      return;
+
+    GetGroupChunk(total_group_index, std::min(chunk_size, data_size - group_offset_in_data),
+                  exception_lists, group_offset_in_data, true);
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::StartDecompressionThreads()
+{
+  m_decompression_thread_count =
+      std::clamp<size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+  m_decompression_threads =
+      std::make_unique<Common::WorkQueueThread<std::shared_ptr<CachedChunk>>[]>(
+          m_decompression_thread_count);
+
+  for (size_t i = 0; i < m_decompression_thread_count; ++i)
+  {
+    // Each thread needs a file handle of its own, since a duplicated handle would share the file
+    // position with m_file
+    auto file = std::make_shared<File::IOFile>(IsPacked() ? m_store_data_path : m_path, "rb");
+
+    m_decompression_threads[i].Reset(
+        "WIA/RVZ Decompression", [this, file](std::shared_ptr<CachedChunk> chunk) {
+          // If this fails, the reader thread will run into the same error when reading the chunk
+          chunk->chunk.SetFile(file.get());
+          chunk->chunk.DecompressAll();
+          chunk->chunk.SetFile(IsPacked() ? &m_store_file : &m_file);
+
+          {
+            std::lock_guard lk(m_chunk_ready_mutex);
+            chunk->ready = true;
+          }
+          m_chunk_ready_cond_var.notify_all();
+        });
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::WaitUntilReady(const CachedChunk& chunk)
+{
+  std::unique_lock lk(m_chunk_ready_mutex);
+  m_chunk_ready_cond_var.wait(lk, [&chunk] { return chunk.ready; });
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InsertIntoCache(u64 offset_in_file, std::shared_ptr<CachedChunk> chunk)
+{
+  m_chunk_cache_usage += chunk->memory_usage;
+  m_chunk_cache.push_front(CacheEntry{offset_in_file, std::move(chunk)});
+  m_chunk_cache_map.emplace(offset_in_file, m_chunk_cache.begin());
+
+  // Always keep the most recently used chunk, since the caller is about to use it.
+  // Evicting a chunk that a decompression thread is working on is fine, since the thread holds
+  // its own reference to it.
+  const u64 cache_size = s_cache_size.load(std::memory_order_relaxed);
+  while (m_chunk_cache_usage > cache_size && m_chunk_cache.size() > 1)
+    RemoveFromCache(m_chunk_cache.back().offset_in_file);
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::RemoveFromCache(u64 offset_in_file)
+{
+  const auto it = m_chunk_cache_map.find(offset_in_file);
+  if (it == m_chunk_cache_map.end())
+    return;
+
+  m_chunk_cache_usage -= it->second->chunk->memory_usage;
+  m_chunk_cache.erase(it->second);
+  m_chunk_cache_map.erase(it);
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
                                           u64 decompressed_size,
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
-
   std::unique_ptr<Decompressor> decompressor;
   switch (compression_type)
   {
@@ -603,11 +808,8 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
 
   const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  return Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
+               compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
 }
 
 template <bool RVZ>
@@ -651,16 +853,29 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 {
-  if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
-  {
+  if (!DecompressUpTo(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  return DecompressUpTo(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUpTo(u64 end)
+{
+  if (!m_decompressor || !m_file || end > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
     return false;
-  }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  while (end > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -673,7 +888,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -753,7 +968,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1387,19 +1601,11 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
         const u64 blocks_in_this_group =
             std::min<u64>(VolumeWii::BLOCKS_PER_GROUP, blocks - i * VolumeWii::BLOCKS_PER_GROUP);
 
-        for (u32 j = 0; j < VolumeWii::BLOCKS_PER_GROUP; ++j)
-        {
-          if (j < blocks_in_this_group)
-          {
-            const u64 offset_of_block = offset_of_group + j * VolumeWii::BLOCK_TOTAL_SIZE;
-            VolumeWii::DecryptBlockData(parameters.data.data() + offset_of_block,
-                                        state->decryption_buffer[j].data(), aes_context.get());
-          }
-          else
-          {
-            state->decryption_buffer[j].fill(0);
-          }
-        }
+        VolumeWii::DecryptBlocksData(parameters.data.data() + offset_of_group,
+                                     state->decryption_buffer.data(), blocks_in_this_group,
+                                     *aes_context);
+        for (u64 j = blocks_in_this_group; j < VolumeWii::BLOCKS_PER_GROUP; ++j)
+          state->decryption_buffer[j].fill(0);
 
         VolumeWii::HashGroup(state->decryption_buffer.data(), state->hash_buffer.data());
 
@@ -2031,6 +2237,119 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   return ConversionResultCode::Success;
 }
 
+template <bool RVZ>
+ConversionResultCode WIARVZFileReader<RVZ>::Pack(File::IOFile* outfile,
+                                                 const std::string& outfile_path,
+                                                 ChunkStore* store, const std::string& store_path)
+{
+  if (IsPacked())
+    return ConversionResultCode::InternalError;
+
+  // Everything in front of the first group is kept in the packed file
+  u64 metadata_size = m_file.GetSize();
+  for (const GroupEntry& group : m_group_entries)
+  {
+    if (GetGroupDataSize(group) != 0)
+      metadata_size = std::min(metadata_size, GetGroupOffsetInFile(group));
+  }
+
+  const u64 partition_entries_end =
+      Common::swap64(m_header_2.partition_entries_offset) +
+      static_cast<u64>(Common::swap32(m_header_2.partition_entry_size)) *
+          Common::swap32(m_header_2.number_of_partition_entries);
+  const u64 raw_data_entries_end = Common::swap64(m_header_2.raw_data_entries_offset) +
+                                   Common::swap32(m_header_2.raw_data_entries_size);
+  const u64 group_entries_end = Common::swap64(m_header_2.group_entries_offset) +
+                                Common::swap32(m_header_2.group_entries_size);
+  if (std::max({partition_entries_end, raw_data_entries_end, group_entries_end}) > metadata_size)
+  {
+    ERROR_LOG_FMT(DISCIO, "Unable to pack {}, since its headers are not in front of its groups",
+                  m_path);
+    return ConversionResultCode::InternalError;
+  }
+
+  std::vector<u8> buffer(metadata_size);
+  if (!m_file.Seek(0, File::SeekOrigin::Begin) || !m_file.ReadBytes(buffer.data(), buffer.size()))
+    return ConversionResultCode::ReadFailed;
+  if (!outfile->WriteBytes(buffer.data(), buffer.size()))
+    return ConversionResultCode::WriteFailed;
+
+  PackedInfo info{store_path, metadata_size, {}};
+  for (const GroupEntry& group : m_group_entries)
+  {
+    const u64 offset_in_file = GetGroupOffsetInFile(group);
+    const u32 data_size = GetGroupDataSize(group);
+    if (data_size == 0 || info.refs.contains(offset_in_file))
+      continue;
+
+    buffer.resize(data_size);
+    if (!m_file.Seek(offset_in_file, File::SeekOrigin::Begin) ||
+        !m_file.ReadBytes(buffer.data(), buffer.size()))
+    {
+      return ConversionResultCode::ReadFailed;
+    }
+
+    const std::optional<u64> offset_in_store = store->Add(buffer.data(), data_size);
+    if (!offset_in_store)
+      return ConversionResultCode::WriteFailed;
+    info.refs.emplace(offset_in_file, *offset_in_store);
+  }
+
+  if (!store->Flush() || !WritePackedInfo(outfile, outfile_path, info))
+    return ConversionResultCode::WriteFailed;
+
+  return ConversionResultCode::Success;
+}
+
+template <bool RVZ>
+ConversionResultCode WIARVZFileReader<RVZ>::Unpack(File::IOFile* outfile)
+{
+  if (!IsPacked())
+    return ConversionResultCode::InternalError;
+
+  std::vector<u8> buffer(m_packed_metadata_size);
+  if (!m_file.Seek(0, File::SeekOrigin::Begin) || !m_file.ReadBytes(buffer.data(), buffer.size()))
+    return ConversionResultCode::ReadFailed;
+  if (!outfile->WriteBytes(buffer.data(), buffer.size()))
+    return ConversionResultCode::WriteFailed;
+
+  // Groups can be shared by several group entries, and must be written in order of their offsets
+  std::map<u64, u32> groups;
+  for (const GroupEntry& group : m_group_entries)
+  {
+    if (GetGroupDataSize(group) != 0)
+      groups.emplace(GetGroupOffsetInFile(group), GetGroupDataSize(group));
+  }
+
+  u64 position = m_packed_metadata_size;
+  for (const auto& [offset_in_file, data_size] : groups)
+  {
+    // The gaps between groups are the zero padding written by PadTo4
+    if (offset_in_file < position)
+      return ConversionResultCode::InternalError;
+    buffer.assign(offset_in_file - position, 0);
+    if (!outfile->WriteBytes(buffer.data(), buffer.size()))
+      return ConversionResultCode::WriteFailed;
+
+    buffer.resize(data_size);
+    if (!m_store_file.Seek(m_store_offsets.find(offset_in_file)->second,
+                           File::SeekOrigin::Begin) ||
+        !m_store_file.ReadBytes(buffer.data(), buffer.size()))
+    {
+      return ConversionResultCode::ReadFailed;
+    }
+    if (!outfile->WriteBytes(buffer.data(), buffer.size()))
+      return ConversionResultCode::WriteFailed;
+
+    position = offset_in_file + data_size;
+  }
+
+  if (!outfile->Resize(Common::swap64(m_header_1.wia_file_size)))
+    return ConversionResultCode::WriteFailed;
+
+  return ConversionResultCode::Success;
+}
+
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
@@ -2074,6 +2393,67 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   return result == ConversionResultCode::Success;
 }
 
+template <typename Function>
+static bool PackOrUnpack(const std::string& infile_path, const std::string& outfile_path,
+                         Function function)
+{
+  const std::unique_ptr<BlobReader> infile = CreateBlobReader(infile_path);
+  if (!infile ||
+      (infile->GetBlobType() != BlobType::WIA && infile->GetBlobType() != BlobType::RVZ))
+  {
+    ERROR_LOG_FMT(DISCIO, "{} is not a WIA or RVZ file", infile_path);
+    return false;
+  }
+
+  // Opening the output file would truncate the input file if they were the same
+  std::error_code error;
+  if (std::filesystem::equivalent(StringToPath(infile_path), StringToPath(outfile_path), error))
+  {
+    ERROR_LOG_FMT(DISCIO, "{} can't be both the input and the output", infile_path);
+    return false;
+  }
+
+  File::IOFile outfile(outfile_path, "wb");
+  if (!outfile)
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to open the output file {}", outfile_path);
+    return false;
+  }
+
+  ConversionResultCode result;
+  if (infile->GetBlobType() == BlobType::RVZ)
+    result = function(static_cast<RVZFileReader*>(infile.get()), &outfile);
+  else
+    result = function(static_cast<WIAFileReader*>(infile.get()), &outfile);
+
+  if (result != ConversionResultCode::Success)
+  {
+    // Remove the incomplete output file
+    outfile.Close();
+    File::Delete(outfile_path);
+  }
+
+  return result == ConversionResultCode::Success;
+}
+
+bool PackWIAOrRVZ(const std::string& infile_path, const std::string& outfile_path,
+                  const std::string& store_path)
+{
+  const std::unique_ptr<ChunkStore> store = ChunkStore::Open(store_path);
+  if (!store)
+    return false;
+
+  return PackOrUnpack(infile_path, outfile_path, [&](auto* reader, File::IOFile* outfile) {
+    return reader->Pack(outfile, outfile_path, store.get(), store_path);
+  });
+}
+
+bool UnpackWIAOrRVZ(const std::string& infile_path, const std::string& outfile_path)
+{
+  return PackOrUnpack(infile_path, outfile_path,
+                      [](auto* reader, File::IOFile* outfile) { return reader->Unpack(outfile); });
+}
+
 template class WIARVZFileReader<false>;
 template class WIARVZFileReader<true>;
 
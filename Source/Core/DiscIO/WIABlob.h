@@ -4,7 +4,9 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -15,7 +17,9 @@
 #include "Common/Crypto/SHA1.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStore.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
 #include "DiscIO/WiiEncryptionCache.h"
@@ -37,6 +41,17 @@ enum class WIARVZCompressionType : u32
 
 std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compression_type, bool gui);
 
+// Sets how many bytes of decompressed groups each WIA/RVZ reader may keep cached.
+void SetWIARVZCacheSize(u64 bytes);
+
+// Writes a copy of a WIA/RVZ file which refers to groups in a ChunkStore instead of containing
+// them, adding any groups that the store doesn't have yet. The packed file can be read like any
+// other WIA/RVZ file as long as the store is available.
+bool PackWIAOrRVZ(const std::string& infile_path, const std::string& outfile_path,
+                  const std::string& store_path);
+// Turns a packed WIA/RVZ file back into a regular one
+bool UnpackWIAOrRVZ(const std::string& infile_path, const std::string& outfile_path);
+
 constexpr u32 WIA_MAGIC = 0x01414957;  // "WIA\x1" (byteswapped to little endian)
 constexpr u32 RVZ_MAGIC = 0x015A5652;  // "RVZ\x1" (byteswapped to little endian)
 
@@ -71,6 +86,11 @@ public:
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
                                       int compression_level, int chunk_size, CompressCB callback);
 
+  bool IsPacked() const { return m_store_file.IsOpen(); }
+  ConversionResultCode Pack(File::IOFile* outfile, const std::string& outfile_path,
+                            ChunkStore* store, const std::string& store_path);
+  ConversionResultCode Unpack(File::IOFile* outfile);
+
 private:
   using WiiKey = std::array<u8, 16>;
 
@@ -194,6 +214,12 @@ private:
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Decompresses everything up front, so that later reads don't need to access the file
+    bool DecompressAll();
+
+    void SetFile(File::IOFile* file) { m_file = file; }
+    size_t GetMemoryUsage() const { return m_in.data.size() + m_out.data.size(); }
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -205,6 +231,7 @@ private:
     }
 
   private:
+    bool DecompressUpTo(u64 end);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -228,18 +255,44 @@ private:
     u64 m_data_offset = 0;
   };
 
+  struct CachedChunk
+  {
+    Chunk chunk;
+    // False while a decompression thread is working on the chunk
+    bool ready = false;
+    size_t memory_usage = 0;
+  };
+
+  struct CacheEntry
+  {
+    u64 offset_in_file;
+    std::shared_ptr<CachedChunk> chunk;
+  };
+
   explicit WIARVZFileReader(File::IOFile file, const std::string& path);
   bool Initialize(const std::string& path);
   bool HasDataOverlap() const;
+  bool OpenChunkStore(PackedInfo info, const std::string& path);
+  u64 GetGroupOffsetInFile(const GroupEntry& group) const;
+  u32 GetGroupDataSize(const GroupEntry& group) const;
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
 
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
-  Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
-                            WIARVZCompressionType compression_type, u32 exception_lists = 0,
-                            u32 rvz_packed_size = 0, u64 data_offset = 0);
+  std::shared_ptr<CachedChunk> GetGroupChunk(u64 total_group_index, u64 chunk_size,
+                                             u32 exception_lists, u64 group_offset_in_data,
+                                             bool prefetch);
+  void PrefetchGroups(u32 group_index, u64 first_group, u32 number_of_groups, u64 chunk_size,
+                      u64 data_size, u32 exception_lists);
+  void InsertIntoCache(u64 offset_in_file, std::shared_ptr<CachedChunk> chunk);
+  void RemoveFromCache(u64 offset_in_file);
+  void WaitUntilReady(const CachedChunk& chunk);
+  void StartDecompressionThreads();
+  Chunk ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
+                           WIARVZCompressionType compression_type, u32 exception_lists = 0,
+                           u32 rvz_packed_size = 0, u64 data_offset = 0);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -367,8 +420,27 @@ private:
 
   File::IOFile m_file;
   std::string m_path;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+
+  // Only used for packed files, whose groups are stored in a ChunkStore
+  File::IOFile m_store_file;
+  std::string m_store_data_path;
+  u64 m_packed_metadata_size = 0;
+  std::map<u64, u64> m_store_offsets;
+
+  // Decompressed groups, most recently used first. Groups following a sequential read are
+  // decompressed ahead of time on the decompression threads.
+  std::list<CacheEntry> m_chunk_cache;
+  std::map<u64, typename std::list<CacheEntry>::iterator> m_chunk_cache_map;
+  size_t m_chunk_cache_usage = 0;
+  u64 m_last_group_index = std::numeric_limits<u64>::max();
+  std::mutex m_chunk_ready_mutex;
+  std::condition_variable m_chunk_ready_cond_var;
+
+  // We can't use std::vector for this, because WorkQueueThread is not movable
+  std::unique_ptr<Common::WorkQueueThread<std::shared_ptr<CachedChunk>>[]> m_decompression_threads;
+  size_t m_decompression_thread_count = 0;
+  size_t m_next_decompression_thread = 0;
+
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
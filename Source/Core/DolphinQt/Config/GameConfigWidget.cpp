@@ -28,11 +28,13 @@ constexpr int DETERMINISM_NOT_SET_INDEX = 0;
 constexpr int DETERMINISM_AUTO_INDEX = 1;
 constexpr int DETERMINISM_NONE_INDEX = 2;
 constexpr int DETERMINISM_FAKE_COMPLETION_INDEX = 3;
+constexpr int DETERMINISM_OBSERVABLE_SYNC_INDEX = 4;
 
 constexpr const char* DETERMINISM_NOT_SET_STRING = "";
 constexpr const char* DETERMINISM_AUTO_STRING = "auto";
 constexpr const char* DETERMINISM_NONE_STRING = "none";
 constexpr const char* DETERMINISM_FAKE_COMPLETION_STRING = "fake-completion";
+constexpr const char* DETERMINISM_OBSERVABLE_SYNC_STRING = "observable-sync";
 
 static void PopulateTab(QTabWidget* tab, const std::string& path, std::string& game_id,
                         u16 revision, bool read_only)
@@ -93,7 +95,8 @@ void GameConfigWidget::CreateWidgets()
   m_manual_texture_sampling = new QCheckBox(tr("Manual Texture Sampling"));
   m_deterministic_dual_core = new QComboBox;
 
-  for (const auto& item : {tr("Not Set"), tr("auto"), tr("none"), tr("fake-completion")})
+  for (const auto& item : {tr("Not Set"), tr("auto"), tr("none"), tr("fake-completion"),
+                           tr("observable-sync")})
     m_deterministic_dual_core->addItem(item);
 
   m_enable_mmu->setToolTip(tr(
@@ -302,6 +305,10 @@ void GameConfigWidget::LoadSettings()
   {
     determinism_index = DETERMINISM_FAKE_COMPLETION_INDEX;
   }
+  else if (determinism_mode == DETERMINISM_OBSERVABLE_SYNC_STRING)
+  {
+    determinism_index = DETERMINISM_OBSERVABLE_SYNC_INDEX;
+  }
 
   m_deterministic_dual_core->setCurrentIndex(determinism_index);
 
@@ -349,6 +356,9 @@ void GameConfigWidget::SaveSettings()
   case DETERMINISM_FAKE_COMPLETION_INDEX:
     determinism_mode = DETERMINISM_FAKE_COMPLETION_STRING;
     break;
+  case DETERMINISM_OBSERVABLE_SYNC_INDEX:
+    determinism_mode = DETERMINISM_OBSERVABLE_SYNC_STRING;
+    break;
   }
 
   if (determinism_mode != DETERMINISM_NOT_SET_STRING)
@@ -65,6 +65,7 @@ void AdvancedWidget::CreateWidgets()
   m_show_graphs = new ConfigBool(tr("Show Performance Graphs"), Config::GFX_SHOW_GRAPHS);
   m_show_speed = new ConfigBool(tr("Show % Speed"), Config::GFX_SHOW_SPEED);
   m_show_speed_colors = new ConfigBool(tr("Show Speed Colors"), Config::GFX_SHOW_SPEED_COLORS);
+  m_show_audio_stats = new ConfigBool(tr("Show Audio Statistics"), Config::GFX_SHOW_AUDIO_STATS);
   m_perf_samp_window = new ConfigInteger(0, 10000, Config::GFX_PERF_SAMP_WINDOW, 100);
   m_perf_samp_window->SetTitle(tr("Performance Sample Window (ms)"));
   m_log_render_time =
@@ -80,6 +81,7 @@ void AdvancedWidget::CreateWidgets()
   performance_layout->addWidget(m_perf_samp_window, 3, 1);
   performance_layout->addWidget(m_log_render_time, 4, 0);
   performance_layout->addWidget(m_show_speed_colors, 4, 1);
+  performance_layout->addWidget(m_show_audio_stats, 5, 0);
 
   // Debugging
   auto* debugging_box = new QGroupBox(tr("Debugging"));
@@ -395,6 +397,12 @@ void AdvancedWidget::AddDescriptions()
       QT_TR_NOOP("Changes the color of the FPS counter depending on emulation speed."
                  "<br><br><dolphin_emphasis>If unsure, leave this "
                  "checked.</dolphin_emphasis>");
+  static const char TR_SHOW_AUDIO_STATS_DESCRIPTION[] =
+      QT_TR_NOOP("Shows how long it took to mix the audio for 50% and 99% of the buffers the "
+                 "audio backend requested, the estimated audio latency and how often the audio "
+                 "ran out of samples. If the mixing times approach the length of a buffer, the "
+                 "audio latency can't be lowered without crackling.<br><br><dolphin_emphasis>If "
+                 "unsure, leave this unchecked.</dolphin_emphasis>");
   static const char TR_PERF_SAMP_WINDOW_DESCRIPTION[] =
       QT_TR_NOOP("The amount of time the FPS and VPS counters will sample over."
                  "<br><br>The higher the value, the more stable the FPS/VPS counter will be, "
@@ -572,6 +580,7 @@ void AdvancedWidget::AddDescriptions()
   m_show_speed->SetDescription(tr(TR_SHOW_SPEED_DESCRIPTION));
   m_log_render_time->SetDescription(tr(TR_LOG_RENDERTIME_DESCRIPTION));
   m_show_speed_colors->SetDescription(tr(TR_SHOW_SPEED_COLORS_DESCRIPTION));
+  m_show_audio_stats->SetDescription(tr(TR_SHOW_AUDIO_STATS_DESCRIPTION));
 
   m_enable_wireframe->SetDescription(tr(TR_WIREFRAME_DESCRIPTION));
   m_show_statistics->SetDescription(tr(TR_SHOW_STATS_DESCRIPTION));
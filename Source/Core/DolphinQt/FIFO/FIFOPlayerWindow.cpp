@@ -308,7 +308,7 @@ void FIFOPlayerWindow::UpdateInfo()
     {
       fifo_bytes += file->GetFrame(i).fifoData.size();
       for (const auto& mem_update : file->GetFrame(i).memoryUpdates)
-        mem_bytes += mem_update.data.size();
+        mem_bytes += mem_update.data->size();
     }
 
     m_info_label->setText(tr("%1 FIFO bytes\n%2 memory bytes\n%3 frames")
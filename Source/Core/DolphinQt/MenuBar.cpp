@@ -392,6 +392,7 @@ void MenuBar::AddStateLoadMenu(QMenu* emu_menu)
 void MenuBar::AddStateSaveMenu(QMenu* emu_menu)
 {
   m_state_save_menu = emu_menu->addMenu(tr("Sa&ve State"));
+  m_state_save_menu->setToolTipsVisible(true);
   m_state_save_menu->addAction(tr("Save State to File"), this, &MenuBar::StateSave);
   m_state_save_menu->addAction(tr("Save State to Selected Slot"), this, &MenuBar::StateSaveSlot);
   m_state_save_menu->addAction(tr("Save State to Oldest Slot"), this, &MenuBar::StateSaveOldest);
@@ -404,6 +405,20 @@ void MenuBar::AddStateSaveMenu(QMenu* emu_menu)
 
     connect(action, &QAction::triggered, this, [=, this]() { emit StateSaveSlotAt(i); });
   }
+
+  m_state_save_menu->addSeparator();
+
+  // Only the slots are saved as deltas, since a delta is useless without the states it builds on
+  auto* save_deltas = m_state_save_menu->addAction(tr("Save Slots as Deltas"));
+  save_deltas->setCheckable(true);
+  save_deltas->setChecked(Config::Get(Config::MAIN_SAVE_STATE_DELTAS));
+  save_deltas->setToolTip(
+      tr("Saves each slot as the differences to a slot saved before it, which takes less space. "
+         "Slots that build on a slot being overwritten are saved in full first, but deleting, "
+         "moving or replacing slot files outside of Dolphin makes the slots that build on them "
+         "unloadable."));
+  connect(save_deltas, &QAction::toggled, this,
+          [](bool value) { Config::SetBase(Config::MAIN_SAVE_STATE_DELTAS, value); });
 }
 
 void MenuBar::AddStateSlotMenu(QMenu* emu_menu)
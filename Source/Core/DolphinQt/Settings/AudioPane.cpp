@@ -94,6 +94,12 @@ void AudioPane::CreateWidgets()
            "crackling. Certain backends only."));
   }
 
+  m_low_latency = new QCheckBox(tr("Adaptive Low Latency"));
+  m_low_latency->setToolTip(
+      tr("Keeps as little audio buffered as the timing of emulation and of the audio backend "
+         "allows, and uses smaller buffers in the Cubeb, PulseAudio and ALSA backends and in the "
+         "DPLII decoder. The buffer grows again when the audio crackles."));
+
   m_dolby_pro_logic->setToolTip(
       tr("Enables Dolby Pro Logic II emulation using 5.1 surround. Certain backends only."));
 
@@ -114,7 +120,7 @@ void AudioPane::CreateWidgets()
   m_dolby_quality_highest_label =
       new QLabel(GetDPL2QualityLabel(AudioCommon::DPL2Quality::Highest));
   m_dolby_quality_latency_label =
-      new QLabel(GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality::Highest));
+      new QLabel(GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality::Highest, false));
 
   dolby_quality_layout->addWidget(m_dolby_quality_low_label);
   dolby_quality_layout->addWidget(m_dolby_quality_slider);
@@ -125,6 +131,7 @@ void AudioPane::CreateWidgets()
   backend_layout->addRow(m_backend_label, m_backend_combo);
   if (m_latency_control_supported)
     backend_layout->addRow(m_latency_label, m_latency_spin);
+  backend_layout->addRow(m_low_latency);
 
 #ifdef _WIN32
   m_wasapi_device_label = new QLabel(tr("Device:"));
@@ -181,6 +188,8 @@ void AudioPane::ConnectWidgets()
   {
     connect(m_latency_spin, &QSpinBox::valueChanged, this, &AudioPane::SaveSettings);
   }
+  connect(m_low_latency, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
+  connect(m_low_latency, &QCheckBox::toggled, this, &AudioPane::UpdateDPL2ApproximateLatencyLabel);
   connect(m_stretching_buffer_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
   connect(m_dolby_pro_logic, &QCheckBox::toggled, this, &AudioPane::SaveSettings);
   connect(m_dolby_quality_slider, &QSlider::valueChanged, this, &AudioPane::SaveSettings);
@@ -229,20 +238,20 @@ void AudioPane::LoadSettings()
   // Volume
   OnVolumeChanged(settings.GetVolume());
 
+  // Latency
+  if (m_latency_control_supported)
+    m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
+  m_low_latency->setChecked(Config::Get(Config::MAIN_AUDIO_LOW_LATENCY));
+
   // DPL2
   m_dolby_pro_logic->setChecked(Config::Get(Config::MAIN_DPL2_DECODER));
   m_dolby_quality_slider->setValue(int(Config::Get(Config::MAIN_DPL2_QUALITY)));
-  m_dolby_quality_latency_label->setText(
-      GetDPL2ApproximateLatencyLabel(Config::Get(Config::MAIN_DPL2_QUALITY)));
+  UpdateDPL2ApproximateLatencyLabel();
   if (AudioCommon::SupportsDPL2Decoder(current) && !m_dsp_hle->isChecked())
   {
     EnableDolbyQualityWidgets(m_dolby_pro_logic->isChecked());
   }
 
-  // Latency
-  if (m_latency_control_supported)
-    m_latency_spin->setValue(Config::Get(Config::MAIN_AUDIO_LATENCY));
-
   // Stretch
   m_stretching_enable->setChecked(Config::Get(Config::MAIN_AUDIO_STRETCH));
   m_stretching_buffer_label->setEnabled(m_stretching_enable->isChecked());
@@ -300,8 +309,7 @@ void AudioPane::SaveSettings()
   Config::SetBaseOrCurrent(Config::MAIN_DPL2_DECODER, m_dolby_pro_logic->isChecked());
   Config::SetBase(Config::MAIN_DPL2_QUALITY,
                   static_cast<AudioCommon::DPL2Quality>(m_dolby_quality_slider->value()));
-  m_dolby_quality_latency_label->setText(
-      GetDPL2ApproximateLatencyLabel(Config::Get(Config::MAIN_DPL2_QUALITY)));
+  UpdateDPL2ApproximateLatencyLabel();
   if (AudioCommon::SupportsDPL2Decoder(backend) && !m_dsp_hle->isChecked())
   {
     EnableDolbyQualityWidgets(m_dolby_pro_logic->isChecked());
@@ -310,6 +318,7 @@ void AudioPane::SaveSettings()
   // Latency
   if (m_latency_control_supported)
     Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LATENCY, m_latency_spin->value());
+  Config::SetBaseOrCurrent(Config::MAIN_AUDIO_LOW_LATENCY, m_low_latency->isChecked());
 
   // Stretch
   Config::SetBaseOrCurrent(Config::MAIN_AUDIO_STRETCH, m_stretching_enable->isChecked());
@@ -394,6 +403,7 @@ void AudioPane::OnEmulationStateChanged(bool running)
     m_latency_label->setEnabled(!running);
     m_latency_spin->setEnabled(!running);
   }
+  m_low_latency->setEnabled(!running);
 
 #ifdef _WIN32
   m_wasapi_device_combo->setEnabled(!running);
@@ -428,19 +438,38 @@ QString AudioPane::GetDPL2QualityLabel(AudioCommon::DPL2Quality value) const
   }
 }
 
-QString AudioPane::GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value) const
+QString AudioPane::GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value,
+                                                  bool low_latency) const
 {
+  int latency_ms;
   switch (value)
   {
   case AudioCommon::DPL2Quality::Lowest:
-    return tr("Latency: ~10 ms");
+    latency_ms = 10;
+    break;
   case AudioCommon::DPL2Quality::Low:
-    return tr("Latency: ~20 ms");
+    latency_ms = 20;
+    break;
   case AudioCommon::DPL2Quality::Highest:
-    return tr("Latency: ~80 ms");
+    latency_ms = 80;
+    break;
   default:
-    return tr("Latency: ~40 ms");
+    latency_ms = 40;
+    break;
   }
+
+  // The decoder uses blocks of half the size in low latency mode
+  if (low_latency)
+    latency_ms /= 2;
+
+  return tr("Latency: ~%1 ms").arg(latency_ms);
+}
+
+void AudioPane::UpdateDPL2ApproximateLatencyLabel() const
+{
+  m_dolby_quality_latency_label->setText(GetDPL2ApproximateLatencyLabel(
+      static_cast<AudioCommon::DPL2Quality>(m_dolby_quality_slider->value()),
+      m_low_latency->isChecked()));
 }
 
 void AudioPane::EnableDolbyQualityWidgets(bool enabled) const
@@ -41,7 +41,8 @@ private:
   bool m_latency_control_supported;
 
   QString GetDPL2QualityLabel(AudioCommon::DPL2Quality value) const;
-  QString GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value) const;
+  QString GetDPL2ApproximateLatencyLabel(AudioCommon::DPL2Quality value, bool low_latency) const;
+  void UpdateDPL2ApproximateLatencyLabel() const;
   void EnableDolbyQualityWidgets(bool enabled) const;
 
   QHBoxLayout* m_main_layout;
@@ -66,6 +67,7 @@ private:
   QLabel* m_dolby_quality_latency_label;
   QLabel* m_latency_label;
   QSpinBox* m_latency_spin;
+  QCheckBox* m_low_latency;
 #ifdef _WIN32
   QLabel* m_wasapi_device_label;
   QComboBox* m_wasapi_device_combo;
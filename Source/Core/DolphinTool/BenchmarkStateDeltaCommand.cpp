@@ -0,0 +1,117 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/BenchmarkStateDeltaCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+#include <lz4.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Timer.h"
+#include "Core/State.h"
+#include "Core/StateDelta.h"
+
+namespace DolphinTool
+{
+// Compresses <data> the way savestates are written, and returns the compressed size
+static std::optional<u64> CompressLZ4(std::span<const u8> data, std::vector<char>* buffer)
+{
+  if (data.size() > LZ4_MAX_INPUT_SIZE)
+    return std::nullopt;
+
+  const int size = static_cast<int>(data.size());
+  buffer->resize(LZ4_compressBound(size));
+  const int compressed_size =
+      LZ4_compress_default(reinterpret_cast<const char*>(data.data()), buffer->data(), size,
+                           static_cast<int>(buffer->size()));
+  if (compressed_size == 0 && size != 0)
+    return std::nullopt;
+
+  return compressed_size;
+}
+
+int BenchmarkStateDeltaCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: benchmark-state-delta [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("append")
+      .help("Path to savestate FILE. Give the states of one game in the order they were saved, "
+            "and each is saved once as a full state and once as part of a delta chain.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  State::DeltaChain chain;
+  std::vector<u8> delta;
+  std::vector<char> compressed;
+  u64 total_full_size = 0;
+  u64 total_full_us = 0;
+  u64 total_delta_size = 0;
+  u64 total_delta_us = 0;
+
+  for (const std::string& input_file_path : options.all("input"))
+  {
+    std::vector<u8> state;
+    if (!State::ReadStateData(input_file_path, &state))
+    {
+      fmt::print(std::cerr, "Error: Unable to read savestate {}\n", input_file_path);
+      return EXIT_FAILURE;
+    }
+
+    u64 start_us = Common::Timer::NowUs();
+    const std::optional<u64> full_size = CompressLZ4(state, &compressed);
+    const u64 full_us = Common::Timer::NowUs() - start_us;
+
+    // Includes the hashing and diffing that a delta state needs on top of the compression
+    start_us = Common::Timer::NowUs();
+    const bool is_delta = chain.Add(input_file_path, state, &delta).has_value();
+    const std::span<const u8> payload = is_delta ? std::span<const u8>(delta) : state;
+    const std::optional<u64> delta_size = CompressLZ4(payload, &compressed);
+    const u64 delta_us = Common::Timer::NowUs() - start_us;
+
+    if (!full_size || !delta_size)
+    {
+      fmt::print(std::cerr, "Error: Failed to compress {}\n", input_file_path);
+      return EXIT_FAILURE;
+    }
+
+    fmt::print(std::cout, "{} ({} bytes)\n", input_file_path, state.size());
+    fmt::print(std::cout, "  Full: {} bytes in {} us\n", *full_size, full_us);
+    fmt::print(std::cout, "  {}: {} bytes in {} us\n", is_delta ? "Delta" : "Keyframe",
+               *delta_size, delta_us);
+
+    total_full_size += *full_size;
+    total_full_us += full_us;
+    total_delta_size += *delta_size;
+    total_delta_us += delta_us;
+  }
+
+  fmt::print(std::cout, "Total\n");
+  fmt::print(std::cout, "  Full: {} bytes in {} us\n", total_full_size, total_full_us);
+  fmt::print(std::cout, "  Delta chain: {} bytes in {} us ({:.1f}% of the size)\n",
+             total_delta_size, total_delta_us,
+             100.0 * total_delta_size / std::max<u64>(total_full_size, 1));
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
@@ -3,20 +3,35 @@
 
 #include "DolphinTool/ConvertCommand.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <future>
 #include <iostream>
 #include <limits>
+#include <list>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include <OptionParser.h>
 #include <fmt/format.h>
 #include <fmt/ostream.h>
+#include <picojson.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileSearch.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
+#include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/ScrubbedBlob.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/VolumeDisc.h"
@@ -25,6 +40,18 @@
 
 namespace DolphinTool
 {
+namespace
+{
+struct ConversionSettings
+{
+  DiscIO::BlobType format;
+  bool scrub;
+  std::optional<int> block_size;
+  std::optional<DiscIO::WIARVZCompressionType> compression;
+  std::optional<int> compression_level;
+};
+}  // namespace
+
 static std::optional<DiscIO::WIARVZCompressionType>
 ParseCompressionTypeString(const std::string& compression_str)
 {
@@ -56,6 +83,278 @@ static std::optional<DiscIO::BlobType> ParseFormatString(const std::string& form
   return std::nullopt;
 }
 
+static std::string GetFormatExtension(DiscIO::BlobType format)
+{
+  switch (format)
+  {
+  case DiscIO::BlobType::GCZ:
+    return ".gcz";
+  case DiscIO::BlobType::WIA:
+    return ".wia";
+  case DiscIO::BlobType::RVZ:
+    return ".rvz";
+  default:
+    return ".iso";
+  }
+}
+
+// Prints a message about the file being converted. Messages are prefixed with the name of their
+// input file when several files are converted at once, so that they can be told apart.
+static void PrintMessage(std::string_view prefix, std::string_view message)
+{
+  static std::mutex s_mutex;
+  std::lock_guard lk(s_mutex);
+  fmt::print(std::cerr, "{}{}", prefix, message);
+}
+
+// Converts a single file. Everything that depends on the contents of the input file is checked
+// here, while the options themselves are validated once in ConvertCommand.
+static bool ConvertFile(const std::string& input_file_path, const std::string& output_file_path,
+                        const ConversionSettings& settings, std::string_view message_prefix,
+                        u64* data_size)
+{
+  const DiscIO::BlobType format = settings.format;
+  const bool scrub = settings.scrub;
+
+  // Open the blob reader
+  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
+  if (!blob_reader)
+  {
+    PrintMessage(message_prefix, "Error: The input file could not be opened.\n");
+    return false;
+  }
+  *data_size = blob_reader->GetDataSize();
+
+  // Open the volume
+  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
+  if (!volume)
+  {
+    if (scrub)
+    {
+      PrintMessage(message_prefix, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
+      return false;
+    }
+
+    PrintMessage(message_prefix,
+                 "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
+  }
+
+  if (scrub)
+  {
+    if (volume->IsDatelDisc())
+    {
+      PrintMessage(message_prefix, "Error: Scrubbing a Datel disc is not supported.\n");
+      return false;
+    }
+
+    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
+
+    if (!blob_reader)
+    {
+      PrintMessage(message_prefix,
+                   "Error: Unable to process disc image. Try again without --scrub.\n");
+      return false;
+    }
+  }
+
+  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
+      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
+  {
+    PrintMessage(message_prefix,
+                 "Warning: Converting Wii disc images to GCZ without scrubbing may not "
+                 "offer space advantages over ISO. Continuing anyway.\n");
+  }
+
+  if (volume && volume->IsNKit())
+  {
+    PrintMessage(
+        message_prefix,
+        "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
+  }
+
+  if (format == DiscIO::BlobType::GCZ && volume &&
+      !DiscIO::IsGCZBlockSizeLegacyCompatible(settings.block_size.value(), volume->GetDataSize()))
+  {
+    PrintMessage(message_prefix,
+                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
+                 "must be an integer multiple of the block size and must not be an integer "
+                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
+  }
+
+  // Perform the conversion
+  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
+
+  bool success = false;
+
+  switch (format)
+  {
+  case DiscIO::BlobType::PLAIN:
+  {
+    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
+                                     NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  case DiscIO::BlobType::GCZ:
+  {
+    u32 sub_type = std::numeric_limits<u32>::max();
+    if (volume)
+    {
+      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
+        sub_type = 0;
+      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
+        sub_type = 1;
+    }
+    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
+                                   settings.block_size.value(), NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  case DiscIO::BlobType::WIA:
+  case DiscIO::BlobType::RVZ:
+  {
+    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
+                                        format == DiscIO::BlobType::RVZ,
+                                        settings.compression.value(),
+                                        settings.compression_level.value(),
+                                        settings.block_size.value(), NOOP_STATUS_CALLBACK);
+    break;
+  }
+
+  default:
+  {
+    ASSERT(false);
+    break;
+  }
+  }
+
+  if (!success)
+    PrintMessage(message_prefix, "Error: Conversion failed\n");
+
+  return success;
+}
+
+static std::vector<std::string> FindInputFiles(const std::vector<std::string>& inputs)
+{
+  static const std::vector<std::string> disc_extensions = {
+      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".nfs"};
+
+  std::vector<std::string> files;
+  for (const std::string& input : inputs)
+  {
+    if (File::IsDirectory(input))
+    {
+      const std::vector<std::string> found = Common::DoFileSearch({input}, disc_extensions);
+      files.insert(files.end(), found.begin(), found.end());
+    }
+    else
+    {
+      files.push_back(input);
+    }
+  }
+
+  return files;
+}
+
+// Converts several files at once, so that the reading and writing at the start and end of one
+// file overlaps with the compression of another. The compression jobs of all files share one
+// budget of hardware threads.
+static int ConvertBatch(const std::vector<std::string>& input_file_paths,
+                        const std::string& output_directory, const ConversionSettings& settings,
+                        int jobs)
+{
+  if (File::Exists(output_directory) && !File::IsDirectory(output_directory))
+  {
+    fmt::print(std::cerr, "Error: The output must be a directory when converting several files\n");
+    return EXIT_FAILURE;
+  }
+  if (!File::CreateDirs(output_directory))
+  {
+    fmt::print(std::cerr, "Error: The output directory could not be created\n");
+    return EXIT_FAILURE;
+  }
+
+  // Files with the same name from different directories would be written to the same output file
+  // at once. Compare the paths case-insensitively, since the file system may not tell them apart.
+  std::vector<std::string> output_file_paths;
+  std::map<std::string, size_t> output_file_indices;
+  for (size_t i = 0; i < input_file_paths.size(); ++i)
+  {
+    std::string name;
+    SplitPath(input_file_paths[i], nullptr, &name, nullptr);
+    output_file_paths.push_back(output_directory + '/' + name +
+                                GetFormatExtension(settings.format));
+
+    std::string key = output_file_paths[i];
+    Common::ToLower(&key);
+    const auto [it, inserted] = output_file_indices.emplace(std::move(key), i);
+    if (!inserted)
+    {
+      fmt::print(std::cerr, "Error: {} and {} would both be written to {}\n",
+                 input_file_paths[it->second], input_file_paths[i], output_file_paths[i]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  DiscIO::CompressionSlots::SetLimit(std::max(std::thread::hardware_concurrency(), 1u));
+
+  std::mutex output_mutex;
+  std::atomic<size_t> next_file = 0;
+  std::atomic<bool> all_succeeded = true;
+
+  const auto convert_files = [&] {
+    for (size_t i = next_file++; i < input_file_paths.size(); i = next_file++)
+    {
+      const std::string& input_file_path = input_file_paths[i];
+      const std::string& output_file_path = output_file_paths[i];
+      const std::string message_prefix = input_file_path + ": ";
+
+      u64 data_size = 0;
+      const u64 start_ms = Common::Timer::NowMs();
+      bool success = false;
+      if (output_file_path == input_file_path)
+      {
+        PrintMessage(message_prefix, "Error: The file would overwrite itself\n");
+      }
+      else
+      {
+        success =
+            ConvertFile(input_file_path, output_file_path, settings, message_prefix, &data_size);
+      }
+      const double seconds = std::max<u64>(Common::Timer::NowMs() - start_ms, 1) / 1000.0;
+
+      if (!success)
+        all_succeeded = false;
+
+      const u64 output_size = success ? File::GetSize(output_file_path) : 0;
+      picojson::object json;
+      json["input"] = picojson::value(input_file_path);
+      json["output"] = picojson::value(output_file_path);
+      json["success"] = picojson::value(success);
+      json["data_size"] = picojson::value(static_cast<double>(data_size));
+      json["output_size"] = picojson::value(static_cast<double>(output_size));
+      json["ratio"] =
+          picojson::value(data_size != 0 ? static_cast<double>(output_size) / data_size : 0.0);
+      json["seconds"] = picojson::value(seconds);
+      json["mib_per_second"] = picojson::value(data_size / 1024.0 / 1024.0 / seconds);
+
+      std::lock_guard lk(output_mutex);
+      std::cout << picojson::value(json) << std::endl;
+    }
+  };
+
+  std::vector<std::future<void>> workers;
+  for (int i = 1; i < jobs; ++i)
+    workers.push_back(std::async(std::launch::async, convert_files));
+  convert_files();
+  for (std::future<void>& worker : workers)
+    worker.get();
+
+  DiscIO::CompressionSlots::SetLimit(0);
+
+  return all_succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 int ConvertCommand(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
@@ -71,14 +370,16 @@ int ConvertCommand(const std::vector<std::string>& args)
 
   parser.add_option("-i", "--input")
       .type("string")
-      .action("store")
-      .help("Path to disc image FILE.")
+      .action("append")
+      .help("Path to disc image FILE. Can be given several times, or be a directory, to convert "
+            "several files at once.")
       .metavar("FILE");
 
   parser.add_option("-o", "--output")
       .type("string")
       .action("store")
-      .help("Path to the destination FILE.")
+      .help("Path to the destination FILE, or the destination directory when converting several "
+            "files. A JSON summary is printed for each file in that case.")
       .metavar("FILE");
 
   parser.add_option("-f", "--format")
@@ -110,6 +411,13 @@ int ConvertCommand(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Optional. Number of files to convert at the same time when converting several "
+            "files. Default is 2.")
+      .set_default(2);
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -125,7 +433,9 @@ int ConvertCommand(const std::vector<std::string>& args)
     fmt::print(std::cerr, "Error: No input set\n");
     return EXIT_FAILURE;
   }
-  const std::string& input_file_path = options["input"];
+  const std::list<std::string>& input_list = options.all("input");
+  const std::vector<std::string> inputs(input_list.begin(), input_list.end());
+  const bool batch = inputs.size() > 1 || File::IsDirectory(inputs.front());
 
   // --output
   if (!options.is_set("output"))
@@ -144,48 +454,9 @@ int ConvertCommand(const std::vector<std::string>& args)
   }
   const DiscIO::BlobType format = format_o.value();
 
-  // Open the blob reader
-  std::unique_ptr<DiscIO::BlobReader> blob_reader = DiscIO::CreateBlobReader(input_file_path);
-  if (!blob_reader)
-  {
-    fmt::print(std::cerr, "Error: The input file could not be opened.\n");
-    return EXIT_FAILURE;
-  }
-
   // --scrub
   const bool scrub = static_cast<bool>(options.get("scrub"));
 
-  // Open the volume
-  std::unique_ptr<DiscIO::Volume> volume = DiscIO::CreateDisc(input_file_path);
-  if (!volume)
-  {
-    if (scrub)
-    {
-      fmt::print(std::cerr, "Error: Scrubbing is only supported for GC/Wii disc images.\n");
-      return EXIT_FAILURE;
-    }
-
-    fmt::print(std::cerr,
-               "Warning: The input file is not a GC/Wii disc image. Continuing anyway.\n");
-  }
-
-  if (scrub)
-  {
-    if (volume->IsDatelDisc())
-    {
-      fmt::print(std::cerr, "Error: Scrubbing a Datel disc is not supported.\n");
-      return EXIT_FAILURE;
-    }
-
-    blob_reader = DiscIO::ScrubbedBlob::Create(input_file_path);
-
-    if (!blob_reader)
-    {
-      fmt::print(std::cerr, "Error: Unable to process disc image. Try again without --scrub.\n");
-      return EXIT_FAILURE;
-    }
-  }
-
   if (scrub && format == DiscIO::BlobType::RVZ)
   {
     fmt::print(std::cerr, "Warning: Scrubbing an RVZ container does not offer significant space "
@@ -198,19 +469,6 @@ int ConvertCommand(const std::vector<std::string>& args)
                           "using external compression. Continuing anyway.\n");
   }
 
-  if (!scrub && format == DiscIO::BlobType::GCZ && volume &&
-      volume->GetVolumeType() == DiscIO::Platform::WiiDisc && !volume->IsDatelDisc())
-  {
-    fmt::print(std::cerr, "Warning: Converting Wii disc images to GCZ without scrubbing may not "
-                          "offer space advantages over ISO. Continuing anyway.\n");
-  }
-
-  if (volume && volume->IsNKit())
-  {
-    fmt::print(std::cerr,
-               "Warning: Converting an NKit file, output will still be NKit! Continuing anyway.\n");
-  }
-
   // --block_size
   std::optional<int> block_size_o;
   if (options.is_set("block_size"))
@@ -237,15 +495,6 @@ int ConvertCommand(const std::vector<std::string>& args)
       fmt::print(std::cerr,
                  "Warning: Block size is not ideal for performance. Continuing anyway.\n");
     }
-
-    if (format == DiscIO::BlobType::GCZ && volume &&
-        !DiscIO::IsGCZBlockSizeLegacyCompatible(block_size_o.value(), volume->GetDataSize()))
-    {
-      fmt::print(std::cerr,
-                 "Warning: For GCZs to be compatible with Dolphin < 5.0-11893, the file size "
-                 "must be an integer multiple of the block size and must not be an integer "
-                 "multiple of the block size multiplied by 32. Continuing anyway.\n");
-    }
   }
 
   // --compress, --compress_level
@@ -296,57 +545,31 @@ int ConvertCommand(const std::vector<std::string>& args)
     }
   }
 
-  // Perform the conversion
-  const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
-
-  bool success = false;
-
-  switch (format)
-  {
-  case DiscIO::BlobType::PLAIN:
-  {
-    success = DiscIO::ConvertToPlain(blob_reader.get(), input_file_path, output_file_path,
-                                     NOOP_STATUS_CALLBACK);
-    break;
-  }
+  const ConversionSettings settings{format, scrub, block_size_o, compression_o,
+                                    compression_level_o};
 
-  case DiscIO::BlobType::GCZ:
+  if (batch)
   {
-    u32 sub_type = std::numeric_limits<u32>::max();
-    if (volume)
+    const std::vector<std::string> input_file_paths = FindInputFiles(inputs);
+    if (input_file_paths.empty())
     {
-      if (volume->GetVolumeType() == DiscIO::Platform::GameCubeDisc)
-        sub_type = 0;
-      else if (volume->GetVolumeType() == DiscIO::Platform::WiiDisc)
-        sub_type = 1;
+      fmt::print(std::cerr, "Error: No disc images found\n");
+      return EXIT_FAILURE;
     }
-    success = DiscIO::ConvertToGCZ(blob_reader.get(), input_file_path, output_file_path, sub_type,
-                                   block_size_o.value(), NOOP_STATUS_CALLBACK);
-    break;
-  }
 
-  case DiscIO::BlobType::WIA:
-  case DiscIO::BlobType::RVZ:
-  {
-    success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
-                                        format == DiscIO::BlobType::RVZ, compression_o.value(),
-                                        compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
-    break;
-  }
+    const int jobs = static_cast<int>(options.get("jobs"));
+    if (jobs <= 0)
+    {
+      fmt::print(std::cerr, "Error: The number of jobs must be positive\n");
+      return EXIT_FAILURE;
+    }
 
-  default:
-  {
-    ASSERT(false);
-    break;
-  }
+    return ConvertBatch(input_file_paths, output_file_path, settings, jobs);
   }
 
-  if (!success)
-  {
-    fmt::print(std::cerr, "Error: Conversion failed\n");
+  u64 data_size;
+  if (!ConvertFile(inputs.front(), output_file_path, settings, "", &data_size))
     return EXIT_FAILURE;
-  }
 
   return EXIT_SUCCESS;
 }
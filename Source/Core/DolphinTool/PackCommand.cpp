@@ -0,0 +1,142 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/PackCommand.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/WIABlob.h"
+
+namespace DolphinTool
+{
+int PackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: pack [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("append")
+      .help("Path to a WIA/RVZ FILE. Can be given several times.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Directory to write the packed files to. They keep the names of the input files.")
+      .metavar("DIR");
+
+  parser.add_option("-s", "--store")
+      .type("string")
+      .action("store")
+      .help("Directory of the chunk store that the packed files will refer to. Will be created "
+            "if it doesn't exist.")
+      .metavar("DIR");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  if (!options.is_set("output"))
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+  if (!options.is_set("store"))
+  {
+    fmt::print(std::cerr, "Error: No chunk store set\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& output_directory = options["output"];
+  if (!File::CreateDirs(output_directory))
+  {
+    fmt::print(std::cerr, "Error: The output directory could not be created\n");
+    return EXIT_FAILURE;
+  }
+
+  const std::string& store_path = options["store"];
+  const u64 store_size_before = File::GetSize(DiscIO::ChunkStore::GetDataPath(store_path));
+
+  u64 total_input_size = 0;
+  for (const std::string& input_file_path : options.all("input"))
+  {
+    const std::string output_file_path =
+        output_directory + '/' + PathToFileName(input_file_path);
+    if (!DiscIO::PackWIAOrRVZ(input_file_path, output_file_path, store_path))
+    {
+      fmt::print(std::cerr, "Error: Unable to pack {}\n", input_file_path);
+      return EXIT_FAILURE;
+    }
+
+    const u64 input_size = File::GetSize(input_file_path);
+    total_input_size += input_size;
+    fmt::print(std::cout, "{}: {} KiB -> {} KiB\n", input_file_path, input_size / 1024,
+               File::GetSize(output_file_path) / 1024);
+  }
+
+  const u64 store_size = File::GetSize(DiscIO::ChunkStore::GetDataPath(store_path));
+  fmt::print(std::cout, "Chunk store grew by {} KiB for {} KiB of input ({} KiB in total)\n",
+             (store_size - store_size_before) / 1024, total_input_size / 1024, store_size / 1024);
+
+  return EXIT_SUCCESS;
+}
+
+int UnpackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: unpack [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to a packed WIA/RVZ FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination FILE.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  if (!options.is_set("output"))
+  {
+    fmt::print(std::cerr, "Error: No output set\n");
+    return EXIT_FAILURE;
+  }
+
+  if (!DiscIO::UnpackWIAOrRVZ(options["input"], options["output"]))
+  {
+    fmt::print(std::cerr, "Error: Unable to unpack {}. Make sure that it is a packed file and "
+                          "that its chunk store is available.\n",
+               options["input"]);
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
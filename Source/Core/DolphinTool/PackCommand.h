@@ -0,0 +1,13 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace DolphinTool
+{
+int PackCommand(const std::vector<std::string>& args);
+int UnpackCommand(const std::vector<std::string>& args);
+}  // namespace DolphinTool
@@ -0,0 +1,241 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ReplayCommand.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Common/Timer.h"
+#include "DiscIO/Filesystem.h"
+#include "DiscIO/ReadAheadCache.h"
+#include "DiscIO/Volume.h"
+#include "DiscIO/VolumeDisc.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct ReplayRead
+{
+  u64 offset;
+  u64 length;
+};
+
+struct ReplayResult
+{
+  bool success = true;
+  u64 read_time_us = 0;
+  u64 max_read_time_us = 0;
+  u64 prefetch_time_us = 0;
+
+  void Add(const ReplayResult& other)
+  {
+    success &= other.success;
+    read_time_us += other.read_time_us;
+    max_read_time_us = std::max(max_read_time_us, other.max_read_time_us);
+    prefetch_time_us += other.prefetch_time_us;
+  }
+};
+}  // namespace
+
+// Reads the file paths from a File Monitor log. Each logged line ends with "<size> kB <path>".
+static std::vector<std::string> ParseTrace(const std::string& path)
+{
+  std::vector<std::string> files;
+
+  std::ifstream stream;
+  File::OpenFStream(stream, path, std::ios_base::in);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    constexpr std::string_view separator = " kB ";
+    const size_t position = line.find(separator);
+    if (position == std::string::npos)
+      continue;
+
+    const std::string_view file =
+        StripWhitespace(std::string_view(line).substr(position + separator.size()));
+    if (!file.empty())
+      files.emplace_back(file);
+  }
+
+  return files;
+}
+
+static ReplayResult Replay(const DiscIO::Volume& volume, const DiscIO::Partition& partition,
+                           const std::vector<ReplayRead>& reads, DiscIO::ReadAheadCache* cache)
+{
+  ReplayResult result;
+  std::vector<u8> buffer;
+  for (const ReplayRead& read : reads)
+  {
+    buffer.resize(read.length);
+
+    const u64 start_us = Common::Timer::NowUs();
+    const bool success = cache ? cache->Read(volume, read.offset, read.length, buffer.data(),
+                                             partition) :
+                                 volume.Read(read.offset, read.length, buffer.data(), partition);
+    const u64 read_time_us = Common::Timer::NowUs() - start_us;
+    result.read_time_us += read_time_us;
+    result.max_read_time_us = std::max(result.max_read_time_us, read_time_us);
+    result.success &= success;
+
+    // Assume that the emulated drive leaves enough time to read ahead between requests, like the
+    // DVD thread does while it is idle.
+    if (cache)
+    {
+      const u64 prefetch_start_us = Common::Timer::NowUs();
+      while (cache->PrefetchNext(volume))
+      {
+      }
+      result.prefetch_time_us += Common::Timer::NowUs() - prefetch_start_us;
+    }
+  }
+
+  return result;
+}
+
+int ReplayCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: replay [options]...");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to disc image FILE.")
+      .metavar("FILE");
+
+  parser.add_option("-t", "--trace")
+      .type("string")
+      .action("store")
+      .help("Path to a File Monitor log to replay the accessed files from.")
+      .metavar("FILE");
+
+  parser.add_option("-c", "--cache_size")
+      .type("int")
+      .action("store")
+      .help("Optional. Size of the read-ahead cache in MiB. Default is 16.")
+      .set_default(16);
+
+  parser.add_option("-r", "--read_size")
+      .type("int")
+      .action("store")
+      .help("Optional. Size of each read in KiB. Default is 32.")
+      .set_default(32);
+
+  const optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  if (!options.is_set("input"))
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+  if (!options.is_set("trace"))
+  {
+    fmt::print(std::cerr, "Error: No trace set\n");
+    return EXIT_FAILURE;
+  }
+
+  const int cache_size_mib = static_cast<int>(options.get("cache_size"));
+  const int read_size_kib = static_cast<int>(options.get("read_size"));
+  if (cache_size_mib <= 0 || read_size_kib <= 0)
+  {
+    fmt::print(std::cerr, "Error: Cache size and read size must be positive\n");
+    return EXIT_FAILURE;
+  }
+
+  // Open the volume
+  const std::unique_ptr<DiscIO::VolumeDisc> volume = DiscIO::CreateDisc(options["input"]);
+  if (!volume)
+  {
+    fmt::print(std::cerr, "Error: Unable to open disc image\n");
+    return EXIT_FAILURE;
+  }
+
+  const DiscIO::Partition partition = volume->GetGamePartition();
+  const DiscIO::FileSystem* file_system = volume->GetFileSystem(partition);
+  if (!file_system)
+  {
+    fmt::print(std::cerr, "Error: Disc image has no valid file system\n");
+    return EXIT_FAILURE;
+  }
+
+  // Turn the accessed files into the sequential reads a game would issue for them
+  const u64 read_size = static_cast<u64>(read_size_kib) * 1024;
+  std::vector<ReplayRead> reads;
+  u64 total_bytes = 0;
+  for (const std::string& path : ParseTrace(options["trace"]))
+  {
+    const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(path);
+    if (!file_info || file_info->IsDirectory())
+    {
+      fmt::print(std::cerr, "Warning: {} not found on disc, skipping\n", path);
+      continue;
+    }
+
+    const u64 end = file_info->GetOffset() + file_info->GetSize();
+    for (u64 offset = file_info->GetOffset(); offset < end; offset += read_size)
+      reads.push_back({offset, std::min(read_size, end - offset)});
+    total_bytes += file_info->GetSize();
+  }
+
+  if (reads.empty())
+  {
+    fmt::print(std::cerr, "Error: No files from the trace could be replayed\n");
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Replaying {} reads ({} KiB)\n", reads.size(), total_bytes / 1024);
+
+  // Whichever pass runs first warms the OS page cache for the ones after it, so run the passes
+  // in the order direct, cached, cached, direct and add up the results of each kind.
+  DiscIO::ReadAheadCache cache(static_cast<u64>(cache_size_mib) * 1024 * 1024);
+  ReplayResult direct;
+  ReplayResult cached;
+  for (const bool use_cache : {false, true, true, false})
+  {
+    if (use_cache)
+    {
+      cached.Add(Replay(*volume, partition, reads, &cache));
+      cache.Clear();
+    }
+    else
+    {
+      direct.Add(Replay(*volume, partition, reads, nullptr));
+    }
+  }
+
+  if (!direct.success || !cached.success)
+    fmt::print(std::cerr, "Warning: Some reads failed\n");
+
+  fmt::print(std::cout, "Totals over two passes each:\n");
+  fmt::print(std::cout, "Without read-ahead: {} ms blocking, {} us slowest read\n",
+             direct.read_time_us / 1000, direct.max_read_time_us);
+  fmt::print(std::cout,
+             "With read-ahead:    {} ms blocking, {} us slowest read, {} ms reading ahead\n",
+             cached.read_time_us / 1000, cached.max_read_time_us,
+             cached.prefetch_time_us / 1000);
+
+  const DiscIO::ReadAheadCache::Stats& stats = cache.GetStats();
+  fmt::print(std::cout, "{} hits, {} misses, {} blocks prefetched, {} wasted\n", stats.hits,
+             stats.misses, stats.prefetched_blocks, stats.wasted_blocks);
+
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
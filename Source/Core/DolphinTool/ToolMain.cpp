@@ -14,16 +14,21 @@
 #include "Common/StringUtil.h"
 #include "Core/Core.h"
 
+#include "DolphinTool/BenchmarkReadCommand.h"
+#include "DolphinTool/BenchmarkStateDeltaCommand.h"
 #include "DolphinTool/ConvertCommand.h"
 #include "DolphinTool/ExtractCommand.h"
 #include "DolphinTool/HeaderCommand.h"
+#include "DolphinTool/PackCommand.h"
+#include "DolphinTool/ReplayCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static void PrintUsage()
 {
   fmt::print(std::cerr, "usage: dolphin-tool COMMAND -h\n"
                         "\n"
-                        "commands supported: [convert, verify, header, extract]\n");
+                        "commands supported: [convert, verify, header, extract, pack, unpack, "
+                        "replay, benchmark-read, benchmark-state-delta]\n");
 }
 
 #ifdef _WIN32
@@ -52,6 +57,16 @@ int main(int argc, char* argv[])
     return DolphinTool::HeaderCommand(args);
   else if (command_str == "extract")
     return DolphinTool::Extract(args);
+  else if (command_str == "pack")
+    return DolphinTool::PackCommand(args);
+  else if (command_str == "unpack")
+    return DolphinTool::UnpackCommand(args);
+  else if (command_str == "replay")
+    return DolphinTool::ReplayCommand(args);
+  else if (command_str == "benchmark-read")
+    return DolphinTool::BenchmarkReadCommand(args);
+  else if (command_str == "benchmark-state-delta")
+    return DolphinTool::BenchmarkStateDeltaCommand(args);
   PrintUsage();
   return EXIT_FAILURE;
 }
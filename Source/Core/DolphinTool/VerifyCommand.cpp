@@ -3,6 +3,7 @@
 
 #include "DolphinTool/VerifyCommand.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -11,7 +12,9 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 
+#include "Common/CommonTypes.h"
 #include "Common/StringUtil.h"
+#include "Common/Timer.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/VolumeVerifier.h"
 #include "UICommon/UICommon.h"
@@ -99,6 +102,10 @@ int VerifyCommand(const std::vector<std::string>& args)
             "[%choices]")
       .choices({"crc32", "md5", "sha1"});
 
+  parser.add_option("-p", "--progress")
+      .action("store_true")
+      .help("Print the progress and throughput to stderr while verifying.");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -148,12 +155,34 @@ int VerifyCommand(const std::vector<std::string>& args)
 
   // Verify the volume
   DiscIO::VolumeVerifier verifier(*volume, false, hashes_to_calculate);
+  const bool print_progress = options.is_set("progress");
+  const u64 start_ms = Common::Timer::NowMs();
+  u64 last_print_ms = start_ms;
   verifier.Start();
   while (verifier.GetBytesProcessed() != verifier.GetTotalBytes())
   {
     verifier.Process();
+
+    const u64 now_ms = Common::Timer::NowMs();
+    if (print_progress && now_ms - last_print_ms >= 1000)
+    {
+      last_print_ms = now_ms;
+      const u64 processed = verifier.GetBytesProcessed();
+      fmt::print(std::cerr, "\r{:3}% ({} / {} MiB, {:.1f} MiB/s)",
+                 processed * 100 / verifier.GetTotalBytes(), processed / 1024 / 1024,
+                 verifier.GetTotalBytes() / 1024 / 1024,
+                 processed / 1024.0 / 1024.0 / ((now_ms - start_ms) / 1000.0));
+    }
   }
   verifier.Finish();
+
+  if (print_progress)
+  {
+    const double seconds = std::max<u64>(Common::Timer::NowMs() - start_ms, 1) / 1000.0;
+    fmt::print(std::cerr, "\rVerified {} MiB in {:.1f} s ({:.1f} MiB/s)\n",
+               verifier.GetTotalBytes() / 1024 / 1024, seconds,
+               verifier.GetTotalBytes() / 1024.0 / 1024.0 / seconds);
+  }
   const DiscIO::VolumeVerifier::Result& result = verifier.GetResult();
 
   // Print the report
@@ -4,12 +4,16 @@
 #include "UICommon/GameFileCache.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <list>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -26,7 +30,26 @@
 
 namespace UICommon
 {
-static constexpr u32 CACHE_REVISION = 25;  // Last changed in PR 12702
+static constexpr u32 CACHE_REVISION = 26;  // Last changed when the cache file became indexed
+
+// Calls function for every index below count, spread over all hardware threads
+static void ParallelFor(size_t count, const std::function<void(size_t)>& function)
+{
+  std::atomic<size_t> next_index = 0;
+  const auto run = [&] {
+    for (size_t i = next_index++; i < count; i = next_index++)
+      function(i);
+  };
+
+  const size_t thread_count =
+      std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), count);
+  std::vector<std::future<void>> workers;
+  for (size_t i = 1; i < thread_count; ++i)
+    workers.push_back(std::async(std::launch::async, run));
+  run();
+  for (std::future<void>& worker : workers)
+    worker.get();
+}
 
 std::vector<std::string> FindAllGamePaths(const std::vector<std::string>& directories_to_scan,
                                           bool recursive_scan)
@@ -131,19 +154,34 @@ bool GameFileCache::Update(std::span<const std::string> all_game_paths,
 
   // Now that the previous loop has run, game_paths only contains paths that
   // aren't in m_cached_files, so we simply add all of them to m_cached_files.
-  for (const std::string& path : game_paths)
+  // Most of the time is spent opening the volumes, so the GameFiles are created on several
+  // threads, in batches so that the callback gets to report them as they are found.
+  // The GameFile constructor only uses per-volume state, except for the directory scan cache of
+  // DirectoryBlob, which is guarded by a lock, and the global DiscIO settings, which are atomic.
+  // Keep it that way when adding to it.
+  const std::vector<std::string> new_paths(game_paths.begin(), game_paths.end());
+  const size_t batch_size = std::max(std::thread::hardware_concurrency(), 1u) * 4;
+  std::vector<std::shared_ptr<GameFile>> new_files;
+  for (size_t batch_start = 0; batch_start < new_paths.size(); batch_start += batch_size)
   {
     if (processing_halted)
       break;
 
-    auto file = std::make_shared<GameFile>(path);
-    if (file->IsValid())
+    new_files.resize(std::min(batch_size, new_paths.size() - batch_start));
+    ParallelFor(new_files.size(), [&](size_t i) {
+      new_files[i] = std::make_shared<GameFile>(new_paths[batch_start + i]);
+    });
+
+    for (std::shared_ptr<GameFile>& file : new_files)
     {
-      if (game_added_to_cache)
-        game_added_to_cache(file);
+      if (file->IsValid())
+      {
+        if (game_added_to_cache)
+          game_added_to_cache(file);
 
-      cache_changed = true;
-      m_cached_files.push_back(std::move(file));
+        cache_changed = true;
+        m_cached_files.push_back(std::move(file));
+      }
     }
   }
 
@@ -216,41 +254,23 @@ bool GameFileCache::Save()
   return SyncCacheFile(true);
 }
 
+// The cache file starts with a header and the size of each entry, followed by the entries
+// themselves. Since each GameFile is serialized on its own, they can be serialized and
+// deserialized in parallel.
+struct CacheHeader
+{
+  u32 revision;
+  u32 number_of_entries;
+  u64 file_size;
+};
+
 bool GameFileCache::SyncCacheFile(bool save)
 {
   const char* open_mode = save ? "wb" : "rb";
   File::IOFile f(m_path, open_mode);
   if (!f)
     return false;
-  bool success = false;
-  if (save)
-  {
-    // Measure the size of the buffer.
-    u8* ptr = nullptr;
-    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
-    DoState(&p_measure);
-    const size_t buffer_size = reinterpret_cast<size_t>(ptr);
-
-    // Then actually do the write.
-    std::vector<u8> buffer(buffer_size);
-    ptr = buffer.data();
-    PointerWrap p(&ptr, buffer_size, PointerWrap::Mode::Write);
-    DoState(&p, buffer_size);
-    if (f.WriteBytes(buffer.data(), buffer.size()))
-      success = true;
-  }
-  else
-  {
-    std::vector<u8> buffer(f.GetSize());
-    if (!buffer.empty() && f.ReadBytes(buffer.data(), buffer.size()))
-    {
-      u8* ptr = buffer.data();
-      PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Read);
-      DoState(&p, buffer.size());
-      if (p.IsReadMode())
-        success = true;
-    }
-  }
+  const bool success = save ? SaveEntries(&f) : LoadEntries(&f);
   if (!success)
   {
     // If some file operation failed, try to delete the probably-corrupted cache
@@ -260,27 +280,85 @@ bool GameFileCache::SyncCacheFile(bool save)
   return success;
 }
 
-void GameFileCache::DoState(PointerWrap* p, u64 size)
+bool GameFileCache::SaveEntries(File::IOFile* f)
+{
+  std::vector<std::vector<u8>> entries(m_cached_files.size());
+  ParallelFor(entries.size(), [&](size_t i) {
+    // Measure the size of the buffer, then actually do the write
+    u8* ptr = nullptr;
+    PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+    m_cached_files[i]->DoState(p_measure);
+
+    entries[i].resize(reinterpret_cast<size_t>(ptr));
+    ptr = entries[i].data();
+    PointerWrap p(&ptr, entries[i].size(), PointerWrap::Mode::Write);
+    m_cached_files[i]->DoState(p);
+  });
+
+  std::vector<u64> entry_sizes(entries.size());
+  u64 file_size = sizeof(CacheHeader) + entry_sizes.size() * sizeof(u64);
+  for (size_t i = 0; i < entries.size(); ++i)
+  {
+    entry_sizes[i] = entries[i].size();
+    file_size += entry_sizes[i];
+  }
+
+  const CacheHeader header{CACHE_REVISION, static_cast<u32>(entries.size()), file_size};
+  if (!f->WriteArray(&header, 1) || !f->WriteArray(entry_sizes.data(), entry_sizes.size()))
+    return false;
+  for (const std::vector<u8>& entry : entries)
+  {
+    if (!f->WriteBytes(entry.data(), entry.size()))
+      return false;
+  }
+
+  return true;
+}
+
+bool GameFileCache::LoadEntries(File::IOFile* f)
 {
-  struct
+  std::vector<u8> buffer(f->GetSize());
+  if (buffer.size() < sizeof(CacheHeader) || !f->ReadBytes(buffer.data(), buffer.size()))
+    return false;
+
+  CacheHeader header;
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  const u64 index_end = sizeof(header) + static_cast<u64>(header.number_of_entries) * sizeof(u64);
+  if (header.revision != CACHE_REVISION || header.file_size != buffer.size() ||
+      index_end > buffer.size())
   {
-    u32 revision;
-    u64 expected_size;
-  } header = {CACHE_REVISION, size};
-  p->Do(header);
-  if (p->IsReadMode())
+    return false;
+  }
+
+  std::vector<u64> entry_offsets(header.number_of_entries);
+  std::vector<u64> entry_sizes(header.number_of_entries);
+  std::memcpy(entry_sizes.data(), buffer.data() + sizeof(header), entry_sizes.size() * sizeof(u64));
+  u64 offset = index_end;
+  for (size_t i = 0; i < entry_sizes.size(); ++i)
   {
-    if (header.revision != CACHE_REVISION || header.expected_size != size)
-    {
-      p->SetMeasureMode();
-      return;
-    }
+    // offset never exceeds the buffer size, so this can't overflow even if the size is corrupt
+    if (entry_sizes[i] > buffer.size() - offset)
+      return false;
+    entry_offsets[i] = offset;
+    offset += entry_sizes[i];
   }
-  p->DoEachElement(m_cached_files, [](PointerWrap& state, std::shared_ptr<GameFile>& elem) {
-    if (state.IsReadMode())
-      elem = std::make_shared<GameFile>();
-    elem->DoState(state);
+
+  std::vector<std::shared_ptr<GameFile>> cached_files(header.number_of_entries);
+  std::atomic<bool> success = true;
+  ParallelFor(cached_files.size(), [&](size_t i) {
+    u8* ptr = buffer.data() + entry_offsets[i];
+    PointerWrap p(&ptr, entry_sizes[i], PointerWrap::Mode::Read);
+    cached_files[i] = std::make_shared<GameFile>();
+    cached_files[i]->DoState(p);
+    if (!p.IsReadMode())
+      success = false;
   });
+
+  if (!success)
+    return false;
+
+  m_cached_files = std::move(cached_files);
+  return true;
 }
 
 }  // namespace UICommon
@@ -13,7 +13,10 @@
 
 #include "Common/CommonTypes.h"
 
-class PointerWrap;
+namespace File
+{
+class IOFile;
+}
 
 namespace UICommon
 {
@@ -61,7 +64,8 @@ private:
   bool UpdateAdditionalMetadata(std::shared_ptr<GameFile>* game_file);
 
   bool SyncCacheFile(bool save);
-  void DoState(PointerWrap* p, u64 size = 0);
+  bool SaveEntries(File::IOFile* f);
+  bool LoadEntries(File::IOFile* f);
 
   std::string m_path;
   std::vector<std::shared_ptr<GameFile>> m_cached_files;
@@ -44,6 +44,11 @@
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
 
+#include "DiscIO/Blob.h"
+#include "DiscIO/DirectoryScanCache.h"
+#include "DiscIO/FileBlob.h"
+#include "DiscIO/WIABlob.h"
+
 #include "InputCommon/ControllerInterface/ControllerInterface.h"
 #include "InputCommon/GCAdapter.h"
 
@@ -123,6 +128,12 @@ static void RefreshConfig()
 {
   Common::SetEnableAlert(Config::Get(Config::MAIN_USE_PANIC_HANDLERS));
   Common::SetAbortOnPanicAlert(Config::Get(Config::MAIN_ABORT_ON_PANIC_ALERT));
+  DiscIO::SetWIARVZCacheSize(
+      static_cast<u64>(std::max(Config::Get(Config::MAIN_WIA_RVZ_CACHE_MIB), 0)) * 1024 * 1024);
+  DiscIO::SetSectorReaderCacheSize(
+      static_cast<u64>(std::max(Config::Get(Config::MAIN_SECTOR_CACHE_MIB), 0)) * 1024 * 1024);
+  DiscIO::SetPlainFileMapping(Config::Get(Config::MAIN_MAP_DISC_IMAGES));
+  DiscIO::SetDirectoryScanCaching(Config::Get(Config::MAIN_CACHE_DIRECTORY_SCANS));
 }
 
 void Init()
@@ -147,6 +158,7 @@ void Shutdown()
 
   GCAdapter::Shutdown();
   WiimoteReal::Shutdown();
+  DiscIO::ShutdownDirectoryScanCache();
   Common::Log::LogManager::Shutdown();
   Discord::Shutdown();
   SConfig::Shutdown();
@@ -37,12 +37,11 @@ void AsyncRequests::PullEventsInternal()
 
     // try to merge as many efb pokes as possible
     // it's a bit hacky, but some games render a complete frame in this way
+    // color and z pokes go to separate batches, so interleaved runs can be merged as well
     if ((e.type == Event::EFB_POKE_COLOR || e.type == Event::EFB_POKE_Z))
     {
-      m_merged_efb_pokes.clear();
-      Event first_event = m_queue.front();
-      const auto t = first_event.type == Event::EFB_POKE_COLOR ? EFBAccessType::PokeColor :
-                                                                 EFBAccessType::PokeZ;
+      m_merged_efb_color_pokes.clear();
+      m_merged_efb_z_pokes.clear();
 
       do
       {
@@ -52,13 +51,26 @@ void AsyncRequests::PullEventsInternal()
         d.data = e.efb_poke.data;
         d.x = e.efb_poke.x;
         d.y = e.efb_poke.y;
-        m_merged_efb_pokes.push_back(d);
+        if (e.type == Event::EFB_POKE_COLOR)
+          m_merged_efb_color_pokes.push_back(d);
+        else
+          m_merged_efb_z_pokes.push_back(d);
 
         m_queue.pop();
-      } while (!m_queue.empty() && m_queue.front().type == first_event.type);
+      } while (!m_queue.empty() && (m_queue.front().type == Event::EFB_POKE_COLOR ||
+                                    m_queue.front().type == Event::EFB_POKE_Z));
 
       lock.unlock();
-      g_renderer->PokeEFB(t, m_merged_efb_pokes.data(), m_merged_efb_pokes.size());
+      if (!m_merged_efb_color_pokes.empty())
+      {
+        g_renderer->PokeEFB(EFBAccessType::PokeColor, m_merged_efb_color_pokes.data(),
+                            m_merged_efb_color_pokes.size());
+      }
+      if (!m_merged_efb_z_pokes.empty())
+      {
+        g_renderer->PokeEFB(EFBAccessType::PokeZ, m_merged_efb_z_pokes.data(),
+                            m_merged_efb_z_pokes.size());
+      }
       lock.lock();
       continue;
     }
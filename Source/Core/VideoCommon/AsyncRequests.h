@@ -107,5 +107,6 @@ private:
   bool m_enable = false;
   bool m_passthrough = true;
 
-  std::vector<EfbPokeData> m_merged_efb_pokes;
+  std::vector<EfbPokeData> m_merged_efb_color_pokes;
+  std::vector<EfbPokeData> m_merged_efb_z_pokes;
 };
@@ -11,8 +11,6 @@
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/VideoConfig.h"
 
-#include <algorithm>
-
 std::unique_ptr<BoundingBox> g_bounding_box;
 
 void BoundingBox::Enable(PixelShaderManager& pixel_shader_manager)
@@ -29,8 +27,11 @@ void BoundingBox::Disable(PixelShaderManager& pixel_shader_manager)
 
 void BoundingBox::Flush()
 {
-  if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
+  if (!g_ActiveConfig.bBBoxEnable || g_ActiveConfig.bBBoxCPU ||
+      !g_ActiveConfig.backend_info.bSupportsBBox)
+  {
     return;
+  }
 
   m_is_valid = false;
 
@@ -76,6 +77,10 @@ u16 BoundingBox::Get(u32 index)
 {
   ASSERT(index < NUM_BBOX_VALUES);
 
+  // The CPU path keeps the values up to date as vertices are loaded, so there's nothing to read.
+  if (g_ActiveConfig.UseCPUBoundingBox())
+    return static_cast<u16>(m_values[index]);
+
   if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
     return m_bounding_box_fallback[index];
 
@@ -89,6 +94,12 @@ void BoundingBox::Set(u32 index, u16 value)
 {
   ASSERT(index < NUM_BBOX_VALUES);
 
+  if (g_ActiveConfig.UseCPUBoundingBox())
+  {
+    m_values[index] = value;
+    return;
+  }
+
   if (!g_ActiveConfig.bBBoxEnable || !g_ActiveConfig.backend_info.bSupportsBBox)
   {
     m_bounding_box_fallback[index] = value;
@@ -102,6 +113,14 @@ void BoundingBox::Set(u32 index, u16 value)
   m_dirty[index] = true;
 }
 
+void BoundingBox::Update(u16 left, u16 right, u16 top, u16 bottom)
+{
+  m_values[0] = std::min<BBoxType>(m_values[0], left);
+  m_values[1] = std::max<BBoxType>(m_values[1], right);
+  m_values[2] = std::min<BBoxType>(m_values[2], top);
+  m_values[3] = std::max<BBoxType>(m_values[3], bottom);
+}
+
 // FIXME: This may not work correctly if we're in the middle of a draw.
 // We should probably ensure that state saves only happen on frame boundaries.
 // Nonetheless, it has been designed to be as safe as possible.
@@ -120,12 +139,16 @@ void BoundingBox::DoState(PointerWrap& p)
   {
     p.Do(backend_values);
 
-    if (g_ActiveConfig.backend_info.bSupportsBBox)
+    if (g_ActiveConfig.UseCPUBoundingBox())
+      std::copy(backend_values.begin(), backend_values.end(), m_values.begin());
+    else if (g_ActiveConfig.backend_info.bSupportsBBox)
       Write(0, backend_values);
   }
   else
   {
-    if (g_ActiveConfig.backend_info.bSupportsBBox)
+    if (g_ActiveConfig.UseCPUBoundingBox())
+      backend_values.assign(m_values.begin(), m_values.end());
+    else if (g_ActiveConfig.backend_info.bSupportsBBox)
       backend_values = Read(0, NUM_BBOX_VALUES);
 
     p.Do(backend_values);
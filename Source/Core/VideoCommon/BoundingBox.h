@@ -31,6 +31,10 @@ public:
   u16 Get(u32 index);
   void Set(u32 index, u16 value);
 
+  // Extends the bounding box with values computed on the CPU (see CPUCull::ComputeBoundingBox).
+  // Only used when CPU bounding box emulation is enabled.
+  void Update(u16 left, u16 right, u16 top, u16 bottom);
+
   void DoState(PointerWrap& p);
 
   // Initialize, Read, and Write are only safe to call if the backend supports bounding box,
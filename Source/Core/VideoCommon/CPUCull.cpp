@@ -3,12 +3,17 @@
 
 #include "VideoCommon/CPUCull.h"
 
+#include <algorithm>
+#include <limits>
+
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
 #include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
 #include "Core/System.h"
 
+#include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
@@ -137,11 +142,8 @@ void CPUCull::Init()
   m_cull_table[Prim::GX_DRAW_TRIANGLE_FAN] = GetCullFunction1<Prim::GX_DRAW_TRIANGLE_FAN>();
 }
 
-bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
-                                   const u8* src, u32 count)
+void CPUCull::TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count)
 {
-  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
-             "CPUCull should not be called on lines or points");
   const u32 stride = loader->m_native_vtx_decl.stride;
   const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
   const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
@@ -157,18 +159,263 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
   auto& system = Core::System::GetInstance();
   system.GetVertexShaderManager().SetProjectionMatrix(system.GetXFStateManager());
 
+  const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
+  transform(m_transform_buffer.get(), src, stride, count);
+}
+
+bool CPUCull::AreAllVerticesCulled(OpcodeDecoder::Primitive primitive, u32 count) const
+{
+  ASSERT_MSG(VIDEO, primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES,
+             "CPUCull should not be called on lines or points");
+
   static constexpr Common::EnumMap<CullMode, CullMode::All> cullmode_invert = {
       CullMode::None, CullMode::Front, CullMode::Back, CullMode::All};
 
   CullMode cullmode = bpmem.genMode.cullmode;
   if (xfmem.viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
     cullmode = cullmode_invert[cullmode];
-  const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
-  transform(m_transform_buffer.get(), src, stride, count);
   const CullFunction cull = m_cull_table[primitive][cullmode];
   return cull(m_transform_buffer.get(), count);
 }
 
+void CPUCull::UpdateBoundingBox(OpcodeDecoder::Primitive primitive, u32 count) const
+{
+  // Line width and point size are in 1/6th pixels.
+  const u32 size = primitive == OpcodeDecoder::Primitive::GX_DRAW_POINTS ?
+                       bpmem.lineptwidth.pointsize :
+                       bpmem.lineptwidth.linesize;
+  const float half_width = static_cast<float>(size) / 12.0f;
+
+  const BPFunctions::ScissorResult scissors = BPFunctions::ComputeScissorRects();
+  std::array<u16, 4> bbox;
+  if (ComputeBoundingBox(m_transform_buffer.get(), count, primitive, bpmem.genMode.cullmode,
+                         xfmem.viewport, half_width, scissors.m_result, &bbox))
+  {
+    g_bounding_box->Update(bbox[0], bbox[1], bbox[2], bbox[3]);
+  }
+}
+
+namespace
+{
+struct ScreenBoundingBox
+{
+  s32 left = std::numeric_limits<s32>::max();
+  s32 right = std::numeric_limits<s32>::min();
+  s32 top = std::numeric_limits<s32>::max();
+  s32 bottom = std::numeric_limits<s32>::min();
+};
+}  // namespace
+
+// Same rounding as the software rasterizer.
+static s32 RoundFixedPoint(float x)
+{
+  const s32 t = static_cast<s32>(x);
+  if ((x - t) >= 0.5f)
+    return t + 1;
+
+  return t;
+}
+
+// Adds the pixels the software rasterizer would consider for a primitive with the given screen
+// space extents (see Rasterizer.cpp: DrawTriangleFrontFace).
+static void AddScreenRect(float min_x, float max_x, float min_y, float max_y,
+                          std::span<const BPFunctions::ScissorRect> scissors,
+                          ScreenBoundingBox* bbox)
+{
+  // Keep far away vertices in range of the 28.4 fixed point setup; the result is clamped to the
+  // scissor rectangle anyway.
+  constexpr float LIMIT = 4096.0f;
+  min_x = std::clamp(min_x, -LIMIT, LIMIT);
+  max_x = std::clamp(max_x, -LIMIT, LIMIT);
+  min_y = std::clamp(min_y, -LIMIT, LIMIT);
+  max_y = std::clamp(max_y, -LIMIT, LIMIT);
+
+  for (const BPFunctions::ScissorRect& scissor : scissors)
+  {
+    const s32 x1 = RoundFixedPoint(16.0f * (min_x - scissor.x_off)) - 9;
+    const s32 x2 = RoundFixedPoint(16.0f * (max_x - scissor.x_off)) - 9;
+    const s32 y1 = RoundFixedPoint(16.0f * (min_y - scissor.y_off)) - 9;
+    const s32 y2 = RoundFixedPoint(16.0f * (max_y - scissor.y_off)) - 9;
+
+    const s32 left = std::max((x1 + 0xF) >> 4, scissor.rect.left);
+    const s32 right = std::min((x2 + 0xF) >> 4, scissor.rect.right);
+    const s32 top = std::max((y1 + 0xF) >> 4, scissor.rect.top);
+    const s32 bottom = std::min((y2 + 0xF) >> 4, scissor.rect.bottom);
+    if (left >= right || top >= bottom)
+      continue;
+
+    // The GPU rasterizes in 2x2 pixel quads, so the bounding box is rounded to their extents.
+    bbox->left = std::min(bbox->left, left & ~1);
+    bbox->right = std::max(bbox->right, (right - 1) | 1);
+    bbox->top = std::min(bbox->top, top & ~1);
+    bbox->bottom = std::max(bbox->bottom, (bottom - 1) | 1);
+  }
+}
+
+// Adds the screen space extents of the given vertices, grown by half_width pixels on each side.
+static void AddVertices(std::span<const CPUCull::TransformedVertex* const> vertices,
+                        const Viewport& viewport, float half_width,
+                        std::span<const BPFunctions::ScissorRect> scissors,
+                        ScreenBoundingBox* bbox)
+{
+  float min_x = std::numeric_limits<float>::max();
+  float max_x = std::numeric_limits<float>::lowest();
+  float min_y = std::numeric_limits<float>::max();
+  float max_y = std::numeric_limits<float>::lowest();
+  bool any_in_front = false;
+  bool any_behind = false;
+  for (const CPUCull::TransformedVertex* vertex : vertices)
+  {
+    if (!(vertex->w > 0.0f))
+    {
+      any_behind = true;
+      continue;
+    }
+
+    // See videosoftware Clipper.cpp:PerspectiveDivide
+    const float w_inverse = 1.0f / vertex->w;
+    const float x = vertex->x * w_inverse * viewport.wd + viewport.xOrig;
+    const float y = vertex->y * w_inverse * viewport.ht + viewport.yOrig;
+    min_x = std::min(min_x, x);
+    max_x = std::max(max_x, x);
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+    any_in_front = true;
+  }
+
+  if (!any_in_front)
+    return;
+
+  // Without clipping, a primitive crossing the eye plane can only be bounded by the scissor.
+  if (any_behind)
+  {
+    AddScreenRect(std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max(),
+                  std::numeric_limits<float>::lowest(), std::numeric_limits<float>::max(),
+                  scissors, bbox);
+    return;
+  }
+
+  AddScreenRect(min_x - half_width, max_x + half_width, min_y - half_width, max_y + half_width,
+                scissors, bbox);
+}
+
+static bool IsTriangleCulled(const CPUCull::TransformedVertex& a,
+                             const CPUCull::TransformedVertex& b,
+                             const CPUCull::TransformedVertex& c, CullMode mode)
+{
+  // See videosoftware Clipper.cpp:IsBackface
+  const float normal_z_dir = (c.w * a.x - a.w * c.x) * b.y +  //
+                             (c.x * a.y - a.x * c.y) * b.w +  //
+                             (c.y * a.w - a.y * c.w) * b.x;
+  switch (mode)
+  {
+  case CullMode::None:
+    return normal_z_dir == 0;
+  case CullMode::Front:
+    return normal_z_dir <= 0;
+  case CullMode::Back:
+    return normal_z_dir >= 0;
+  case CullMode::All:
+  default:
+    return true;
+  }
+}
+
+bool CPUCull::ComputeBoundingBox(const TransformedVertex* transformed, u32 count,
+                                 OpcodeDecoder::Primitive primitive, CullMode cullmode,
+                                 const Viewport& viewport, float half_width,
+                                 std::span<const BPFunctions::ScissorRect> scissors,
+                                 std::array<u16, 4>* bbox)
+{
+  using Prim = OpcodeDecoder::Primitive;
+
+  ScreenBoundingBox screen_bbox;
+  if (primitive == Prim::GX_DRAW_POINTS)
+  {
+    for (u32 i = 0; i < count; i++)
+    {
+      const std::array<const TransformedVertex*, 1> vertex = {&transformed[i]};
+      AddVertices(vertex, viewport, half_width, scissors, &screen_bbox);
+    }
+  }
+  else if (primitive >= Prim::GX_DRAW_LINES)
+  {
+    // Each segment is bounded as a whole before it is clamped to the scissor, so a line that
+    // crosses the scissor rectangle counts even if both of its ends are outside of it.
+    const u32 step = primitive == Prim::GX_DRAW_LINES ? 2 : 1;
+    for (u32 i = 1; i < count; i += step)
+    {
+      const std::array<const TransformedVertex*, 2> segment = {&transformed[i - 1],
+                                                               &transformed[i]};
+      AddVertices(segment, viewport, half_width, scissors, &screen_bbox);
+    }
+  }
+  else
+  {
+    static constexpr Common::EnumMap<CullMode, CullMode::All> cullmode_invert = {
+        CullMode::None, CullMode::Front, CullMode::Back, CullMode::All};
+    if (viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
+      cullmode = cullmode_invert[cullmode];
+
+    const auto add_triangle = [&](const TransformedVertex& a, const TransformedVertex& b,
+                                  const TransformedVertex& c) {
+      if (IsTriangleCulled(a, b, c, cullmode))
+        return;
+
+      const std::array<const TransformedVertex*, 3> vertices = {&a, &b, &c};
+      AddVertices(vertices, viewport, 0.0f, scissors, &screen_bbox);
+    };
+
+    // Same triangle decomposition as AreAllVerticesCulled.
+    switch (primitive)
+    {
+    case Prim::GX_DRAW_QUADS:
+    case Prim::GX_DRAW_QUADS_2:
+    {
+      u32 i = 3;
+      for (; i < count; i += 4)
+      {
+        add_triangle(transformed[i - 3], transformed[i - 2], transformed[i - 1]);
+        add_triangle(transformed[i - 3], transformed[i - 1], transformed[i - 0]);
+      }
+      // three vertices remaining, so render a triangle
+      if (i == count)
+        add_triangle(transformed[i - 3], transformed[i - 2], transformed[i - 1]);
+      break;
+    }
+    case Prim::GX_DRAW_TRIANGLES:
+      for (u32 i = 2; i < count; i += 3)
+        add_triangle(transformed[i - 2], transformed[i - 1], transformed[i - 0]);
+      break;
+    case Prim::GX_DRAW_TRIANGLE_STRIP:
+    {
+      bool wind = false;
+      for (u32 i = 2; i < count; ++i)
+      {
+        add_triangle(transformed[i - 2], transformed[i - !wind], transformed[i - wind]);
+        wind = !wind;
+      }
+      break;
+    }
+    case Prim::GX_DRAW_TRIANGLE_FAN:
+      for (u32 i = 2; i < count; ++i)
+        add_triangle(transformed[0], transformed[i - 1], transformed[i]);
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (screen_bbox.left > screen_bbox.right)
+    return false;
+
+  (*bbox)[0] = static_cast<u16>(screen_bbox.left);
+  (*bbox)[1] = static_cast<u16>(screen_bbox.right);
+  (*bbox)[2] = static_cast<u16>(screen_bbox.top);
+  (*bbox)[3] = static_cast<u16>(screen_bbox.bottom);
+  return true;
+}
+
 template <typename T>
 void CPUCull::BufferDeleter<T>::operator()(T* ptr)
 {
@@ -3,23 +3,47 @@
 
 #pragma once
 
+#include <array>
+#include <span>
+
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
 
+namespace BPFunctions
+{
+struct ScissorRect;
+}
+struct Viewport;
+
 class CPUCull
 {
 public:
   ~CPUCull();
   void Init();
-  bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
-                            const u8* src, u32 count);
+
+  // Transforms the vertices to clip space for AreAllVerticesCulled and UpdateBoundingBox, which
+  // both work on the vertices last passed to this.
+  void TransformVertices(VertexLoaderBase* loader, const u8* src, u32 count);
+  bool AreAllVerticesCulled(OpcodeDecoder::Primitive primitive, u32 count) const;
+
+  // Extends g_bounding_box with the area the vertices cover.
+  void UpdateBoundingBox(OpcodeDecoder::Primitive primitive, u32 count) const;
 
   struct alignas(16) TransformedVertex
   {
     float x, y, z, w;
   };
 
+  // Conservatively computes the bounding box (left, right, top, bottom) of the pixels covered by
+  // the given clip space vertices, using the same setup as the software rasterizer and rounded to
+  // 2x2 pixel quads like the hardware.  Returns false if no pixels are covered.
+  static bool ComputeBoundingBox(const TransformedVertex* transformed, u32 count,
+                                 OpcodeDecoder::Primitive primitive, CullMode cullmode,
+                                 const Viewport& viewport, float half_width,
+                                 std::span<const BPFunctions::ScissorRect> scissors,
+                                 std::array<u16, 4>* bbox);
+
   using TransformFunction = void (*)(void*, const void*, u32, int);
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
 
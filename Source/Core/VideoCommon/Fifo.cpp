@@ -98,6 +98,7 @@ void FifoManager::Init()
   if (m_system.IsDualCoreMode())
     m_gpu_mainloop.Prepare();
   m_sync_ticks.store(0);
+  m_sync_gpu_counts.fill(0);
 }
 
 void FifoManager::Shutdown()
@@ -105,6 +106,8 @@ void FifoManager::Shutdown()
   if (m_gpu_mainloop.IsRunning())
     PanicAlertFmt("FIFO shutting down while active");
 
+  LogSyncGPUCounts();
+
   Common::FreeMemoryPages(m_video_buffer, FIFO_SIZE + 4);
   m_video_buffer = nullptr;
   m_video_buffer_write_ptr = nullptr;
@@ -146,10 +149,26 @@ void FifoManager::EmulatorState(bool running)
     m_gpu_mainloop.AllowSleep();
 }
 
+void FifoManager::LogSyncGPUCounts() const
+{
+  for (size_t i = 0; i < m_sync_gpu_counts.size(); ++i)
+  {
+    const auto reason = static_cast<SyncGPUReason>(i);
+    if (m_sync_gpu_counts[reason] != 0)
+      INFO_LOG_FMT(VIDEO, "GPU thread syncs for {}: {}", reason, m_sync_gpu_counts[reason]);
+  }
+}
+
 void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (m_use_deterministic_gpu_thread)
   {
+    // All state the CPU can observe through GP registers is produced while preprocessing the FIFO
+    // on the CPU thread, so register accesses don't depend on how far the GPU thread has come.
+    if (reason == SyncGPUReason::RegisterAccess && m_observable_sync_only)
+      return;
+
+    ++m_sync_gpu_counts[reason];
     m_gpu_mainloop.Wait();
     if (!m_gpu_mainloop.IsRunning())
       return;
@@ -507,11 +526,16 @@ void FifoManager::UpdateWantDeterminism(bool want)
   // We are paused (or not running at all yet), so
   // it should be safe to change this.
   bool gpu_thread = false;
+  m_observable_sync_only = false;
   switch (Config::GetGPUDeterminismMode())
   {
   case Config::GPUDeterminismMode::Auto:
     gpu_thread = want;
     break;
+  case Config::GPUDeterminismMode::ObservableSync:
+    gpu_thread = want;
+    m_observable_sync_only = true;
+    break;
   case Config::GPUDeterminismMode::Disabled:
     gpu_thread = false;
     break;
@@ -586,7 +610,7 @@ void FifoManager::SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLat
 
 void FifoManager::SyncGPUForRegisterAccess()
 {
-  SyncGPU(SyncGPUReason::Other);
+  SyncGPU(SyncGPUReason::RegisterAccess);
 
   if (!m_system.IsDualCoreMode() || m_use_deterministic_gpu_thread)
     RunGpuOnCpu(GPU_TIME_SLOT_SIZE);
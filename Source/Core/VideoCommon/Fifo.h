@@ -10,6 +10,8 @@
 #include "Common/BlockingLoop.h"
 #include "Common/CommonTypes.h"
 #include "Common/Config/Config.h"
+#include "Common/EnumFormatter.h"
+#include "Common/EnumMap.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 
@@ -36,6 +38,8 @@ enum class SyncGPUReason
   BBox,
   Swap,
   AuxSpace,
+  EFBPeek,
+  RegisterAccess,
 };
 
 class FifoManager final
@@ -60,6 +64,9 @@ public:
   // In deterministic GPU thread mode this waits for the GPU to be done with pending work.
   void SyncGPU(SyncGPUReason reason, bool may_move_read_ptr = true);
 
+  // Number of times the CPU thread waited for the GPU thread in deterministic GPU thread mode.
+  u64 GetSyncGPUCount(SyncGPUReason reason) const { return m_sync_gpu_counts[reason]; }
+
   // In single core mode, this runs the GPU for a single slice.
   // In dual core mode, this synchronizes with the GPU thread.
   void SyncGPUForRegisterAccess();
@@ -77,6 +84,7 @@ public:
 
 private:
   void RefreshConfig();
+  void LogSyncGPUCounts() const;
   void ReadDataFromFifo(u32 read_ptr);
   void ReadDataFromFifoOnCPU(u32 read_ptr);
   int RunGpuOnCpu(int ticks);
@@ -97,6 +105,10 @@ private:
   // This could be in SConfig, but it depends on multiple settings
   // and can change at runtime.
   bool m_use_deterministic_gpu_thread = false;
+  // Only sync with the GPU thread when the CPU needs rendering results.
+  bool m_observable_sync_only = false;
+
+  Common::EnumMap<u64, SyncGPUReason::RegisterAccess> m_sync_gpu_counts{};
 
   CoreTiming::EventType* m_event_sync_gpu = nullptr;
 
@@ -133,3 +145,13 @@ private:
 
 bool AtBreakpoint(Core::System& system);
 }  // namespace Fifo
+
+template <>
+struct fmt::formatter<Fifo::SyncGPUReason> : EnumFormatter<Fifo::SyncGPUReason::RegisterAccess>
+{
+  constexpr formatter()
+      : EnumFormatter({"Other", "Wraparound", "EFB poke", "Perf query", "Bounding box", "Swap",
+                       "Aux space", "EFB peek", "Register access"})
+  {
+  }
+};
@@ -8,8 +8,11 @@
 #endif
 
 #include <array>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <fmt/chrono.h>
 #include <fmt/format.h>
@@ -25,6 +28,7 @@ extern "C" {
 #include <libswscale/swscale.h>
 }
 
+#include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/FileUtil.h"
 #include "Common/Logging/Log.h"
@@ -40,17 +44,26 @@ extern "C" {
 
 #include "VideoCommon/FrameDumper.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/VideoConfig.h"
 
+// Maximum number of converted frames waiting to be encoded.
+static constexpr size_t MAX_QUEUED_ENCODE_FRAMES = 3;
+
 struct FrameDumpContext
 {
   AVFormatContext* format = nullptr;
   AVStream* stream = nullptr;
   AVCodecContext* codec = nullptr;
   AVFrame* src_frame = nullptr;
-  AVFrame* scaled_frame = nullptr;
   SwsContext* sws = nullptr;
 
+  // Converted frames which are not queued for encoding.
+  std::vector<AVFrame*> free_frames;
+  size_t allocated_frames = 0;
+  std::mutex frames_lock;
+  std::condition_variable frame_released;
+
   s64 last_pts = AV_NOPTS_VALUE;
 
   int width = 0;
@@ -300,14 +313,12 @@ bool FFMpegFrameDump::CreateVideoFile()
   }
 
   m_context->src_frame = av_frame_alloc();
-  m_context->scaled_frame = av_frame_alloc();
-
-  m_context->scaled_frame->format = m_context->codec->pix_fmt;
-  m_context->scaled_frame->width = m_context->width;
-  m_context->scaled_frame->height = m_context->height;
 
-  if (av_frame_get_buffer(m_context->scaled_frame, 1))
+  // Make sure that at least one frame can be allocated for the conversion.
+  AVFrame* const scaled_frame = AcquireScaledFrame();
+  if (!scaled_frame)
     return false;
+  ReleaseScaledFrame(scaled_frame);
 
   m_context->stream = avformat_new_stream(m_context->format, codec);
   if (!m_context->stream ||
@@ -333,11 +344,60 @@ bool FFMpegFrameDump::CreateVideoFile()
                  m_context->stream->time_base.num);
   }
 
+  m_encode_thread.Reset("FrameDumpEncoder", [this](AVFrame* frame) { EncodeFrame(frame); });
+
   OSD::AddMessage(fmt::format("Dumping Frames to \"{}\" ({}x{})", dump_path, m_context->width,
                               m_context->height));
   return true;
 }
 
+AVFrame* FFMpegFrameDump::AcquireScaledFrame()
+{
+  std::unique_lock lk(m_context->frames_lock);
+
+  if (m_context->free_frames.empty() && m_context->allocated_frames < MAX_QUEUED_ENCODE_FRAMES)
+  {
+    AVFrame* frame = av_frame_alloc();
+    if (!frame)
+      return nullptr;
+
+    frame->format = m_context->codec->pix_fmt;
+    frame->width = m_context->width;
+    frame->height = m_context->height;
+
+    if (av_frame_get_buffer(frame, 1))
+    {
+      av_frame_free(&frame);
+      return nullptr;
+    }
+
+    ++m_context->allocated_frames;
+    return frame;
+  }
+
+  m_context->frame_released.wait(lk, [this] { return !m_context->free_frames.empty(); });
+  AVFrame* const frame = m_context->free_frames.back();
+  m_context->free_frames.pop_back();
+
+  // The encoder may still hold a reference to the previous contents.
+  if (av_frame_make_writable(frame))
+  {
+    m_context->free_frames.push_back(frame);
+    return nullptr;
+  }
+
+  return frame;
+}
+
+void FFMpegFrameDump::ReleaseScaledFrame(AVFrame* frame)
+{
+  {
+    std::lock_guard lk(m_context->frames_lock);
+    m_context->free_frames.push_back(frame);
+  }
+  m_context->frame_released.notify_one();
+}
+
 bool FFMpegFrameDump::IsFirstFrameInCurrentFile() const
 {
   return m_context->last_pts == AV_NOPTS_VALUE;
@@ -366,6 +426,7 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
     if (pts <= m_context->last_pts)
     {
       WARN_LOG_FMT(FRAMEDUMP, "PTS delta < 1. Current frame will not be dumped.");
+      g_perf_metrics.CountFrameDumpDropped();
       return;
     }
     else if (pts > m_context->last_pts + 1 && !m_context->gave_vfr_warning)
@@ -384,6 +445,14 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
   m_context->src_frame->width = m_context->width;
   m_context->src_frame->height = m_context->height;
 
+  AVFrame* const scaled_frame = AcquireScaledFrame();
+  if (!scaled_frame)
+  {
+    ERROR_LOG_FMT(FRAMEDUMP, "Could not allocate frame for encoding");
+    g_perf_metrics.CountFrameDumpDropped();
+    return;
+  }
+
   // Convert image from RGBA to desired pixel format.
   m_context->sws = sws_getCachedContext(
       m_context->sws, frame.width, frame.height, pix_fmt, m_context->width, m_context->height,
@@ -391,15 +460,24 @@ void FFMpegFrameDump::AddFrame(const FrameData& frame)
   if (m_context->sws)
   {
     sws_scale(m_context->sws, m_context->src_frame->data, m_context->src_frame->linesize, 0,
-              frame.height, m_context->scaled_frame->data, m_context->scaled_frame->linesize);
+              frame.height, scaled_frame->data, scaled_frame->linesize);
   }
 
   m_context->last_pts = pts;
-  m_context->scaled_frame->pts = pts;
+  scaled_frame->pts = pts;
+
+  m_encode_thread.Push(scaled_frame);
+}
 
-  if (const int error = avcodec_send_frame(m_context->codec, m_context->scaled_frame))
+void FFMpegFrameDump::EncodeFrame(AVFrame* frame)
+{
+  const int error = avcodec_send_frame(m_context->codec, frame);
+  ReleaseScaledFrame(frame);
+
+  if (error)
   {
     ERROR_LOG_FMT(FRAMEDUMP, "Error while encoding video: {}", AVErrorString(error));
+    g_perf_metrics.CountFrameDumpDropped();
     return;
   }
 
@@ -449,6 +527,9 @@ void FFMpegFrameDump::Stop()
   if (!IsStarted())
     return;
 
+  // Wait for all queued frames to be encoded.
+  m_encode_thread.Shutdown();
+
   // Signal end of stream to encoder.
   if (const int flush_error = avcodec_send_frame(m_context->codec, nullptr))
     WARN_LOG_FMT(FRAMEDUMP, "Error sending flush packet: {}", AVErrorString(flush_error));
@@ -469,7 +550,10 @@ bool FFMpegFrameDump::IsStarted() const
 void FFMpegFrameDump::CloseVideoFile()
 {
   av_frame_free(&m_context->src_frame);
-  av_frame_free(&m_context->scaled_frame);
+
+  ASSERT(m_context->free_frames.size() == m_context->allocated_frames);
+  for (AVFrame*& frame : m_context->free_frames)
+    av_frame_free(&frame);
 
   avcodec_free_context(&m_context->codec);
 
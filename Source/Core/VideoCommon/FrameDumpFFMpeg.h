@@ -7,7 +7,9 @@
 #include <memory>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 
+struct AVFrame;
 struct FrameDumpContext;
 class PointerWrap;
 
@@ -52,8 +54,19 @@ private:
   void CheckForConfigChange(const FrameData&);
   void ProcessPackets();
 
+  // Returns a frame the converted image can be written to, waiting if too many frames are already
+  // queued for encoding.
+  AVFrame* AcquireScaledFrame();
+  void ReleaseScaledFrame(AVFrame* frame);
+
+  // Called on the encoder thread.
+  void EncodeFrame(AVFrame* frame);
+
 #if defined(HAVE_FFMPEG)
   std::unique_ptr<FrameDumpContext> m_context;
+
+  // Runs the encoder so that it can overlap with the pixel format conversion of the next frame.
+  Common::WorkQueueThread<AVFrame*> m_encode_thread;
 #endif
 
   // Used for FetchState:
@@ -15,6 +15,7 @@
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/OnScreenDisplay.h"
+#include "VideoCommon/PerformanceMetrics.h"
 #include "VideoCommon/Present.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -69,6 +70,13 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
                                                  m_frame_dump_readback_texture->GetRect());
   m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
   m_frame_dump_needs_flush = true;
+
+  if (m_last_frame_screenshot_name.empty() && m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
+    m_last_frame_screenshot_name = std::move(m_screenshot_name);
+    m_screenshot_name.clear();
+  }
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -105,7 +113,17 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
+  // Reuse a texture which has already been dumped, dropping any which are the wrong size.
   rbtex.reset();
+  ReclaimFrameDumpTextures(false);
+  while (!m_frame_dump_free_textures.empty())
+  {
+    rbtex = std::move(m_frame_dump_free_textures.back());
+    m_frame_dump_free_textures.pop_back();
+    if (rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
+      return true;
+  }
+
   rbtex = g_gfx->CreateStagingTexture(StagingTextureType::Readback,
                                       TextureConfig(target_width, target_height, 1, 1, 1,
                                                     AbstractTextureFormat::RGBA8, 0,
@@ -118,43 +136,74 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
 
 void FrameDumper::FlushFrameDump()
 {
+  if (!m_frame_dump_needs_flush && !m_frame_dump_copied_texture)
+    return;
+
+  // Screenshots are not delayed, as another frame may never be rendered.
+  QueueFrameDumpReadbacks(m_last_frame_screenshot_name.empty());
+
+  // Shutdown frame dumping if it is no longer active.
+  if (!IsFrameDumping())
+    ShutdownFrameDumping();
+}
+
+void FrameDumper::QueueFrameDumpReadbacks(bool delay_current_frame)
+{
+  // The GPU should have finished the copy for the previous frame by now.
+  QueueCopiedFrame();
+
   if (!m_frame_dump_needs_flush)
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
+  m_frame_dump_copied_texture = std::move(m_frame_dump_readback_texture);
+  m_frame_dump_copied_state = m_last_frame_state;
+  m_frame_dump_copied_screenshot_name = std::move(m_last_frame_screenshot_name);
+  m_last_frame_screenshot_name.clear();
+  m_frame_dump_needs_flush = false;
+
+  if (!delay_current_frame)
+    QueueCopiedFrame();
+}
+
+void FrameDumper::QueueCopiedFrame()
+{
+  if (!m_frame_dump_copied_texture)
+    return;
 
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
+  // Only wait for the dumping thread if it has fallen too far behind.
+  ReclaimFrameDumpTextures(false);
+  if (m_frame_dump_output_textures.size() >= MAX_QUEUED_FRAMES)
+  {
+    g_perf_metrics.CountFrameDumpLate();
+    ReclaimFrameDumpTextures(true);
+  }
 
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
+  auto& texture = m_frame_dump_copied_texture;
+  texture->Flush();
+  if (texture->Map())
   {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
+    DumpFrameData(reinterpret_cast<u8*>(texture->GetMappedPointer()), texture->GetConfig().width,
+                  texture->GetConfig().height, static_cast<int>(texture->GetMappedStride()),
+                  m_frame_dump_copied_state, std::move(m_frame_dump_copied_screenshot_name));
+    m_frame_dump_output_textures.push_back(std::move(texture));
   }
   else
   {
     ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    m_frame_dump_free_textures.push_back(std::move(texture));
   }
-
-  m_frame_dump_needs_flush = false;
-
-  // Shutdown frame dumping if it is no longer active.
-  if (!IsFrameDumping())
-    ShutdownFrameDumping();
+  m_frame_dump_copied_screenshot_name.clear();
 }
 
 void FrameDumper::ShutdownFrameDumping()
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  // Ensure the last readbacks have been sent to the encoder.
+  QueueFrameDumpReadbacks(false);
 
   if (!m_frame_dump_thread_running.IsSet())
     return;
 
-  // Ensure previous frame has been encoded.
+  // Ensure previous frames have been encoded.
   FinishFrameData();
 
   // Wake thread up, and wait for it to exit.
@@ -166,12 +215,18 @@ void FrameDumper::ShutdownFrameDumping()
   m_frame_dump_render_texture.reset();
 
   m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+  m_frame_dump_free_textures.clear();
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride, const FrameState& state,
+                                std::string screenshot_name)
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
+  {
+    std::lock_guard lk(m_frame_dump_queue_lock);
+    m_frame_dump_queue.push(QueuedFrame{FrameData{data, w, h, stride, state},
+                                        std::move(screenshot_name)});
+  }
+  ++m_frame_dump_frames_queued;
 
   if (!m_frame_dump_thread_running.IsSet())
   {
@@ -183,18 +238,35 @@ void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
 
   // Wake worker thread up.
   m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
 }
 
-void FrameDumper::FinishFrameData()
+void FrameDumper::ReclaimFrameDumpTextures(bool wait)
 {
-  if (!m_frame_dump_frame_running)
-    return;
+  auto& outputs = m_frame_dump_output_textures;
+
+  // The output textures hold the most recently queued frames, in order.
+  if (wait && !outputs.empty())
+  {
+    const u64 oldest_frame = m_frame_dump_frames_queued - outputs.size();
+    while (m_frame_dump_frames_done.load() <= oldest_frame)
+      m_frame_dump_done.Wait();
+  }
 
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
+  const u64 frames_done = m_frame_dump_frames_done.load();
+  while (!outputs.empty() && m_frame_dump_frames_queued - outputs.size() < frames_done)
+  {
+    outputs.front()->Unmap();
+    m_frame_dump_free_textures.push_back(std::move(outputs.front()));
+    outputs.pop_front();
+  }
+}
+
+void FrameDumper::FinishFrameData()
+{
+  while (m_frame_dump_frames_done.load() < m_frame_dump_frames_queued)
+    m_frame_dump_done.Wait();
 
-  m_frame_dump_output_texture->Unmap();
+  ReclaimFrameDumpTextures(false);
 }
 
 void FrameDumper::FrameDumpThreadFunc()
@@ -220,46 +292,54 @@ void FrameDumper::FrameDumpThreadFunc()
     if (!m_frame_dump_thread_running.IsSet())
       break;
 
-    auto frame = m_frame_dump_data;
-
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
+    while (true)
     {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
-
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
-
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+      QueuedFrame queued_frame;
+      {
+        std::lock_guard lk(m_frame_dump_queue_lock);
+        if (m_frame_dump_queue.empty())
+          break;
+        queued_frame = std::move(m_frame_dump_queue.front());
+        m_frame_dump_queue.pop();
+      }
+      const FrameData& frame = queued_frame.frame;
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
-    {
-      if (!frame_dump_started)
+      // Save screenshot
+      if (!queued_frame.screenshot_name.empty())
       {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
+        if (DumpFrameToPNG(frame, queued_frame.screenshot_name))
+          OSD::AddMessage("Screenshot saved to " + queued_frame.screenshot_name);
 
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        m_screenshot_completed.Set();
       }
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
+      if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
       {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
+        if (!frame_dump_started)
+        {
+          if (dump_to_ffmpeg)
+            frame_dump_started = StartFrameDumpToFFMPEG(frame);
+          else
+            frame_dump_started = StartFrameDumpToImage(frame);
+
+          // Stop frame dumping if we fail to start.
+          if (!frame_dump_started)
+            Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+        }
+
+        // If we failed to start frame dumping, don't write a frame.
+        if (frame_dump_started)
+        {
+          if (dump_to_ffmpeg)
+            DumpFrameToFFMPEG(frame);
+          else
+            DumpFrameToImage(frame);
+        }
       }
-    }
 
-    m_frame_dump_done.Set();
+      m_frame_dump_frames_done.fetch_add(1);
+      m_frame_dump_done.Set();
+    }
   }
 
   if (frame_dump_started)
@@ -348,8 +428,11 @@ void FrameDumper::SaveScreenshot(std::string filename)
 
 bool FrameDumper::IsFrameDumping() const
 {
-  if (m_screenshot_request.IsSet())
+  if (m_screenshot_request.IsSet() || !m_last_frame_screenshot_name.empty() ||
+      !m_frame_dump_copied_screenshot_name.empty())
+  {
     return true;
+  }
 
   if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
     return true;
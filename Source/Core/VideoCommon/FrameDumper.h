@@ -3,6 +3,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
@@ -55,12 +62,28 @@ private:
   // Checks that the frame dump readback texture exists and is the correct size.
   bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
 
+  // Queues the previously copied frame for dumping and marks the current readback as copied.
+  // If delay_current_frame is not set, the current readback is queued immediately as well.
+  void QueueFrameDumpReadbacks(bool delay_current_frame);
+
+  // Maps the copied readback texture and queues it for the dumping thread.
+  void QueueCopiedFrame();
+
   // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  void DumpFrameData(const u8* data, int w, int h, int stride, const FrameState& state,
+                     std::string screenshot_name);
+
+  // Unmaps output textures whose frames have been dumped so they can be reused.
+  // If wait is set, blocks until at least the oldest queued frame has been dumped.
+  void ReclaimFrameDumpTextures(bool wait);
 
   // Ensures all encoded frames have been written to the output file.
   void FinishFrameData();
 
+  // Number of frames which can be queued for the dumping thread before the video thread has to
+  // wait for it to catch up.
+  static constexpr size_t MAX_QUEUED_FRAMES = 4;
+
   std::thread m_frame_dump_thread;
   Common::Flag m_frame_dump_thread_running;
 
@@ -72,28 +95,47 @@ private:
 
   // Holds emulation state during the last swap when dumping.
   FrameState m_last_frame_state;
+  // Where to save the last frame as a screenshot, if one was requested before it was rendered.
+  std::string m_last_frame_screenshot_name;
+
+  struct QueuedFrame
+  {
+    FrameData frame;
+    std::string screenshot_name;
+  };
 
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Communication of frames between video and dump threads.
+  std::mutex m_frame_dump_queue_lock;
+  std::queue<QueuedFrame> m_frame_dump_queue;
+  u64 m_frame_dump_frames_queued = 0;
+  std::atomic<u64> m_frame_dump_frames_done = 0;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
+  // Ring of readback textures:
+  // Texture the current frame is copied to.
   std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
   // Set when readback texture holds a frame that needs to be dumped.
   bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // Texture holding the previous frame. It is only mapped one frame later so that the GPU has had
+  // time to finish the copy, which avoids stalling the video thread on the readback.
+  std::unique_ptr<AbstractStagingTexture> m_frame_dump_copied_texture;
+  FrameState m_frame_dump_copied_state;
+  std::string m_frame_dump_copied_screenshot_name;
+  // Mapped textures queued for the dumping thread, oldest first.
+  std::deque<std::unique_ptr<AbstractStagingTexture>> m_frame_dump_output_textures;
+  // Unmapped textures which can be reused for readback.
+  std::vector<std::unique_ptr<AbstractStagingTexture>> m_frame_dump_free_textures;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
 
   FFMpegFrameDump m_ffmpeg_dump;
 
-  // Screenshots
+  // Screenshots. A request is taken by the next frame that is rendered, so that frames which were
+  // already queued for the dumping thread don't end up in it.
   Common::Flag m_screenshot_request;
   Common::Event m_screenshot_completed;
   std::mutex m_screenshot_lock;
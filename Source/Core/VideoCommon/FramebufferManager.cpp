@@ -398,7 +398,11 @@ bool FramebufferManager::ReinterpretPixelData(EFBReinterpretType convtype)
   std::swap(m_efb_color_texture, m_efb_convert_color_texture);
   std::swap(m_efb_framebuffer, m_efb_convert_framebuffer);
   g_gfx->EndUtilityDrawing();
-  InvalidatePeekCache(true);
+
+  // The predictive cache keeps serving the previous frame until it is replaced at end of frame,
+  // rather than mixing that snapshot with readbacks of the converted EFB.
+  if (!g_ActiveConfig.bEFBAccessPredictive)
+    InvalidatePeekCache(true);
   return true;
 }
 
@@ -520,9 +524,21 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
 
 void FramebufferManager::SetEFBCacheTileSize(u32 size)
 {
+  m_pending_efb_cache_tile_size.reset();
   if (m_efb_cache_tile_size == size)
     return;
 
+  if (g_ActiveConfig.bEFBAccessPredictive)
+  {
+    m_pending_efb_cache_tile_size = size;
+    return;
+  }
+
+  ApplyEFBCacheTileSize(size);
+}
+
+void FramebufferManager::ApplyEFBCacheTileSize(u32 size)
+{
   InvalidatePeekCache(true);
   m_efb_cache_tile_size = size;
   DestroyReadbackFramebuffer();
@@ -598,6 +614,10 @@ void FramebufferManager::InvalidatePeekCache(bool forced)
 
 void FramebufferManager::FlagPeekCacheAsOutOfDate()
 {
+  // The predictive cache holds the previous frame's contents and is only replaced at end of frame.
+  if (g_ActiveConfig.bEFBAccessPredictive)
+    return;
+
   if (m_efb_color_cache.has_active_tiles)
     m_efb_color_cache.out_of_date = true;
   if (m_efb_depth_cache.has_active_tiles)
@@ -609,11 +629,26 @@ void FramebufferManager::FlagPeekCacheAsOutOfDate()
 
 void FramebufferManager::EndOfFrame()
 {
+  if (m_pending_efb_cache_tile_size)
+  {
+    ApplyEFBCacheTileSize(*m_pending_efb_cache_tile_size);
+    m_pending_efb_cache_tile_size.reset();
+  }
+
   for (u32 i = 0; i < m_efb_color_cache.tiles.size(); i++)
   {
     m_efb_color_cache.tiles[i].frame_access_mask <<= 1;
     m_efb_depth_cache.tiles[i].frame_access_mask <<= 1;
   }
+
+  // In predictive mode, peeks during the next frame are served from a snapshot of the tiles that
+  // were accessed recently. The readback is queued now so it has completed by the time the CPU
+  // peeks, rather than stalling on a GPU sync for each invalidated tile.
+  if (g_ActiveConfig.bEFBAccessPredictive)
+  {
+    InvalidatePeekCache(true);
+    RefreshPeekCache();
+  }
 }
 
 bool FramebufferManager::CompileReadbackPipelines()
@@ -1009,36 +1044,37 @@ void FramebufferManager::CreatePokeVertices(std::vector<EFBPokeVertex>* destinat
 
 void FramebufferManager::FlushEFBPokes()
 {
-  if (!m_color_poke_vertices.empty())
-  {
-    DrawPokeVertices(m_color_poke_vertices.data(), static_cast<u32>(m_color_poke_vertices.size()),
-                     m_color_poke_pipeline.get());
-    m_color_poke_vertices.clear();
-  }
+  if (m_color_poke_vertices.empty() && m_depth_poke_vertices.empty())
+    return;
 
-  if (!m_depth_poke_vertices.empty())
-  {
-    DrawPokeVertices(m_depth_poke_vertices.data(), static_cast<u32>(m_depth_poke_vertices.size()),
-                     m_depth_poke_pipeline.get());
-    m_depth_poke_vertices.clear();
-  }
-}
+  // Upload both kinds of pokes at once. They still take a draw each, as color pokes must not write
+  // depth and depth pokes must not write color, which needs different pipelines.
+  const u32 color_vertex_count = static_cast<u32>(m_color_poke_vertices.size());
+  const u32 depth_vertex_count = static_cast<u32>(m_depth_poke_vertices.size());
+  m_color_poke_vertices.insert(m_color_poke_vertices.end(), m_depth_poke_vertices.begin(),
+                               m_depth_poke_vertices.end());
 
-void FramebufferManager::DrawPokeVertices(const EFBPokeVertex* vertices, u32 vertex_count,
-                                          const AbstractPipeline* pipeline)
-{
-  // Copy to vertex buffer.
   g_gfx->BeginUtilityDrawing();
   u32 base_vertex, base_index;
-  g_vertex_manager->UploadUtilityVertices(vertices, sizeof(EFBPokeVertex),
-                                          static_cast<u32>(vertex_count), nullptr, 0, &base_vertex,
-                                          &base_index);
+  g_vertex_manager->UploadUtilityVertices(m_color_poke_vertices.data(), sizeof(EFBPokeVertex),
+                                          color_vertex_count + depth_vertex_count, nullptr, 0,
+                                          &base_vertex, &base_index);
 
-  // Now we can draw.
   g_gfx->SetViewportAndScissor(m_efb_framebuffer->GetRect());
-  g_gfx->SetPipeline(pipeline);
-  g_gfx->Draw(base_vertex, vertex_count);
+  if (color_vertex_count != 0)
+  {
+    g_gfx->SetPipeline(m_color_poke_pipeline.get());
+    g_gfx->Draw(base_vertex, color_vertex_count);
+  }
+  if (depth_vertex_count != 0)
+  {
+    g_gfx->SetPipeline(m_depth_poke_pipeline.get());
+    g_gfx->Draw(base_vertex + color_vertex_count, depth_vertex_count);
+  }
   g_gfx->EndUtilityDrawing();
+
+  m_color_poke_vertices.clear();
+  m_depth_poke_vertices.clear();
 }
 
 bool FramebufferManager::CompilePokePipelines()
@@ -171,6 +171,7 @@ protected:
 
   bool CreateReadbackFramebuffer();
   void DestroyReadbackFramebuffer();
+  void ApplyEFBCacheTileSize(u32 size);
 
   bool CompileClearPipelines();
   void DestroyClearPipelines();
@@ -186,9 +187,6 @@ protected:
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
 
-  void DrawPokeVertices(const EFBPokeVertex* vertices, u32 vertex_count,
-                        const AbstractPipeline* pipeline);
-
   std::tuple<u32, u32> CalculateTargetSize();
 
   void DoLoadState(PointerWrap& p);
@@ -224,6 +222,9 @@ protected:
   u32 m_efb_cache_tile_size = 0;
   // Number of tiles that make up a row in m_efb_color_cache.tiles / m_efb_depth_cache.tiles.
   u32 m_efb_cache_tile_row_stride = 1;
+  // In predictive mode, tile size changes wait for the end of the frame, as they throw away the
+  // snapshot that peeks are served from.
+  std::optional<u32> m_pending_efb_cache_tile_size;
   EFBCacheData m_efb_color_cache = {};
   EFBCacheData m_efb_depth_cache = {};
 
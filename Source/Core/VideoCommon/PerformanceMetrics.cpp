@@ -8,6 +8,7 @@
 #include <imgui.h>
 #include <implot.h>
 
+#include "Core/Config/MainSettings.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/System.h"
@@ -22,6 +23,13 @@ void PerformanceMetrics::Reset()
   m_speed_counter.Reset();
 
   m_time_sleeping = DT::zero();
+  m_frame_dump_late_count = 0;
+  m_frame_dump_dropped_count = 0;
+  for (auto& bucket : m_audio_callback_histogram)
+    bucket.store(0, std::memory_order_relaxed);
+  m_audio_callback_count = 0;
+  m_audio_underrun_count = 0;
+  m_audio_latency_ms = 0.0;
   m_real_times.fill(Clock::now());
   m_cpu_times.fill(Core::System::GetInstance().GetCoreTiming().GetCPUTimePoint(0));
 }
@@ -52,6 +60,43 @@ void PerformanceMetrics::CountPerformanceMarker(Core::System& system, s64 cycles
   m_time_index += 1;
 }
 
+void PerformanceMetrics::CountFrameDumpLate()
+{
+  m_frame_dump_late_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountFrameDumpDropped()
+{
+  m_frame_dump_dropped_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::CountAudioCallback(DT duration)
+{
+  const u64 us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  size_t bucket = 0;
+  while (bucket < AUDIO_CALLBACK_BUCKETS - 1 && us >= u64(AUDIO_CALLBACK_FIRST_BUCKET_US) << bucket)
+    ++bucket;
+  m_audio_callback_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+
+  // Only one caller gets to decay the histogram, even if callbacks are counted concurrently
+  const u64 count = m_audio_callback_count.fetch_add(1, std::memory_order_relaxed) + 1;
+  if (count % AUDIO_CALLBACK_DECAY_INTERVAL == 0)
+  {
+    for (auto& entry : m_audio_callback_histogram)
+      entry.fetch_sub(entry.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+  }
+}
+
+void PerformanceMetrics::CountAudioUnderrun()
+{
+  m_audio_underrun_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PerformanceMetrics::SetAudioLatency(DT_ms latency)
+{
+  m_audio_latency_ms.store(latency.count(), std::memory_order_relaxed);
+}
+
 double PerformanceMetrics::GetFPS() const
 {
   return m_fps_counter.GetHzAvg();
@@ -80,6 +125,59 @@ double PerformanceMetrics::GetLastSpeedDenominator() const
          Core::System::GetInstance().GetVideoInterface().GetTargetRefreshRate();
 }
 
+u64 PerformanceMetrics::GetFrameDumpLateCount() const
+{
+  return m_frame_dump_late_count.load(std::memory_order_relaxed);
+}
+
+u64 PerformanceMetrics::GetFrameDumpDroppedCount() const
+{
+  return m_frame_dump_dropped_count.load(std::memory_order_relaxed);
+}
+
+PerformanceMetrics::AudioCallbackHistogram PerformanceMetrics::GetAudioCallbackHistogram() const
+{
+  AudioCallbackHistogram histogram;
+  for (size_t i = 0; i < AUDIO_CALLBACK_BUCKETS; ++i)
+    histogram[i] = m_audio_callback_histogram[i].load(std::memory_order_relaxed);
+  return histogram;
+}
+
+u64 PerformanceMetrics::GetAudioUnderrunCount() const
+{
+  return m_audio_underrun_count.load(std::memory_order_relaxed);
+}
+
+DT_ms PerformanceMetrics::GetAudioLatency() const
+{
+  return DT_ms(m_audio_latency_ms.load(std::memory_order_relaxed));
+}
+
+std::optional<PerformanceMetrics::AudioCallbackPercentile>
+PerformanceMetrics::GetAudioCallbackPercentile(const AudioCallbackHistogram& histogram,
+                                               double fraction)
+{
+  u64 total = 0;
+  for (const u64 count : histogram)
+    total += count;
+  if (total == 0)
+    return std::nullopt;
+
+  u64 count = 0;
+  for (size_t bucket = 0; bucket < AUDIO_CALLBACK_BUCKETS - 1; ++bucket)
+  {
+    count += histogram[bucket];
+    if (count >= total * fraction)
+      return AudioCallbackPercentile{DT_us(double(u64(AUDIO_CALLBACK_FIRST_BUCKET_US) << bucket)),
+                                     false};
+  }
+
+  // The last bucket holds every callback which took at least as long as the limit of the bucket
+  // before it, no matter how much longer
+  const u64 last_bucket_us = u64(AUDIO_CALLBACK_FIRST_BUCKET_US) << (AUDIO_CALLBACK_BUCKETS - 2);
+  return AudioCallbackPercentile{DT_us(double(last_bucket_us)), true};
+}
+
 void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
 {
   const float bg_alpha = 0.7f;
@@ -269,5 +367,67 @@ void PerformanceMetrics::DrawImGuiStats(const float backbuffer_scale)
     }
   }
 
+  if (g_ActiveConfig.bShowAudioStats)
+  {
+    const AudioCallbackHistogram histogram = GetAudioCallbackHistogram();
+    float window_height = (12.f + 17.f * 5) * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (stack_vertically)
+      window_y += window_height + window_padding;
+    else
+      window_x -= window_width + window_padding;
+
+    // The times which 50% and 99% of the audio callbacks took less than, the audio latency and
+    // how often the mixer ran out of samples
+    if (ImGui::Begin("AudioStats", nullptr, imgui_flags))
+    {
+      const auto draw_percentile = [&](const char* label, double fraction) {
+        const std::optional<AudioCallbackPercentile> time =
+            GetAudioCallbackPercentile(histogram, fraction);
+        // The overlay font has no glyph for a greater-than-or-equal sign
+        if (time && time->is_lower_limit)
+          ImGui::TextColored(ImVec4(r, g, b, 1.0f), "%s:>=%4.0lfus", label, time->limit.count());
+        else if (time)
+          ImGui::TextColored(ImVec4(r, g, b, 1.0f), "%s:<%4.0lfus", label, time->limit.count());
+        else
+          ImGui::TextColored(ImVec4(r, g, b, 1.0f), "%s:     -", label);
+      };
+
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Audio mix:");
+      draw_percentile("50%", 0.5);
+      draw_percentile("99%", 0.99);
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Lat:%5.1lfms", GetAudioLatency().count());
+      ImGui::TextColored(ImVec4(r, g, b, 1.0f), "Under:%5llu",
+                         static_cast<unsigned long long>(GetAudioUnderrunCount()));
+      ImGui::End();
+    }
+  }
+
+  const u64 frame_dump_late = GetFrameDumpLateCount();
+  const u64 frame_dump_dropped = GetFrameDumpDroppedCount();
+  if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES) && (frame_dump_late || frame_dump_dropped))
+  {
+    float window_height = 47.f * backbuffer_scale;
+
+    // Position in the top-right corner of the screen.
+    ImGui::SetNextWindowPos(ImVec2(window_x, window_y), ImGuiCond_Always, ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImVec2(window_width, window_height));
+    ImGui::SetNextWindowBgAlpha(bg_alpha);
+
+    if (ImGui::Begin("FrameDumpStats", nullptr, imgui_flags))
+    {
+      ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Late:%6llu",
+                         static_cast<unsigned long long>(frame_dump_late));
+      ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Drop:%6llu",
+                         static_cast<unsigned long long>(frame_dump_dropped));
+      ImGui::End();
+    }
+  }
+
   ImGui::PopStyleVar(2);
 }
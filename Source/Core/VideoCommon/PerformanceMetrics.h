@@ -4,6 +4,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <optional>
 #include <shared_mutex>
 
 #include "Common/CommonTypes.h"
@@ -33,6 +35,18 @@ public:
   void CountThrottleSleep(DT sleep);
   void CountPerformanceMarker(Core::System& system, s64 cyclesLate);
 
+  // A late frame made the video thread wait for frame dumping to catch up.
+  // A dropped frame could not be written to the frame dump at all.
+  void CountFrameDumpLate();
+  void CountFrameDumpDropped();
+
+  // Called from the audio thread with how long the mixer took to fill a buffer
+  void CountAudioCallback(DT duration);
+  // Called from the audio thread when the mixer ran out of samples, and with the estimated time
+  // from a sample being pushed to the mixer to it being played
+  void CountAudioUnderrun();
+  void SetAudioLatency(DT_ms latency);
+
   // Getter Functions
   double GetFPS() const;
   double GetVPS() const;
@@ -41,6 +55,32 @@ public:
 
   double GetLastSpeedDenominator() const;
 
+  u64 GetFrameDumpLateCount() const;
+  u64 GetFrameDumpDroppedCount() const;
+
+  // Audio callbacks are counted in buckets by how long they took. The first bucket is for
+  // callbacks shorter than AUDIO_CALLBACK_FIRST_BUCKET_US, and the limit doubles with each bucket.
+  // The last bucket holds all callbacks which took longer.
+  // Every AUDIO_CALLBACK_DECAY_INTERVAL callbacks, all buckets are halved, so that the histogram
+  // mostly reflects the last few seconds rather than the whole session.
+  static constexpr size_t AUDIO_CALLBACK_BUCKETS = 12;
+  static constexpr u32 AUDIO_CALLBACK_FIRST_BUCKET_US = 8;
+  static constexpr u64 AUDIO_CALLBACK_DECAY_INTERVAL = 512;
+  using AudioCallbackHistogram = std::array<u64, AUDIO_CALLBACK_BUCKETS>;
+  AudioCallbackHistogram GetAudioCallbackHistogram() const;
+  u64 GetAudioUnderrunCount() const;
+  DT_ms GetAudioLatency() const;
+  struct AudioCallbackPercentile
+  {
+    // The upper limit of the bucket which the given fraction of callbacks did not exceed. For the
+    // last bucket, which has no upper limit, this is its lower limit instead.
+    DT_us limit;
+    bool is_lower_limit;
+  };
+  // Nothing if no callbacks have been counted
+  static std::optional<AudioCallbackPercentile>
+  GetAudioCallbackPercentile(const AudioCallbackHistogram& histogram, double fraction);
+
   // ImGui Functions
   void DrawImGuiStats(const float backbuffer_scale);
 
@@ -57,6 +97,14 @@ private:
   std::array<TimePoint, 256> m_real_times{};
   std::array<TimePoint, 256> m_cpu_times{};
   DT m_time_sleeping{};
+
+  std::atomic<u64> m_frame_dump_late_count = 0;
+  std::atomic<u64> m_frame_dump_dropped_count = 0;
+
+  std::array<std::atomic<u64>, AUDIO_CALLBACK_BUCKETS> m_audio_callback_histogram{};
+  std::atomic<u64> m_audio_callback_count = 0;
+  std::atomic<u64> m_audio_underrun_count = 0;
+  std::atomic<double> m_audio_latency_ms = 0.0;
 };
 
 extern PerformanceMetrics g_perf_metrics;
@@ -518,7 +518,7 @@ void PixelShaderManager::SetBlendModeChanged()
 
 void PixelShaderManager::SetBoundingBoxActive(bool active)
 {
-  const bool enable = active && g_ActiveConfig.bBBoxEnable;
+  const bool enable = active && g_ActiveConfig.bBBoxEnable && !g_ActiveConfig.bBBoxCPU;
   if (enable == (constants.bounding_box != 0))
     return;
 
@@ -23,7 +23,7 @@ ShaderHostConfig ShaderHostConfig::GetCurrent()
   bits.per_pixel_lighting = g_ActiveConfig.bEnablePixelLighting;
   bits.vertex_rounding = g_ActiveConfig.UseVertexRounding();
   bits.fast_depth_calc = g_ActiveConfig.bFastDepthCalc;
-  bits.bounding_box = g_ActiveConfig.bBBoxEnable;
+  bits.bounding_box = g_ActiveConfig.bBBoxEnable && !g_ActiveConfig.bBBoxCPU;
   bits.backend_dual_source_blend = g_ActiveConfig.backend_info.bSupportsDualSourceBlend;
   bits.backend_geometry_shaders = g_ActiveConfig.backend_info.bSupportsGeometryShaders;
   bits.backend_early_z = g_ActiveConfig.backend_info.bSupportsEarlyZ;
@@ -23,6 +23,7 @@
 
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/IndexGenerator.h"
@@ -429,9 +430,22 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
 
     count = loader->RunVertices(src, dst.GetPointer(), count);
 
-    if (can_cpu_cull && !cullall)
+    // With CPU bounding box emulation the pixel shader doesn't track the bounding box, so do it
+    // here from the loaded vertices instead.
+    const bool update_cpu_bbox =
+        g_ActiveConfig.UseCPUBoundingBox() && g_bounding_box->IsEnabled() && !cullall;
+    const bool check_cpu_cull = can_cpu_cull && !cullall;
+
+    // The vertices only have to be transformed once for both.
+    if (update_cpu_bbox || check_cpu_cull)
+      g_vertex_manager->TransformVerticesOnCPU(loader, dst.GetPointer(), count);
+
+    if (update_cpu_bbox)
+      g_vertex_manager->UpdateCPUBoundingBox(primitive, count);
+
+    if (check_cpu_cull)
     {
-      if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
+      if (!g_vertex_manager->AreAllVerticesCulled(primitive, count))
       {
         DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
         memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
@@ -138,11 +138,20 @@ void VertexManagerBase::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_v
   m_index_generator.AddIndices(primitive, num_vertices);
 }
 
-bool VertexManagerBase::AreAllVerticesCulled(VertexLoaderBase* loader,
-                                             OpcodeDecoder::Primitive primitive, const u8* src,
-                                             u32 count)
+void VertexManagerBase::TransformVerticesOnCPU(VertexLoaderBase* loader, const u8* src,
+                                               u32 count)
 {
-  return m_cpu_cull.AreAllVerticesCulled(loader, primitive, src, count);
+  m_cpu_cull.TransformVertices(loader, src, count);
+}
+
+bool VertexManagerBase::AreAllVerticesCulled(OpcodeDecoder::Primitive primitive, u32 count) const
+{
+  return m_cpu_cull.AreAllVerticesCulled(primitive, count);
+}
+
+void VertexManagerBase::UpdateCPUBoundingBox(OpcodeDecoder::Primitive primitive, u32 count) const
+{
+  m_cpu_cull.UpdateBoundingBox(primitive, count);
 }
 
 DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive primitive,
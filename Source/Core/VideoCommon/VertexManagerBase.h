@@ -108,8 +108,10 @@ public:
 
   PrimitiveType GetCurrentPrimitiveType() const { return m_current_primitive_type; }
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
-  bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
-                            const u8* src, u32 count);
+  // Transforms the vertices on the CPU, which is needed by the two functions below.
+  void TransformVerticesOnCPU(VertexLoaderBase* loader, const u8* src, u32 count);
+  bool AreAllVerticesCulled(OpcodeDecoder::Primitive primitive, u32 count) const;
+  void UpdateCPUBoundingBox(OpcodeDecoder::Primitive primitive, u32 count) const;
   virtual DataReader PrepareForAdditionalData(OpcodeDecoder::Primitive primitive, u32 count,
                                               u32 stride, bool cullall);
   /// Switch cullall off after a call to PrepareForAdditionalData with cullall true
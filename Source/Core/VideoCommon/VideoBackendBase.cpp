@@ -124,8 +124,13 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 data
     return 0;
   }
 
+  // The GPU thread has to catch up with the FIFO before the EFB can be accessed deterministically.
+  auto& system = Core::System::GetInstance();
+
   if (type == EFBAccessType::PokeColor || type == EFBAccessType::PokeZ)
   {
+    system.GetFifo().SyncGPU(Fifo::SyncGPUReason::EFBPoke);
+
     AsyncRequests::Event e;
     e.type = type == EFBAccessType::PokeColor ? AsyncRequests::Event::EFB_POKE_COLOR :
                                                 AsyncRequests::Event::EFB_POKE_Z;
@@ -138,6 +143,8 @@ u32 VideoBackendBase::Video_AccessEFB(EFBAccessType type, u32 x, u32 y, u32 data
   }
   else
   {
+    system.GetFifo().SyncGPU(Fifo::SyncGPUReason::EFBPeek);
+
     AsyncRequests::Event e;
     u32 result;
     e.type = type == EFBAccessType::PeekColor ? AsyncRequests::Event::EFB_PEEK_COLOR :
@@ -186,7 +193,7 @@ u16 VideoBackendBase::Video_GetBoundingBox(int index)
     }
     warn_once = false;
   }
-  else if (!g_ActiveConfig.backend_info.bSupportsBBox)
+  else if (!g_ActiveConfig.UseCPUBoundingBox() && !g_ActiveConfig.backend_info.bSupportsBBox)
   {
     static bool warn_once = true;
     if (warn_once)
@@ -106,6 +106,7 @@ void VideoConfig::Refresh()
   bShowGraphs = Config::Get(Config::GFX_SHOW_GRAPHS);
   bShowSpeed = Config::Get(Config::GFX_SHOW_SPEED);
   bShowSpeedColors = Config::Get(Config::GFX_SHOW_SPEED_COLORS);
+  bShowAudioStats = Config::Get(Config::GFX_SHOW_AUDIO_STATS);
   iPerfSampleUSec = Config::Get(Config::GFX_PERF_SAMP_WINDOW) * 1000;
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
@@ -187,7 +188,9 @@ void VideoConfig::Refresh()
 
   bEFBAccessEnable = Config::Get(Config::GFX_HACK_EFB_ACCESS_ENABLE);
   bEFBAccessDeferInvalidation = Config::Get(Config::GFX_HACK_EFB_DEFER_INVALIDATION);
+  bEFBAccessPredictive = Config::Get(Config::GFX_HACK_EFB_ACCESS_PREDICTIVE);
   bBBoxEnable = Config::Get(Config::GFX_HACK_BBOX_ENABLE);
+  bBBoxCPU = Config::Get(Config::GFX_HACK_BBOX_CPU);
   bForceProgressive = Config::Get(Config::GFX_HACK_FORCE_PROGRESSIVE);
   bSkipEFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_EFB_COPY_TO_RAM);
   bSkipXFBCopyToRam = Config::Get(Config::GFX_HACK_SKIP_XFB_COPY_TO_RAM);
@@ -293,6 +296,7 @@ void CheckForConfigChanges()
   const auto old_texture_filtering_mode = g_ActiveConfig.texture_filtering_mode;
   const bool old_vsync = g_ActiveConfig.bVSyncActive;
   const bool old_bbox = g_ActiveConfig.bBBoxEnable;
+  const bool old_cpu_bbox = g_ActiveConfig.bBBoxCPU;
   const int old_efb_scale = g_ActiveConfig.iEFBScale;
   const u32 old_game_mod_changes =
       g_ActiveConfig.graphics_mod_config ? g_ActiveConfig.graphics_mod_config->GetChangeCount() : 0;
@@ -343,7 +347,7 @@ void CheckForConfigChanges()
     changed_bits |= CONFIG_CHANGE_BIT_FORCE_TEXTURE_FILTERING;
   if (old_vsync != g_ActiveConfig.bVSyncActive)
     changed_bits |= CONFIG_CHANGE_BIT_VSYNC;
-  if (old_bbox != g_ActiveConfig.bBBoxEnable)
+  if (old_bbox != g_ActiveConfig.bBBoxEnable || old_cpu_bbox != g_ActiveConfig.bBBoxCPU)
     changed_bits |= CONFIG_CHANGE_BIT_BBOX;
   if (old_efb_scale != g_ActiveConfig.iEFBScale)
     changed_bits |= CONFIG_CHANGE_BIT_TARGET_SIZE;
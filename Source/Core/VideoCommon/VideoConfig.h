@@ -170,6 +170,7 @@ struct VideoConfig final
   bool bShowGraphs = false;
   bool bShowSpeed = false;
   bool bShowSpeedColors = false;
+  bool bShowAudioStats = false;
   int iPerfSampleUSec = 0;
   bool bShowNetPlayPing = false;
   bool bShowNetPlayMessages = false;
@@ -211,8 +212,10 @@ struct VideoConfig final
   // Hacks
   bool bEFBAccessEnable = false;
   bool bEFBAccessDeferInvalidation = false;
+  bool bEFBAccessPredictive = false;
   bool bPerfQueriesEnable = false;
   bool bBBoxEnable = false;
+  bool bBBoxCPU = false;
   bool bForceProgressive = false;
   bool bCPUCull = false;
 
@@ -365,6 +368,7 @@ struct VideoConfig final
     return backend_info.bSupportsGPUTextureDecoding && bEnableGPUTextureDecoding;
   }
   bool UseVertexRounding() const { return bVertexRounding && iEFBScale != 1; }
+  bool UseCPUBoundingBox() const { return bBBoxEnable && bBBoxCPU; }
   bool ManualTextureSamplingWithCustomTextureSizes() const
   {
     // If manual texture sampling is disabled, we don't need to do anything.
@@ -0,0 +1,322 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DSPReplay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCaptureLogger.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPHost.h"
+#include "Core/DSP/DSPTables.h"
+
+namespace
+{
+// Sizes of the headers of the PCAP format, see Common/PcapFile.cpp
+constexpr size_t PCAP_HEADER_SIZE = 24;
+constexpr size_t PCAP_RECORD_HEADER_SIZE = 16;
+constexpr u32 PCAP_MAGIC = 0xa1b2c3d4;
+
+// The number of cycles DSPLLE runs per update
+constexpr int SLICE_CYCLES = 12600 / 6;
+
+// The replay ends once the DSP has gone this many cycles without reading a mail or doing a DMA
+// after the last mail, or gets stuck before that.
+constexpr u64 IDLE_CYCLES_LIMIT = 2 * 1000 * 1000;
+
+// The mail with which the CPU tells the ROM where the ucode is, which starts the boot sequence.
+// The DSP reads the mailbox's top bit as the "mail is valid" flag, so it isn't part of the value.
+constexpr u32 ROM_BOOT_MAIL = 0x00F3A001;
+
+struct RecordedDMA
+{
+  u16 control;
+  u32 gc_address;
+  std::vector<u8> data;
+  // The number of mails the DSP had read before this DMA
+  size_t mails_before;
+};
+
+struct Capture
+{
+  // Mails from the CPU, in the order the DSP read them
+  std::vector<u32> mails;
+  // DMAs from main memory to the DSP. Their data is stored in DSP memory order.
+  std::vector<RecordedDMA> dmas;
+};
+
+struct Replay
+{
+  const Capture& capture;
+  size_t next_mail;
+  size_t next_dma;
+  u32 mismatched_dmas = 0;
+};
+
+Replay* s_replay = nullptr;
+}  // namespace
+
+// The dsplib host functions. While a capture is being replayed, DMAs to the DSP are served from
+// it. Everything else is stubbed out, including ARAM, which reads as zeroes.
+u8 DSP::Host::ReadHostMemory(u32 addr)
+{
+  return 0;
+}
+void DSP::Host::WriteHostMemory(u8 value, u32 addr)
+{
+}
+void DSP::Host::DMAToDSP(u16* dst, u32 addr, u32 size)
+{
+  if (!s_replay || s_replay->next_dma == s_replay->capture.dmas.size())
+    return;
+
+  // The DSP requests the same DMAs as when the capture was made as long as it gets the same mails,
+  // and the recorded data already is in DSP memory order.
+  const RecordedDMA& dma = s_replay->capture.dmas[s_replay->next_dma++];
+  if (dma.gc_address != addr || dma.data.size() != size)
+    ++s_replay->mismatched_dmas;
+  std::memcpy(dst, dma.data.data(), std::min<size_t>(size, dma.data.size()));
+}
+void DSP::Host::DMAFromDSP(const u16* src, u32 addr, u32 size)
+{
+}
+void DSP::Host::OSD_AddMessage(std::string str, u32 ms)
+{
+}
+bool DSP::Host::OnThread()
+{
+  return false;
+}
+bool DSP::Host::IsWiiHost()
+{
+  return false;
+}
+void DSP::Host::CodeLoaded(DSPCore& dsp, u32 addr, size_t size)
+{
+  // Like the emulator, start over with the new code
+  dsp.ClearIRAM();
+  dsp.DSPState().GetAnalyzer().Analyze(dsp.DSPState());
+}
+void DSP::Host::CodeLoaded(DSPCore& dsp, const u8* ptr, size_t size)
+{
+  dsp.ClearIRAM();
+  dsp.DSPState().GetAnalyzer().Analyze(dsp.DSPState());
+}
+void DSP::Host::InterruptRequest()
+{
+}
+void DSP::Host::UpdateDebugger()
+{
+}
+
+static std::optional<Capture> ReadCapture(const std::string& capture_name)
+{
+  std::string bytes;
+  if (!File::ReadFileToString(capture_name, bytes))
+  {
+    fmt::print("ERROR: Could not read {}\n", capture_name);
+    return std::nullopt;
+  }
+
+  u32 magic = 0;
+  if (bytes.size() >= PCAP_HEADER_SIZE)
+    std::memcpy(&magic, bytes.data(), sizeof(magic));
+  if (magic != PCAP_MAGIC)
+  {
+    fmt::print("ERROR: {} is not a DSP capture\n", capture_name);
+    return std::nullopt;
+  }
+
+  Capture capture;
+  u16 last_cmbh = 0;
+  size_t offset = PCAP_HEADER_SIZE;
+  while (offset + PCAP_RECORD_HEADER_SIZE <= bytes.size())
+  {
+    u32 size;
+    std::memcpy(&size, bytes.data() + offset + 8, sizeof(size));
+    const u8* packet = reinterpret_cast<const u8*>(bytes.data()) + offset + PCAP_RECORD_HEADER_SIZE;
+    offset += PCAP_RECORD_HEADER_SIZE + size;
+    if (offset > bytes.size())
+      break;
+
+    if (size >= sizeof(DSP::IFXAccessPacket) && packet[0] == DSP::IFX_ACCESS_PACKET_MAGIC)
+    {
+      DSP::IFXAccessPacket ifx;
+      std::memcpy(&ifx, packet, sizeof(ifx));
+      if (!ifx.is_read)
+        continue;
+
+      // A mail is read as the high half (with the valid flag set) followed by the low half
+      if ((ifx.address & 0xff) == DSP::DSP_CMBH)
+      {
+        last_cmbh = ifx.value;
+      }
+      else if ((ifx.address & 0xff) == DSP::DSP_CMBL && (last_cmbh & 0x8000) != 0)
+      {
+        capture.mails.push_back(static_cast<u32>(last_cmbh & 0x7fff) << 16 | ifx.value);
+        last_cmbh = 0;
+      }
+    }
+    else if (size >= sizeof(DSP::DMAPacket) && packet[0] == DSP::DMA_PACKET_MAGIC)
+    {
+      DSP::DMAPacket dma;
+      std::memcpy(&dma, packet, sizeof(dma));
+      if ((dma.dma_control & DSP::DSP_CR_TO_CPU) != 0 || size < sizeof(dma) + dma.length)
+        continue;
+
+      const u8* data = packet + sizeof(dma);
+      capture.dmas.push_back({dma.dma_control, dma.gc_address,
+                              std::vector<u8>(data, data + dma.length), capture.mails.size()});
+    }
+  }
+
+  return capture;
+}
+
+static bool LoadDSPRom(u16* rom, const std::string& filename, u32 size_in_bytes)
+{
+  std::string bytes;
+  if (!File::ReadFileToString(filename, bytes) || bytes.size() != size_in_bytes)
+  {
+    fmt::print("ERROR: Could not load {}\n", filename);
+    return false;
+  }
+
+  const u16* words = reinterpret_cast<const u16*>(bytes.c_str());
+  for (u32 i = 0; i < size_in_bytes / 2; ++i)
+    rom[i] = Common::swap16(words[i]);
+
+  return true;
+}
+
+static bool RunReplay(const Capture& capture, size_t first_mail, size_t first_dma,
+                      DSP::DSPInitOptions::CoreType core_type, const char* core_name)
+{
+  DSP::DSPInitOptions opts;
+  const std::string rom_dir = File::GetSysDirectory() + GC_SYS_DIR DIR_SEP;
+  if (!LoadDSPRom(opts.irom_contents.data(), rom_dir + DSP_IROM, DSP::DSP_IROM_BYTE_SIZE) ||
+      !LoadDSPRom(opts.coef_contents.data(), rom_dir + DSP_COEF, DSP::DSP_COEF_BYTE_SIZE))
+  {
+    return false;
+  }
+  opts.core_type = core_type;
+
+  DSP::DSPCore core;
+  if (!core.Initialize(opts))
+    return false;
+  core.Reset();
+  // Boot from the ROM, as if the CPU had just reset the DSP
+  core.DSPState().control_reg = 0;
+
+  Replay replay{capture, first_mail, first_dma};
+  s_replay = &replay;
+
+  u64 cycles = 0;
+  u64 last_progress_cycles = 0;
+  size_t last_progress = first_mail + first_dma;
+  const auto start = std::chrono::steady_clock::now();
+  auto last_progress_time = start;
+  while (cycles - last_progress_cycles < IDLE_CYCLES_LIMIT)
+  {
+    // Act as the CPU: read the DSP's mails as soon as they are sent, and send the next mail as soon
+    // as the DSP has read the previous one.
+    if ((core.PeekMailbox(DSP::Mailbox::DSP) & 0x80000000) != 0)
+      core.ReadMailboxLow(DSP::Mailbox::DSP);
+    if ((core.PeekMailbox(DSP::Mailbox::CPU) & 0x80000000) == 0 &&
+        replay.next_mail < capture.mails.size())
+    {
+      const u32 mail = capture.mails[replay.next_mail++];
+      core.WriteMailboxHigh(DSP::Mailbox::CPU, static_cast<u16>(mail >> 16));
+      core.WriteMailboxLow(DSP::Mailbox::CPU, static_cast<u16>(mail));
+    }
+
+    core.RunCycles(SLICE_CYCLES);
+    cycles += SLICE_CYCLES;
+
+    const size_t progress = replay.next_mail + replay.next_dma;
+    if (progress != last_progress)
+    {
+      last_progress = progress;
+      last_progress_cycles = cycles;
+      last_progress_time = std::chrono::steady_clock::now();
+    }
+  }
+  // Leave out the idle cycles the replay waits through before it ends, so that the time only
+  // covers the part of the capture which was replayed
+  const std::chrono::duration<double> elapsed = last_progress_time - start;
+
+  s_replay = nullptr;
+  core.Shutdown();
+
+  // These are emulated cycles, so the speed compares to the 81 MHz of the real DSP
+  const double mhz = elapsed.count() > 0 ? last_progress_cycles / elapsed.count() / 1000000.0 : 0;
+  fmt::print("{}: {:.3f} s for {} cycles ({:.1f} MHz), {}/{} mails, {}/{} DMAs", core_name,
+             elapsed.count(), last_progress_cycles, mhz, replay.next_mail - first_mail,
+             capture.mails.size() - first_mail, replay.next_dma - first_dma,
+             capture.dmas.size() - first_dma);
+  if (replay.mismatched_dmas != 0)
+    fmt::print(", {} DMAs did not match the capture", replay.mismatched_dmas);
+  fmt::print("\n");
+
+  return true;
+}
+
+bool PerformReplayBenchmark(const std::string& capture_name)
+{
+  const std::optional<Capture> capture = ReadCapture(capture_name);
+  if (!capture)
+    return false;
+
+  // Start at the upload of the first ucode (the first DMA to IRAM), so that the replay doesn't
+  // depend on how the DSP was brought up before it. The ROM gets the parameters of that DMA from
+  // the mails which start with ROM_BOOT_MAIL.
+  const auto ucode_dma = std::find_if(
+      capture->dmas.begin(), capture->dmas.end(),
+      [](const RecordedDMA& dma) { return (dma.control & DSP::DSP_CR_IMEM) != 0; });
+  if (ucode_dma == capture->dmas.end())
+  {
+    fmt::print("ERROR: The capture does not contain the upload of a ucode\n");
+    return false;
+  }
+
+  const auto boot_mails_end = capture->mails.begin() + ucode_dma->mails_before;
+  const auto boot_mail = std::find(std::make_reverse_iterator(boot_mails_end),
+                                   capture->mails.rend(), ROM_BOOT_MAIL);
+  if (boot_mail == capture->mails.rend())
+  {
+    fmt::print("ERROR: The capture does not contain the mails which boot the ucode\n");
+    return false;
+  }
+
+  const size_t first_mail = std::distance(capture->mails.begin(), boot_mail.base()) - 1;
+  const size_t first_dma = std::distance(capture->dmas.begin(), ucode_dma);
+  DSP::InitInstructionTable();
+
+  fmt::print("Replaying {} mails and {} DMAs from the ucode upload at {:#010x}\n",
+             capture->mails.size() - first_mail, capture->dmas.size() - first_dma,
+             ucode_dma->gc_address);
+
+  if (!RunReplay(*capture, first_mail, first_dma, DSP::DSPInitOptions::CoreType::Interpreter,
+                 "Interpreter"))
+  {
+    return false;
+  }
+#ifdef _M_X86_64
+  if (!RunReplay(*capture, first_mail, first_dma, DSP::DSPInitOptions::CoreType::JIT64, "JIT"))
+    return false;
+#endif
+
+  return true;
+}
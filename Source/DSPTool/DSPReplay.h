@@ -0,0 +1,11 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+
+// Replays the mails and DMAs recorded in a DSP capture (written by the LLE DSP when
+// MAIN_DSP_CAPTURE_LOG is enabled) against the DSP ROM and the ucode uploaded in the capture,
+// without the rest of the emulator. Prints how long the interpreter and the JIT take to run it.
+bool PerformReplayBenchmark(const std::string& capture_name);
@@ -12,46 +12,9 @@
 #include "Common/StringUtil.h"
 #include "Core/DSP/DSPCodeUtil.h"
 #include "Core/DSP/DSPDisassembler.h"
-#include "Core/DSP/DSPHost.h"
 #include "Core/DSP/DSPTables.h"
 
-// Stub out the dsplib host stuff, since this is just a simple cmdline tools.
-u8 DSP::Host::ReadHostMemory(u32 addr)
-{
-  return 0;
-}
-void DSP::Host::WriteHostMemory(u8 value, u32 addr)
-{
-}
-void DSP::Host::DMAToDSP(u16* dst, u32 addr, u32 size)
-{
-}
-void DSP::Host::DMAFromDSP(const u16* src, u32 addr, u32 size)
-{
-}
-void DSP::Host::OSD_AddMessage(std::string str, u32 ms)
-{
-}
-bool DSP::Host::OnThread()
-{
-  return false;
-}
-bool DSP::Host::IsWiiHost()
-{
-  return false;
-}
-void DSP::Host::CodeLoaded(DSPCore& dsp, u32 addr, size_t size)
-{
-}
-void DSP::Host::CodeLoaded(DSPCore& dsp, const u8* ptr, size_t size)
-{
-}
-void DSP::Host::InterruptRequest()
-{
-}
-void DSP::Host::UpdateDebugger()
-{
-}
+#include "DSPReplay.h"
 
 static std::string CodeToHeader(const std::vector<u16>& code, const std::string& filename)
 {
@@ -378,12 +341,14 @@ static bool IsHelpFlag(const std::string& argument)
 //   dsptool [-f] -h asdf.h asdf.txt
 // Print results from DSPSpy register dump
 //   dsptool -p dsp_dump0.bin
+// Benchmark the LLE cores with a DSP capture
+//   dsptool -b dsp.pcap
 int main(int argc, const char* argv[])
 {
   if (argc == 1 || (argc == 2 && IsHelpFlag(argv[1])))
   {
-    printf("USAGE: DSPTool [-?] [--help] [-f] [-d] [-m] [-p <FILE>] [-o <FILE>] [-h <FILE>] <DSP "
-           "ASSEMBLER FILE>\n");
+    printf("USAGE: DSPTool [-?] [--help] [-f] [-d] [-m] [-b] [-p <FILE>] [-o <FILE>] [-h <FILE>] "
+           "<DSP ASSEMBLER FILE>\n");
     printf("-? / --help: Prints this message\n");
     printf("-d: Disassemble\n");
     printf("-m: Input file contains a list of files (Header assembly only)\n");
@@ -396,6 +361,8 @@ int main(int argc, const char* argv[])
     printf("-pm <DUMP FILE>: Print results of DSPSpy register dump (convert PROD values)\n");
     printf("-psm <DUMP FILE>: Print results of DSPSpy register dump (convert PROD values/disable "
            "SR output)\n");
+    printf("-b <CAPTURE FILE>: Benchmark the LLE cores by replaying the mails and DMAs of a DSP "
+           "capture\n");
 
     return 0;
   }
@@ -405,7 +372,8 @@ int main(int argc, const char* argv[])
   std::string output_name;
 
   bool disassemble = false, compare = false, multiple = false, outputSize = false, force = false,
-       print_results = false, print_results_prodhack = false, print_results_srhack = false;
+       print_results = false, print_results_prodhack = false, print_results_srhack = false,
+       benchmark = false;
   for (int i = 1; i < argc; i++)
   {
     const std::string argument = argv[i];
@@ -459,6 +427,10 @@ int main(int argc, const char* argv[])
       print_results_srhack = true;
       print_results_prodhack = true;
     }
+    else if (argument == "-b")
+    {
+      benchmark = true;
+    }
     else
     {
       if (!input_name.empty())
@@ -487,6 +459,11 @@ int main(int argc, const char* argv[])
     return PerformBinaryComparison(input_name, output_name) ? 0 : 1;
   }
 
+  if (benchmark)
+  {
+    return PerformReplayBenchmark(input_name) ? 0 : 1;
+  }
+
   if (print_results)
   {
     PrintResults(input_name, output_name, print_results_srhack, print_results_prodhack);
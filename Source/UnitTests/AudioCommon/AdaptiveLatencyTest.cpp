@@ -0,0 +1,139 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/AdaptiveLatency.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+constexpr unsigned int SAMPLE_RATE = 48000;
+// Like the Cubeb backend in low latency mode
+constexpr u32 CALLBACK_FRAMES = 256;
+// Like AX, which pushes 5 ms of audio at a time
+constexpr double PUSH_PERIOD_MS = 5.0;
+
+// Emulation and an audio backend on a simulated clock. The buffered audio is steered towards the
+// target by playing it slightly faster or slower, like Mixer::MixerFifo does.
+class Simulation
+{
+public:
+  explicit Simulation(double callback_jitter_ms, double push_jitter_ms)
+      : m_callback_jitter(-callback_jitter_ms, callback_jitter_ms), m_push_jitter(0, push_jitter_ms)
+  {
+  }
+
+  // Returns the number of underruns
+  u64 Run(double seconds)
+  {
+    const u64 underruns_before = m_latency.GetUnderrunCount();
+    const double end_ms = m_time_ms + seconds * 1000.0;
+    while (m_time_ms < end_ms)
+    {
+      const double callback_ms =
+          m_callbacks * CALLBACK_PERIOD_MS + m_callback_jitter(m_rng) + CALLBACK_PERIOD_MS;
+      const double push_ms = m_pushes * PUSH_PERIOD_MS + m_push_jitter(m_rng);
+      if (push_ms < callback_ms)
+      {
+        m_time_ms = std::max(m_time_ms, push_ms);
+        m_buffered_frames += PUSH_PERIOD_MS * SAMPLE_RATE / 1000.0;
+        ++m_pushes;
+      }
+      else
+      {
+        m_time_ms = std::max(m_time_ms, callback_ms);
+        Callback();
+        ++m_callbacks;
+      }
+    }
+    return m_latency.GetUnderrunCount() - underruns_before;
+  }
+
+  const AudioCommon::AdaptiveLatency& GetLatency() const { return m_latency; }
+
+private:
+  static constexpr double CALLBACK_PERIOD_MS = CALLBACK_FRAMES * 1000.0 / SAMPLE_RATE;
+
+  void Callback()
+  {
+    const double target_frames = m_latency.GetTargetBufferMs() * SAMPLE_RATE / 1000.0;
+    const double shift = std::clamp((m_buffered_frames - target_frames) * 0.2, -300.0, 300.0);
+    const double consumed = CALLBACK_FRAMES * (SAMPLE_RATE + shift) / SAMPLE_RATE;
+
+    const u32 buffered_frames = static_cast<u32>(m_buffered_frames);
+    const bool underrun = m_buffered_frames < consumed;
+    m_buffered_frames = std::max(m_buffered_frames - consumed, 0.0);
+
+    const TimePoint now{std::chrono::duration_cast<DT>(DT_ms(m_time_ms))};
+    m_latency.Update(now, CALLBACK_FRAMES, buffered_frames, underrun);
+  }
+
+  AudioCommon::AdaptiveLatency m_latency{SAMPLE_RATE};
+  std::mt19937 m_rng{1234};
+  std::uniform_real_distribution<double> m_callback_jitter;
+  std::uniform_real_distribution<double> m_push_jitter;
+  double m_time_ms = 0.0;
+  double m_buffered_frames = 0.0;
+  u64 m_callbacks = 0;
+  u64 m_pushes = 0;
+};
+}  // namespace
+
+TEST(AdaptiveLatency, ShrinksWithSteadyTiming)
+{
+  Simulation simulation(0.5, 1.0);
+  simulation.Run(30);
+  EXPECT_EQ(simulation.Run(30), 0u);
+
+  const AudioCommon::AdaptiveLatency& latency = simulation.GetLatency();
+  EXPECT_LT(latency.GetTargetBufferMs(), AudioCommon::AdaptiveLatency::INITIAL_TARGET_MS);
+  EXPECT_LT(latency.GetLatencyMs(), 20.0);
+}
+
+TEST(AdaptiveLatency, StaysLargerWithJitter)
+{
+  Simulation steady(0.5, 1.0);
+  steady.Run(60);
+  Simulation jittery(4.0, 4.0);
+  jittery.Run(30);
+  EXPECT_EQ(jittery.Run(30), 0u);
+
+  EXPECT_GT(jittery.GetLatency().GetTargetBufferMs(), steady.GetLatency().GetTargetBufferMs());
+  EXPECT_GE(jittery.GetLatency().GetTargetBufferMs(), jittery.GetLatency().GetJitterMs());
+}
+
+TEST(AdaptiveLatency, GrowsAfterUnderrun)
+{
+  AudioCommon::AdaptiveLatency latency(SAMPLE_RATE);
+  const double initial_target = latency.GetTargetBufferMs();
+
+  latency.Update(TimePoint{}, CALLBACK_FRAMES, 0, true);
+  EXPECT_EQ(latency.GetUnderrunCount(), 1u);
+  EXPECT_GT(latency.GetTargetBufferMs(), initial_target);
+
+  for (int i = 0; i < 100; ++i)
+    latency.Update(TimePoint{}, CALLBACK_FRAMES, 0, true);
+  EXPECT_EQ(latency.GetTargetBufferMs(), AudioCommon::AdaptiveLatency::MAX_TARGET_MS);
+}
+
+TEST(AdaptiveLatency, KeepsTargetWhileIdle)
+{
+  AudioCommon::AdaptiveLatency latency(SAMPLE_RATE);
+  const double initial_target = latency.GetTargetBufferMs();
+
+  // Nothing is buffered while emulation is paused, which must not make the buffer shrink
+  TimePoint now{};
+  for (int i = 0; i < 1000; ++i)
+  {
+    now += std::chrono::milliseconds(5);
+    latency.Idle();
+  }
+  latency.Update(now, CALLBACK_FRAMES, 0, false);
+  EXPECT_EQ(latency.GetTargetBufferMs(), initial_target);
+  EXPECT_EQ(latency.GetJitterMs(), 0.0);
+}
@@ -0,0 +1,415 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/FlacFileWriter.h"
+#include "AudioCommon/Mixer.h"
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+
+namespace
+{
+class BitReader
+{
+public:
+  explicit BitReader(const std::vector<u8>& data) : m_data(data) {}
+
+  u32 Read(u32 bits)
+  {
+    u32 value = 0;
+    for (u32 i = 0; i < bits; ++i)
+    {
+      value = (value << 1) | ((m_data.at(m_position / 8) >> (7 - m_position % 8)) & 1);
+      ++m_position;
+    }
+    return value;
+  }
+
+  s32 ReadSigned(u32 bits)
+  {
+    const u32 value = Read(bits);
+    return static_cast<s32>(value << (32 - bits)) >> (32 - bits);
+  }
+
+  u32 ReadUnary()
+  {
+    u32 zeros = 0;
+    while (Read(1) == 0)
+      ++zeros;
+    return zeros;
+  }
+
+  void AlignToByte() { m_position = (m_position + 7) / 8 * 8; }
+  size_t GetBytePosition() const { return m_position / 8; }
+  bool AtEnd() const { return m_position >= m_data.size() * 8; }
+
+private:
+  const std::vector<u8>& m_data;
+  size_t m_position = 0;
+};
+
+u8 CRC8(const std::vector<u8>& data, size_t start, size_t end)
+{
+  u8 crc = 0;
+  for (size_t i = start; i < end; ++i)
+  {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit)
+      crc = static_cast<u8>((crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1);
+  }
+  return crc;
+}
+
+u16 CRC16(const std::vector<u8>& data, size_t start, size_t end)
+{
+  u16 crc = 0;
+  for (size_t i = start; i < end; ++i)
+  {
+    crc ^= static_cast<u16>(data[i] << 8);
+    for (int bit = 0; bit < 8; ++bit)
+      crc = static_cast<u16>((crc & 0x8000) ? (crc << 1) ^ 0x8005 : crc << 1);
+  }
+  return crc;
+}
+
+std::vector<s32> DecodeSubframe(BitReader& reader, u32 count, u32 bits_per_sample)
+{
+  EXPECT_EQ(reader.Read(1), 0u);
+  const u32 type = reader.Read(6);
+  EXPECT_EQ(reader.Read(1), 0u);
+
+  std::vector<s32> samples(count);
+  if (type == 0)
+  {
+    std::fill(samples.begin(), samples.end(), reader.ReadSigned(bits_per_sample));
+    return samples;
+  }
+  if (type == 1)
+  {
+    for (s32& sample : samples)
+      sample = reader.ReadSigned(bits_per_sample);
+    return samples;
+  }
+
+  EXPECT_EQ(type & 0b111000, 0b001000u);
+  const u32 order = type & 0b111;
+  EXPECT_LE(order, 4u);
+  for (u32 i = 0; i < order; ++i)
+    samples[i] = reader.ReadSigned(bits_per_sample);
+
+  EXPECT_EQ(reader.Read(2), 0u);
+  const u32 partition_order = reader.Read(4);
+  const u32 partition_size = count >> partition_order;
+  u32 i = order;
+  for (u32 partition = 0; partition < (1u << partition_order); ++partition)
+  {
+    const u32 parameter = reader.Read(4);
+    EXPECT_NE(parameter, 15u);
+    for (; i < (partition + 1) * partition_size; ++i)
+    {
+      const u32 folded = (reader.ReadUnary() << parameter) | reader.Read(parameter);
+      const s32 residual = static_cast<s32>(folded >> 1) ^ -static_cast<s32>(folded & 1);
+      const s32* x = samples.data() + i;
+      switch (order)
+      {
+      case 0:
+        samples[i] = residual;
+        break;
+      case 1:
+        samples[i] = residual + x[-1];
+        break;
+      case 2:
+        samples[i] = residual + 2 * x[-1] - x[-2];
+        break;
+      case 3:
+        samples[i] = residual + 3 * x[-1] - 3 * x[-2] + x[-3];
+        break;
+      default:
+        samples[i] = residual + 4 * x[-1] - 6 * x[-2] + 4 * x[-3] - x[-4];
+        break;
+      }
+    }
+  }
+  return samples;
+}
+
+// A minimal FLAC decoder for the subset of the format the encoder produces
+std::vector<s16> Decode(const std::vector<u8>& data, u32 expected_sample_rate)
+{
+  BitReader reader(data);
+  EXPECT_EQ(reader.Read(32), 0x664C6143u);
+  EXPECT_EQ(reader.Read(1), 1u);
+  EXPECT_EQ(reader.Read(7), 0u);
+  EXPECT_EQ(reader.Read(24), 34u);
+  EXPECT_EQ(reader.Read(16), AudioCommon::FlacEncoder::BLOCK_SIZE);
+  EXPECT_EQ(reader.Read(16), AudioCommon::FlacEncoder::BLOCK_SIZE);
+  reader.Read(24);
+  reader.Read(24);
+  EXPECT_EQ(reader.Read(20), expected_sample_rate);
+  EXPECT_EQ(reader.Read(3), 1u);
+  EXPECT_EQ(reader.Read(5), 15u);
+  const u64 total_frames = (u64{reader.Read(4)} << 32) | reader.Read(32);
+  for (int i = 0; i < 4; ++i)
+    reader.Read(32);
+
+  std::vector<s16> out;
+  for (u32 frame_number = 0; !reader.AtEnd(); ++frame_number)
+  {
+    const size_t frame_start = reader.GetBytePosition();
+    EXPECT_EQ(reader.Read(16), 0xFFF8u);
+    EXPECT_EQ(reader.Read(4), 0b0111u);
+    EXPECT_EQ(reader.Read(4), 0u);
+    const u32 assignment = reader.Read(4);
+    EXPECT_EQ(reader.Read(3), 0b100u);
+    EXPECT_EQ(reader.Read(1), 0u);
+
+    u32 number = reader.Read(8);
+    u32 extra_bytes = 0;
+    while (number & (0x80 >> extra_bytes))
+      ++extra_bytes;
+    if (extra_bytes > 0)
+    {
+      number &= 0x7F >> extra_bytes;
+      for (u32 i = 1; i < extra_bytes; ++i)
+        number = (number << 6) | (reader.Read(8) & 0x3F);
+    }
+    EXPECT_EQ(number, frame_number);
+
+    const u32 count = reader.Read(16) + 1;
+    const size_t header_end = reader.GetBytePosition();
+    EXPECT_EQ(reader.Read(8), CRC8(data, frame_start, header_end));
+
+    const bool first_is_side = assignment == 9;
+    const bool second_is_side = assignment == 8 || assignment == 10;
+    const std::vector<s32> first = DecodeSubframe(reader, count, first_is_side ? 17 : 16);
+    const std::vector<s32> second = DecodeSubframe(reader, count, second_is_side ? 17 : 16);
+
+    reader.AlignToByte();
+    const size_t frame_end = reader.GetBytePosition();
+    EXPECT_EQ(reader.Read(16), CRC16(data, frame_start, frame_end));
+
+    for (u32 i = 0; i < count; ++i)
+    {
+      s32 left, right;
+      switch (assignment)
+      {
+      case 1:
+        left = first[i];
+        right = second[i];
+        break;
+      case 8:
+        left = first[i];
+        right = first[i] - second[i];
+        break;
+      case 9:
+        right = second[i];
+        left = first[i] + second[i];
+        break;
+      default:
+      {
+        const s32 mid = (first[i] * 2) | (second[i] & 1);
+        left = (mid + second[i]) >> 1;
+        right = (mid - second[i]) >> 1;
+        break;
+      }
+      }
+      out.push_back(static_cast<s16>(left));
+      out.push_back(static_cast<s16>(right));
+    }
+  }
+
+  EXPECT_EQ(total_frames, out.size() / 2);
+  return out;
+}
+
+std::vector<u8> Encode(const std::vector<s16>& samples, u32 sample_rate)
+{
+  const size_t num_frames = samples.size() / 2;
+  std::vector<u8> data = AudioCommon::FlacEncoder::GetStreamHeader(sample_rate, num_frames);
+  AudioCommon::FlacEncoder encoder;
+  for (size_t frame = 0; frame < num_frames; frame += AudioCommon::FlacEncoder::BLOCK_SIZE)
+  {
+    const u32 count = static_cast<u32>(
+        std::min<size_t>(num_frames - frame, AudioCommon::FlacEncoder::BLOCK_SIZE));
+    encoder.EncodeFrame(samples.data() + frame * 2, count, &data);
+  }
+  return data;
+}
+}  // namespace
+
+TEST(FlacFileWriter, RoundTrip)
+{
+  std::mt19937 rng(0);
+  std::vector<s16> samples;
+
+  // Tones with a bit of noise, which compress well
+  for (int i = 0; i < 10000; ++i)
+  {
+    samples.push_back(static_cast<s16>(8000 * std::sin(i * 0.05) + rng() % 64));
+    samples.push_back(static_cast<s16>(6000 * std::sin(i * 0.031) + rng() % 64));
+  }
+  // Silence, identical channels and channels at the extremes
+  samples.insert(samples.end(), 5000 * 2, 0);
+  for (int i = 0; i < 3000; ++i)
+  {
+    const s16 sample = static_cast<s16>(rng());
+    samples.insert(samples.end(), {sample, sample});
+  }
+  for (int i = 0; i < 3000; ++i)
+    samples.insert(samples.end(), {-32768, 32767});
+  // Noise, which doesn't compress at all
+  for (int i = 0; i < 5000 * 2; ++i)
+    samples.push_back(static_cast<s16>(rng()));
+  // A partial last block
+  for (int i = 0; i < 777 * 2; ++i)
+    samples.push_back(static_cast<s16>(i * 37));
+
+  const std::vector<u8> data = Encode(samples, 32000);
+  EXPECT_EQ(Decode(data, 32000), samples);
+  // The noise alone takes 20000 bytes
+  EXPECT_LT(data.size(), samples.size() * sizeof(s16) / 2);
+}
+
+TEST(FlacFileWriter, ShortStreams)
+{
+  for (const size_t num_frames : {1, 2, 5, 4096, 4097})
+  {
+    std::vector<s16> samples;
+    for (size_t i = 0; i < num_frames * 2; ++i)
+      samples.push_back(static_cast<s16>(i * 1000 - 20000));
+    EXPECT_EQ(Decode(Encode(samples, 48000), 48000), samples);
+  }
+}
+
+class FlacFileWriterDumpTest : public testing::Test
+{
+protected:
+  FlacFileWriterDumpTest()
+      : m_directory(File::CreateTempDir()), m_old_user_path(File::GetUserPath(D_USER_IDX))
+  {
+  }
+
+  ~FlacFileWriterDumpTest() override
+  {
+    File::SetUserPath(D_USER_IDX, m_old_user_path);
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_FALSE(m_directory.empty());
+
+    // Files after the first one are written to the audio dump directory
+    File::SetUserPath(D_USER_IDX, m_directory + "/User/");
+    ASSERT_TRUE(File::CreateFullPath(File::GetUserPath(D_DUMPAUDIO_IDX)));
+  }
+
+  static std::string GetDumpPath(const std::string& name)
+  {
+    return File::GetUserPath(D_DUMPAUDIO_IDX) + name;
+  }
+
+  static std::vector<u8> ReadDump(const std::string& name)
+  {
+    std::string contents;
+    EXPECT_TRUE(File::ReadFileToString(GetDumpPath(name), contents));
+    return std::vector<u8>(contents.begin(), contents.end());
+  }
+
+  // Adds the left and right <samples> the way the mixer passes them: big endian, right first
+  static void AddSamples(AudioCommon::FlacFileWriter* writer, const std::vector<s16>& samples,
+                         size_t first_frame, size_t num_frames, u32 sample_rate)
+  {
+    std::vector<short> data(num_frames * 2);
+    for (size_t i = 0; i < num_frames; ++i)
+    {
+      data[i * 2] = static_cast<short>(Common::swap16(u16(samples[(first_frame + i) * 2 + 1])));
+      data[i * 2 + 1] = static_cast<short>(Common::swap16(u16(samples[(first_frame + i) * 2])));
+    }
+    writer->AddStereoSamplesBE(data.data(), static_cast<u32>(num_frames),
+                               GetSampleRateDivisor(sample_rate), 256, 256);
+  }
+
+  static u32 GetSampleRateDivisor(u32 sample_rate)
+  {
+    return static_cast<u32>(Mixer::FIXED_SAMPLE_RATE_DIVIDEND / sample_rate);
+  }
+
+  const std::string m_directory;
+  const std::string m_old_user_path;
+};
+
+TEST_F(FlacFileWriterDumpTest, StopWritesEverything)
+{
+  std::mt19937 rng(5);
+  std::vector<s16> samples;
+  for (int i = 0; i < 30000; ++i)
+  {
+    samples.push_back(static_cast<s16>(8000 * std::sin(i * 0.02) + rng() % 256));
+    samples.push_back(static_cast<s16>(rng()));
+  }
+
+  {
+    AudioCommon::FlacFileWriter writer;
+    ASSERT_TRUE(writer.Start(GetDumpPath("dsp.flac"), GetSampleRateDivisor(32000)));
+
+    // Uneven batches, so that the worker thread gets partial blocks, and a last block which is
+    // only encoded when stopping
+    size_t frame = 0;
+    for (size_t batch = 1; frame < samples.size() / 2; batch = batch * 3 % 1001)
+    {
+      const size_t count = std::min(batch, samples.size() / 2 - frame);
+      AddSamples(&writer, samples, frame, count, 32000);
+      frame += count;
+    }
+    writer.Stop();
+  }
+
+  EXPECT_EQ(Decode(ReadDump("dsp.flac"), 32000), samples);
+  EXPECT_FALSE(File::Exists(GetDumpPath("dsp1.flac")));
+}
+
+TEST_F(FlacFileWriterDumpTest, EmptyDump)
+{
+  AudioCommon::FlacFileWriter writer;
+  ASSERT_TRUE(writer.Start(GetDumpPath("dtk.flac"), GetSampleRateDivisor(48000)));
+  writer.Stop();
+
+  EXPECT_TRUE(Decode(ReadDump("dtk.flac"), 48000).empty());
+}
+
+TEST_F(FlacFileWriterDumpTest, SampleRateChangeStartsNewFile)
+{
+  std::vector<s16> samples;
+  for (int i = 0; i < 2 * 10000; ++i)
+    samples.push_back(static_cast<s16>(i * 13));
+
+  AudioCommon::FlacFileWriter writer;
+  ASSERT_TRUE(writer.Start(GetDumpPath("dsp.flac"), GetSampleRateDivisor(32000)));
+  AddSamples(&writer, samples, 0, 5000, 32000);
+  AddSamples(&writer, samples, 5000, 3000, 48000);
+  AddSamples(&writer, samples, 8000, 2000, 32000);
+  writer.Stop();
+
+  const auto frames = [&](size_t first, size_t count) {
+    return std::vector<s16>(samples.begin() + first * 2, samples.begin() + (first + count) * 2);
+  };
+  EXPECT_EQ(Decode(ReadDump("dsp.flac"), 32000), frames(0, 5000));
+  EXPECT_EQ(Decode(ReadDump("dsp1.flac"), 48000), frames(5000, 3000));
+  EXPECT_EQ(Decode(ReadDump("dsp2.flac"), 32000), frames(8000, 2000));
+
+  // The writer can be started again after stopping
+  ASSERT_TRUE(writer.Start(GetDumpPath("dsp_again.flac"), GetSampleRateDivisor(32000)));
+  AddSamples(&writer, samples, 0, 100, 32000);
+  writer.Stop();
+  EXPECT_EQ(Decode(ReadDump("dsp_again.flac"), 32000), frames(0, 100));
+}
@@ -0,0 +1,113 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "AudioCommon/MixerResample.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+// Like the ring buffer of a Mixer FIFO
+constexpr u32 RING_SIZE = 4096 * 2;
+constexpr u32 INDEX_MASK = RING_SIZE - 1;
+constexpr u32 MAX_FRAMES = 1024;
+
+std::vector<s16> CreateRing()
+{
+  // Only use the raw generator output, which is the same with every standard library
+  std::mt19937 rng(1234);
+  std::vector<s16> ring(RING_SIZE + 2);
+  for (u32 i = 0; i < RING_SIZE; ++i)
+    ring[i] = static_cast<s16>(rng() >> 16);
+  // Full scale steps, which make the interpolation wrap around
+  for (u32 i = 0; i < 16; ++i)
+    ring[RING_SIZE - 16 + i] = i % 4 < 2 ? -0x8000 : 0x7FFF;
+  ring[RING_SIZE] = ring[0];
+  ring[RING_SIZE + 1] = ring[1];
+  return ring;
+}
+
+using ResampleAddFunction = u32 (*)(s32*, u32, const s16*, u32, u32, bool, u32, s32, s32, u32*,
+                                    u32*);
+
+struct ResampleResult
+{
+  std::vector<s32> samples;
+  u32 frames;
+  u32 index_r;
+  u32 frac;
+};
+
+ResampleResult Resample(ResampleAddFunction function, const std::vector<s16>& ring, u32 num_frames,
+                        u32 index_r, u32 index_w, bool swap_bytes, u32 ratio, u32 frac)
+{
+  ResampleResult result{std::vector<s32>(MAX_FRAMES * 2, 1000), 0, index_r, frac};
+  result.frames = function(result.samples.data(), num_frames, ring.data(), INDEX_MASK, index_w,
+                           swap_bytes, ratio, 256, 258, &result.index_r, &result.frac);
+  return result;
+}
+}  // namespace
+
+TEST(MixerResample, MatchesGeneric)
+{
+  const std::vector<s16> ring = CreateRing();
+
+  // Downsampling from 48 kHz, no resampling, and upsampling of the Wii Remote speaker
+  for (u32 ratio : {0x11698u, 0x10000u, 0xB9BCu, 0x1000u, 0x2F1A3u})
+  {
+    for (bool swap_bytes : {false, true})
+    {
+      // Starting right before the end of the ring, and stopping at the write index
+      for (u32 index_r : {0u, RING_SIZE - 2, RING_SIZE - 40, 0xFFFFFFF0u})
+      {
+        for (u32 available : {RING_SIZE - 2, 100u, 3u, 0u})
+        {
+          for (u32 num_frames : {MAX_FRAMES, 0x21u, 1u})
+          {
+            const u32 index_w = index_r + available;
+            const ResampleResult expected =
+                Resample(AudioCommon::MixerResample::ResampleAddGeneric, ring, num_frames, index_r,
+                         index_w, swap_bytes, ratio, 0x1234);
+            const ResampleResult actual =
+                Resample(AudioCommon::MixerResample::ResampleAdd, ring, num_frames, index_r,
+                         index_w, swap_bytes, ratio, 0x1234);
+
+            const auto description = fmt::format("ratio {:#x}, swap {}, index {:#x}, {} available, "
+                                                 "{} frames",
+                                                 ratio, swap_bytes, index_r, available, num_frames);
+            EXPECT_EQ(expected.samples, actual.samples) << description;
+            EXPECT_EQ(expected.frames, actual.frames) << description;
+            EXPECT_EQ(expected.index_r, actual.index_r) << description;
+            EXPECT_EQ(expected.frac, actual.frac) << description;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(MixerResample, ClampMatchesGeneric)
+{
+  std::mt19937 rng(1234);
+  std::vector<s32> mixed(MAX_FRAMES * 2);
+  // Sums of up to 8 FIFOs
+  for (s32& sample : mixed)
+    sample = static_cast<s32>(rng() >> 13) - 0x40000;
+  mixed[0] = -0x8000;
+  mixed[1] = 0x8000;
+
+  for (size_t count : {size_t(0), size_t(1), size_t(7), size_t(9), mixed.size()})
+  {
+    std::vector<s16> expected(mixed.size());
+    std::vector<s16> actual(mixed.size());
+    AudioCommon::MixerResample::ClampToS16Generic(expected.data(), mixed.data(), count);
+    AudioCommon::MixerResample::ClampToS16(actual.data(), mixed.data(), count);
+    EXPECT_EQ(expected, actual) << count << " samples";
+  }
+}
@@ -0,0 +1,101 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <FreeSurround/FreeSurroundDecoder.h>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "AudioCommon/SurroundDecoder.h"
+#include "Common/CommonTypes.h"
+
+namespace
+{
+constexpr u32 SAMPLE_RATE = 48000;
+constexpr size_t STEREO_CHANNELS = 2;
+constexpr size_t SURROUND_CHANNELS = 6;
+
+std::vector<s16> GenerateStereo(size_t num_frames)
+{
+  std::mt19937 rng(0);
+  std::vector<s16> samples(num_frames * STEREO_CHANNELS);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<s16>(rng() % 0x10000);
+  return samples;
+}
+
+// Decodes on the calling thread, the way SurroundDecoder did before it got its own thread
+std::vector<float> DecodeDirectly(const std::vector<s16>& in, u32 frame_block_size)
+{
+  DPL2FSDecoder decoder;
+  decoder.Init(cs_5point1, frame_block_size, SAMPLE_RATE);
+
+  std::vector<float> out;
+  std::vector<float> block(frame_block_size * STEREO_CHANNELS);
+  for (size_t frame = 0; frame + frame_block_size <= in.size() / STEREO_CHANNELS;
+       frame += frame_block_size)
+  {
+    for (size_t i = 0; i < block.size(); ++i)
+    {
+      block[i] = in[frame * STEREO_CHANNELS + i] /
+                 static_cast<float>(std::numeric_limits<short>::max());
+    }
+
+    const float* decoded = decoder.decode(block.data());
+    for (size_t i = 0; i < frame_block_size; ++i)
+    {
+      for (const size_t channel : {0, 2, 1, 5, 3, 4})
+        out.push_back(decoded[i * SURROUND_CHANNELS + channel]);
+    }
+  }
+  return out;
+}
+}  // namespace
+
+TEST(SurroundDecoder, MatchesDirectDecoding)
+{
+  for (const u32 frame_block_size : {256u, 512u, 4096u})
+  {
+    SCOPED_TRACE(testing::Message() << "block size " << frame_block_size);
+
+    // More than the ring holds, so that it wraps around
+    const std::vector<s16> stereo = GenerateStereo(frame_block_size * 40);
+    const std::vector<float> expected = DecodeDirectly(stereo, frame_block_size);
+
+    AudioCommon::SurroundDecoder decoder(SAMPLE_RATE, frame_block_size);
+    std::vector<float> received;
+    size_t frames_put = 0;
+    std::array<float, 500 * SURROUND_CHANNELS> callback_buffer;
+    // Fail instead of hanging if the decoder thread stops decoding
+    auto last_progress = std::chrono::steady_clock::now();
+    while (received.size() < expected.size())
+    {
+      ASSERT_LT(std::chrono::steady_clock::now() - last_progress, std::chrono::seconds(10))
+          << "the decoder made no progress";
+
+      // Like Mixer::MixSurround, with an odd callback size
+      const size_t needed = std::min(decoder.QueryFramesNeededForSurroundOutput(500),
+                                     stereo.size() / STEREO_CHANNELS - frames_put);
+      decoder.PutFrames(stereo.data() + frames_put * STEREO_CHANNELS, needed);
+      frames_put += needed;
+
+      const size_t frames = decoder.ReceiveFrames(callback_buffer.data(), 500);
+      if (frames != 0)
+        last_progress = std::chrono::steady_clock::now();
+      for (size_t i = frames * SURROUND_CHANNELS; i < callback_buffer.size(); ++i)
+        ASSERT_EQ(callback_buffer[i], 0.0f);
+      received.insert(received.end(), callback_buffer.begin(),
+                      callback_buffer.begin() + frames * SURROUND_CHANNELS);
+      std::this_thread::yield();
+    }
+
+    ASSERT_EQ(received.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+      ASSERT_EQ(received[i], expected[i]) << "at sample " << i;
+  }
+}
@@ -0,0 +1,169 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+#include "Common/Crypto/SHA1.h"
+
+namespace
+{
+constexpr std::array<u8, 16> KEY = {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+// Same layout as a Wii disc block: 0x400 bytes of hashes followed by 0x7c00 bytes of data
+constexpr size_t BUFFER_SIZE = 0x7c00;
+constexpr size_t BUFFER_COUNT = 64;
+
+struct Buffers
+{
+  Buffers()
+  {
+    for (size_t i = 0; i < input.size(); ++i)
+      input[i] = static_cast<u8>(i * 31 + 7);
+    for (size_t i = 0; i < ivs.size(); ++i)
+      ivs[i] = static_cast<u8>(i * 13);
+
+    for (size_t i = 0; i < BUFFER_COUNT; ++i)
+    {
+      iv_ptrs[i] = &ivs[i * Common::AES::Context::BLOCK_SIZE];
+      in_ptrs[i] = &input[i * BUFFER_SIZE];
+      out_ptrs[i] = &output[i * BUFFER_SIZE];
+    }
+  }
+
+  std::vector<u8> input = std::vector<u8>(BUFFER_COUNT * BUFFER_SIZE);
+  std::vector<u8> output = std::vector<u8>(BUFFER_COUNT * BUFFER_SIZE);
+  std::vector<u8> ivs = std::vector<u8>(BUFFER_COUNT * Common::AES::Context::BLOCK_SIZE);
+  std::array<const u8*, BUFFER_COUNT> iv_ptrs;
+  std::array<const u8*, BUFFER_COUNT> in_ptrs;
+  std::array<u8*, BUFFER_COUNT> out_ptrs;
+};
+
+void CheckCryptMultiple(const Common::AES::Context& context)
+{
+  Buffers buffers;
+  std::vector<u8> expected(buffers.output.size());
+
+  // Cover both the interleaved path and the leftover buffers
+  for (size_t count : {1, 7, 8, 9, 17, 64})
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      context.Crypt(buffers.iv_ptrs[i], buffers.in_ptrs[i], &expected[i * BUFFER_SIZE],
+                    BUFFER_SIZE);
+    }
+    ASSERT_TRUE(context.CryptMultiple(buffers.iv_ptrs.data(), buffers.in_ptrs.data(),
+                                      buffers.out_ptrs.data(), count, BUFFER_SIZE));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.begin() + count * BUFFER_SIZE,
+                           buffers.output.begin()))
+        << count << " buffers";
+
+    for (size_t i = 0; i < count; ++i)
+      context.CryptIvZero(buffers.in_ptrs[i], &expected[i * BUFFER_SIZE], BUFFER_SIZE);
+    ASSERT_TRUE(context.CryptMultiple(nullptr, buffers.in_ptrs.data(), buffers.out_ptrs.data(),
+                                      count, BUFFER_SIZE));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.begin() + count * BUFFER_SIZE,
+                           buffers.output.begin()))
+        << count << " buffers with zero IV";
+  }
+}
+
+template <typename Function>
+double MeasureMiBPerSecond(size_t bytes, Function function)
+{
+  constexpr int ITERATIONS = 8;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i)
+    function();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  return bytes * ITERATIONS / elapsed.count() / (1024 * 1024);
+}
+}  // namespace
+
+// NIST SP 800-38A F.2.1 and F.2.2
+TEST(AES, CBCVectors)
+{
+  constexpr std::array<u8, 16> iv = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                     0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  constexpr std::array<u8, 32> plaintext = {
+      0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e,
+      0x11, 0x73, 0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03,
+      0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51};
+  constexpr std::array<u8, 32> ciphertext = {
+      0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e,
+      0x9b, 0x12, 0xe9, 0x19, 0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72,
+      0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2};
+
+  std::array<u8, 32> result;
+  Common::AES::CreateContextEncrypt(KEY.data())
+      ->Crypt(iv.data(), plaintext.data(), result.data(), result.size());
+  EXPECT_EQ(ciphertext, result);
+
+  Common::AES::CreateContextDecrypt(KEY.data())
+      ->Crypt(iv.data(), ciphertext.data(), result.data(), result.size());
+  EXPECT_EQ(plaintext, result);
+}
+
+TEST(AES, EncryptMultipleMatchesSingle)
+{
+  CheckCryptMultiple(*Common::AES::CreateContextEncrypt(KEY.data()));
+}
+
+TEST(AES, DecryptMultipleMatchesSingle)
+{
+  CheckCryptMultiple(*Common::AES::CreateContextDecrypt(KEY.data()));
+}
+
+// Not a correctness test, but useful for comparing the throughput of the different code paths.
+// The numbers are only printed, since they depend on the machine running the tests, so this is
+// disabled. Run it with --gtest_also_run_disabled_tests --gtest_filter=AES.DISABLED_Throughput
+TEST(AES, DISABLED_Throughput)
+{
+  Buffers buffers;
+  const size_t bytes = buffers.input.size();
+
+  const auto encrypt = Common::AES::CreateContextEncrypt(KEY.data());
+  const auto decrypt = Common::AES::CreateContextDecrypt(KEY.data());
+
+  const double encrypt_single = MeasureMiBPerSecond(bytes, [&] {
+    for (size_t i = 0; i < BUFFER_COUNT; ++i)
+      encrypt->Crypt(buffers.iv_ptrs[i], buffers.in_ptrs[i], buffers.out_ptrs[i], BUFFER_SIZE);
+  });
+  const double encrypt_multiple = MeasureMiBPerSecond(bytes, [&] {
+    encrypt->CryptMultiple(buffers.iv_ptrs.data(), buffers.in_ptrs.data(),
+                           buffers.out_ptrs.data(), BUFFER_COUNT, BUFFER_SIZE);
+  });
+  const double decrypt_single = MeasureMiBPerSecond(bytes, [&] {
+    for (size_t i = 0; i < BUFFER_COUNT; ++i)
+      decrypt->Crypt(buffers.iv_ptrs[i], buffers.in_ptrs[i], buffers.out_ptrs[i], BUFFER_SIZE);
+  });
+  const double decrypt_multiple = MeasureMiBPerSecond(bytes, [&] {
+    decrypt->CryptMultiple(buffers.iv_ptrs.data(), buffers.in_ptrs.data(),
+                           buffers.out_ptrs.data(), BUFFER_COUNT, BUFFER_SIZE);
+  });
+
+  // Hash the data the same way as the H0 hashes of a Wii disc group
+  constexpr size_t H0_HASHED_SIZE = 0x400;
+  const double sha1 = MeasureMiBPerSecond(bytes, [&] {
+    for (size_t offset = 0; offset < bytes; offset += H0_HASHED_SIZE)
+      Common::SHA1::CalculateDigest(&buffers.input[offset], H0_HASHED_SIZE);
+  });
+
+  fmt::print("AES-CBC encrypt: {:.0f} MiB/s single, {:.0f} MiB/s multiple\n", encrypt_single,
+             encrypt_multiple);
+  fmt::print("AES-CBC decrypt: {:.0f} MiB/s single, {:.0f} MiB/s multiple\n", decrypt_single,
+             decrypt_multiple);
+  fmt::print("SHA-1 (H0): {:.0f} MiB/s (hardware accelerated: {})\n", sha1,
+             Common::SHA1::CreateContext()->HwAccelerated());
+}
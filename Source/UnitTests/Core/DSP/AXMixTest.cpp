@@ -0,0 +1,134 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/AXMix.h"
+
+namespace
+{
+// Like a frame of an AX Wii voice list: each voice is mixed into the L/R/S channels of the main
+// and three aux buses.
+constexpr u32 VOICE_COUNT = 64;
+constexpr u32 BUS_COUNT = 12;
+constexpr u32 SAMPLES_PER_FRAME = 96;
+
+struct Voice
+{
+  std::array<s16, SAMPLES_PER_FRAME> samples;
+  s16 envelope_volume;
+  s16 envelope_delta;
+  std::array<u16, BUS_COUNT> volumes;
+  std::array<u16, BUS_COUNT> volume_deltas;
+};
+
+std::vector<Voice> CreateVoices()
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<int> dist(-0x8000, 0x7FFF);
+
+  std::vector<Voice> voices(VOICE_COUNT);
+  for (u32 i = 0; i < VOICE_COUNT; ++i)
+  {
+    Voice& voice = voices[i];
+    for (s16& sample : voice.samples)
+      sample = static_cast<s16>(dist(rng));
+    voice.envelope_volume = static_cast<s16>(dist(rng));
+    voice.envelope_delta = static_cast<s16>(dist(rng) >> 6);
+    for (u32 bus = 0; bus < BUS_COUNT; ++bus)
+    {
+      voice.volumes[bus] = static_cast<u16>(dist(rng));
+      // Every other voice ramps, with deltas large enough to wrap around
+      voice.volume_deltas[bus] = i % 2 ? static_cast<u16>(dist(rng) >> 4) : 0;
+    }
+  }
+  return voices;
+}
+
+using MixAddFunction = void (*)(int*, const s16*, u32, u16*, u16, s16*);
+using ApplyVolumeFunction = void (*)(s16*, u32, s16*, s16, bool);
+
+struct MixResult
+{
+  std::array<std::array<int, SAMPLES_PER_FRAME>, BUS_COUNT> buses{};
+  std::vector<u16> volumes;
+  std::vector<s16> dpops;
+  std::vector<s16> envelope_volumes;
+};
+
+MixResult Mix(std::vector<Voice> voices, u32 count, bool is_signed, MixAddFunction mix_add,
+              ApplyVolumeFunction apply_volume)
+{
+  MixResult result;
+  for (Voice& voice : voices)
+  {
+    apply_volume(voice.samples.data(), count, &voice.envelope_volume, voice.envelope_delta,
+                 is_signed);
+    result.envelope_volumes.push_back(voice.envelope_volume);
+
+    for (u32 bus = 0; bus < BUS_COUNT; ++bus)
+    {
+      s16 dpop = 0;
+      mix_add(result.buses[bus].data(), voice.samples.data(), count, &voice.volumes[bus],
+              voice.volume_deltas[bus], &dpop);
+      result.volumes.push_back(voice.volumes[bus]);
+      result.dpops.push_back(dpop);
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST(AXMix, MatchesGeneric)
+{
+  using namespace DSP::HLE;
+  const std::vector<Voice> voices = CreateVoices();
+
+  // GameCube frames have 32 samples and Wii frames have 96. Odd counts cover the scalar tail.
+  for (u32 count : {0u, 1u, 5u, 32u, 37u, 96u})
+  {
+    for (bool is_signed : {true, false})
+    {
+      const MixResult expected =
+          Mix(voices, count, is_signed, AXMix::MixAddGeneric, AXMix::ApplyVolumeGeneric);
+      const MixResult actual = Mix(voices, count, is_signed, AXMix::MixAdd, AXMix::ApplyVolume);
+
+      EXPECT_EQ(expected.buses, actual.buses) << count << " samples, signed " << is_signed;
+      EXPECT_EQ(expected.volumes, actual.volumes) << count << " samples, signed " << is_signed;
+      EXPECT_EQ(expected.dpops, actual.dpops) << count << " samples, signed " << is_signed;
+      EXPECT_EQ(expected.envelope_volumes, actual.envelope_volumes)
+          << count << " samples, signed " << is_signed;
+    }
+  }
+}
+
+// Not a correctness test, but useful for comparing the generic and vectorized code paths. The
+// numbers are only printed, since they depend on the machine running the tests, so this is
+// disabled. Run it with --gtest_also_run_disabled_tests --gtest_filter=AXMix.DISABLED_Throughput
+TEST(AXMix, DISABLED_Throughput)
+{
+  using namespace DSP::HLE;
+  const std::vector<Voice> voices = CreateVoices();
+  constexpr int FRAMES = 2000;
+
+  const auto measure = [&](MixAddFunction mix_add, ApplyVolumeFunction apply_volume) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < FRAMES; ++i)
+      Mix(voices, SAMPLES_PER_FRAME, false, mix_add, apply_volume);
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / FRAMES;
+  };
+
+  const double generic = measure(AXMix::MixAddGeneric, AXMix::ApplyVolumeGeneric);
+  const double vectorized = measure(AXMix::MixAdd, AXMix::ApplyVolume);
+  fmt::print("AX mixing of {} voices: {:.1f} us per frame generic, {:.1f} us vectorized\n",
+             VOICE_COUNT, generic, vectorized);
+}
@@ -0,0 +1,277 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#define AX_WII  // Used in AXVoice.h
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/ChunkFile.h"
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/DSPHLE.h"
+#include "Core/HW/DSPHLE/UCodes/AXStructs.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoice.h"
+#include "Core/HW/DSPHLE/UCodes/AXVoiceWorkers.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+
+using namespace DSP::HLE;
+
+namespace
+{
+// Any ucode with a low pass filter in its PB layout
+constexpr u32 CRC = 0;
+
+constexpr u32 PB_BASE = 0x00100000;
+constexpr u32 PB_STRIDE = 0x200;
+constexpr u32 SAMPLES = 96;
+constexpr u32 WM_SAMPLES = 18;
+
+// Same layout as the buffers of AXWiiUCode
+constexpr std::array<u32, 20> BUFFER_SIZES = {
+    96, 96, 96, 96, 96, 96, 96, 96, 96, 96, 96, 96, 18, 18, 18, 18, 18, 18, 18, 18};
+
+using ProcessPB = std::function<void(AXPBWii&, AXBuffers, HLEAccelerator*)>;
+
+// Stands in for ProcessVoice, which would need ARAM. Like it, this mixes samples into several
+// buffers, advances the volumes and leaves the accelerator set up for the PB.
+void ProcessSyntheticVoice(AXPBWii& pb, AXBuffers buffers, HLEAccelerator* accelerator)
+{
+  if (pb.running != 1)
+    return;
+
+  AcceleratorSetup(accelerator, &pb);
+
+  std::array<s16, SAMPLES> samples;
+  for (u32 i = 0; i < SAMPLES; ++i)
+    samples[i] = static_cast<s16>(accelerator->GetCurrentAddress() * 31 + i * 977);
+
+  AXMix::ApplyVolume(samples.data(), SAMPLES, &pb.vol_env.cur_volume, pb.vol_env.cur_volume_delta,
+                     false);
+  MixAdd(buffers.main_left, samples.data(), SAMPLES, &pb.mixer.main_left, &pb.dpop.main_left, true);
+  MixAdd(buffers.auxA_right, samples.data(), SAMPLES, &pb.mixer.auxA_right, &pb.dpop.auxA_right,
+         false);
+  MixAdd(buffers.auxC_surround, samples.data(), SAMPLES, &pb.mixer.auxC_surround,
+         &pb.dpop.auxC_surround, true);
+  MixAdd(buffers.wm_aux2, samples.data(), WM_SAMPLES, &pb.remote_mixer.aux2, &pb.remote_dpop.aux2,
+         true);
+
+  accelerator->SetCurrentAddress(accelerator->GetCurrentAddress() + SAMPLES);
+  accelerator->SetYn1(samples[SAMPLES - 1]);
+  pb.audio_addr.cur_addr_hi = static_cast<u16>(accelerator->GetCurrentAddress() >> 16);
+  pb.audio_addr.cur_addr_lo = static_cast<u16>(accelerator->GetCurrentAddress());
+  pb.adpcm.yn1 = accelerator->GetYn1();
+}
+
+struct Result
+{
+  std::array<std::vector<int>, BUFFER_SIZES.size()> buffers;
+  std::vector<u8> pbs;
+  std::array<u8, 32> accelerator_state{};
+};
+}  // namespace
+
+class AXVoiceWorkersTest : public testing::Test
+{
+protected:
+  AXVoiceWorkersTest()
+      : m_system(Core::System::GetInstance()), m_dsphle(m_system),
+        m_accelerator(m_system.GetDSP()), m_workers(3)
+  {
+  }
+
+  void SetUp() override
+  {
+    m_system.GetMemory().Init();
+    m_accelerator.SetCurrentAddress(0x1234);
+  }
+
+  void TearDown() override { m_system.GetMemory().Shutdown(); }
+
+  // Writes count PBs and links them in a scrambled order, so that list order and address order
+  // differ. Every fifth voice is stopped, including the last one in the list.
+  u32 WritePBList(u32 count, u32 stride = PB_STRIDE)
+  {
+    // A permutation as long as count isn't a multiple of 13
+    const auto slot = [&](u32 i) { return i * 13 % count; };
+    const auto address = [&](u32 i) { return PB_BASE + slot(i) * stride; };
+
+    std::vector<AXPBWii> pbs(count);
+    for (u32 i = 0; i < count; ++i)
+    {
+      AXPBWii& pb = pbs[slot(i)];
+      const u32 next = i + 1 < count ? address(i + 1) : 0;
+      pb.next_pb_hi = static_cast<u16>(next >> 16);
+      pb.next_pb_lo = static_cast<u16>(next);
+      pb.running = (count - 1 - i) % 5 != 0;
+      pb.mixer.main_left = {static_cast<u16>(0x4000 + i * 0x100), 0x10};
+      pb.mixer.auxA_right = {static_cast<u16>(0x8000 - i * 0x80), 0};
+      pb.mixer.auxC_surround = {0x7000, static_cast<u16>(0xFFF0 + i)};
+      pb.remote_mixer.aux2 = {static_cast<u16>(0x2000 + i), 0x20};
+      pb.vol_env.cur_volume = static_cast<s16>(0x6000 + i * 0x40);
+      pb.vol_env.cur_volume_delta = static_cast<s16>(static_cast<int>(i % 3) - 1);
+      pb.audio_addr.end_addr_hi = 0x0100;
+      pb.audio_addr.cur_addr_lo = static_cast<u16>(i * 0x1000);
+    }
+
+    // In address order, so that PBs which overlap only lose the padding at their end
+    for (u32 i = 0; i < count; ++i)
+      WritePB(m_system.GetMemory(), PB_BASE + i * stride, pbs[i], CRC);
+
+    m_pbs_size = count * stride + sizeof(AXPBWii);
+    return address(0);
+  }
+
+  void Restore(const Result& state)
+  {
+    m_system.GetMemory().CopyToEmu(PB_BASE, state.pbs.data(), state.pbs.size());
+
+    std::array<u8, 32> accelerator_state = state.accelerator_state;
+    u8* ptr = accelerator_state.data();
+    PointerWrap p(&ptr, accelerator_state.size(), PointerWrap::Mode::Read);
+    m_accelerator.DoState(p);
+  }
+
+  // The buffers start out non-empty, since voices are added to what was already mixed
+  static std::array<std::vector<int>, BUFFER_SIZES.size()> MakeBuffers()
+  {
+    std::array<std::vector<int>, BUFFER_SIZES.size()> buffers;
+    for (size_t i = 0; i < buffers.size(); ++i)
+      buffers[i].assign(BUFFER_SIZES[i], static_cast<int>(i * 1000) - 5000);
+    return buffers;
+  }
+
+  static AXBuffers GetPointers(std::array<std::vector<int>, BUFFER_SIZES.size()>& buffers)
+  {
+    AXBuffers pointers;
+    for (size_t i = 0; i < buffers.size(); ++i)
+      pointers.ptrs[i] = buffers[i].data();
+    return pointers;
+  }
+
+  Result GetResult(std::array<std::vector<int>, BUFFER_SIZES.size()> buffers)
+  {
+    Result result;
+    result.buffers = std::move(buffers);
+    result.pbs.resize(m_pbs_size);
+    m_system.GetMemory().CopyFromEmu(result.pbs.data(), PB_BASE, m_pbs_size);
+    u8* ptr = result.accelerator_state.data();
+    PointerWrap p(&ptr, result.accelerator_state.size(), PointerWrap::Mode::Write);
+    m_accelerator.DoState(p);
+    return result;
+  }
+
+  // Like the fallback loop of AXWiiUCode::ProcessPBList
+  Result ProcessSerially(u32 pb_addr, const ProcessPB& process_pb)
+  {
+    auto& memory = m_system.GetMemory();
+    auto buffers = MakeBuffers();
+    const AXBuffers pointers = GetPointers(buffers);
+
+    AXPBWii pb;
+    while (pb_addr)
+    {
+      ReadPB(memory, pb_addr, pb, CRC);
+      process_pb(pb, pointers, &m_accelerator);
+      WritePB(memory, pb_addr, pb, CRC);
+      pb_addr = HILO_TO_32(pb.next_pb);
+    }
+
+    return GetResult(std::move(buffers));
+  }
+
+  bool ProcessInParallel(u32 pb_addr, const ProcessPB& process_pb, Result* result)
+  {
+    auto buffers = MakeBuffers();
+    const bool processed =
+        ProcessPBListInParallel(&m_dsphle, pb_addr, CRC, GetPointers(buffers), BUFFER_SIZES.data(),
+                                &m_workers, &m_accelerator, process_pb);
+    *result = GetResult(std::move(buffers));
+    return processed;
+  }
+
+  static void ExpectSameResult(const Result& expected, const Result& actual)
+  {
+    EXPECT_EQ(expected.buffers, actual.buffers);
+    EXPECT_EQ(expected.pbs, actual.pbs);
+    EXPECT_EQ(expected.accelerator_state, actual.accelerator_state);
+  }
+
+  // A list that can't be processed in parallel must be left exactly as it was, so that the caller
+  // can still process it serially.
+  void ExpectFallback(u32 pb_addr, const ProcessPB& process_pb = ProcessSyntheticVoice)
+  {
+    const Result before = GetResult(MakeBuffers());
+    Result result;
+    EXPECT_FALSE(ProcessInParallel(pb_addr, process_pb, &result));
+    ExpectSameResult(before, result);
+  }
+
+  Core::System& m_system;
+  DSPHLE m_dsphle;
+  HLEAccelerator m_accelerator;
+  AXVoiceWorkers m_workers;
+  u32 m_pbs_size = 0;
+};
+
+TEST_F(AXVoiceWorkersTest, MatchesSerialProcessing)
+{
+  for (u32 count : {8u, 9u, 64u, 200u})
+  {
+    const u32 pb_addr = WritePBList(count);
+
+    // Two frames, so that the second one starts from the PBs and accelerator state left behind by
+    // the first one
+    for (int frame = 0; frame < 2; ++frame)
+    {
+      const Result start = GetResult({});
+      const Result expected = ProcessSerially(pb_addr, ProcessSyntheticVoice);
+
+      Restore(start);
+      Result actual;
+      ASSERT_TRUE(ProcessInParallel(pb_addr, ProcessSyntheticVoice, &actual))
+          << count << " PBs, frame " << frame;
+      ExpectSameResult(expected, actual);
+    }
+  }
+}
+
+TEST_F(AXVoiceWorkersTest, ShortListFallsBack)
+{
+  ExpectFallback(WritePBList(7));
+}
+
+TEST_F(AXVoiceWorkersTest, LoopingListFallsBack)
+{
+  const u32 pb_addr = WritePBList(16);
+  AXPBWii pb;
+  ReadPB(m_system.GetMemory(), pb_addr, pb, CRC);
+  pb.next_pb_hi = static_cast<u16>(pb_addr >> 16);
+  pb.next_pb_lo = static_cast<u16>(pb_addr);
+  WritePB(m_system.GetMemory(), pb_addr, pb, CRC);
+
+  ExpectFallback(pb_addr);
+}
+
+TEST_F(AXVoiceWorkersTest, OverlappingListFallsBack)
+{
+  // Serially, each PB would see the writeback of the PB before it
+  ExpectFallback(WritePBList(16, sizeof(AXPBWii) - 2));
+}
+
+TEST_F(AXVoiceWorkersTest, ModifiedListFallsBack)
+{
+  const u32 pb_addr = WritePBList(16);
+
+  // Like an update of a PB that changes the link to the next PB
+  const ProcessPB unlink = [](AXPBWii& pb, AXBuffers buffers, HLEAccelerator* accelerator) {
+    ProcessSyntheticVoice(pb, buffers, accelerator);
+    if (pb.vol_env.cur_volume_delta == 0 && HILO_TO_32(pb.next_pb) != 0)
+      pb.next_pb_hi = pb.next_pb_lo = 0;
+  };
+  ExpectFallback(pb_addr, unlink);
+}
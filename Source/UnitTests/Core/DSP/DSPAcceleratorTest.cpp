@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <random>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -185,3 +187,96 @@ TEST(DSPAccelerator, CurrentAddressSkips)
   accelerator.TestRead();
   EXPECT_EQ(accelerator.GetCurrentAddress(), 0x00000013u);
 }
+
+// Accelerator backed by memory, which loops like the AX ucode does.
+class MemoryAccelerator : public DSP::Accelerator
+{
+public:
+  explicit MemoryAccelerator(const std::vector<u8>& memory) : m_memory(memory) {}
+
+  bool operator==(const MemoryAccelerator& other) const
+  {
+    return m_start_address == other.m_start_address && m_end_address == other.m_end_address &&
+           m_current_address == other.m_current_address &&
+           m_sample_format == other.m_sample_format && m_yn1 == other.m_yn1 &&
+           m_yn2 == other.m_yn2 && m_pred_scale == other.m_pred_scale &&
+           m_reads_stopped == other.m_reads_stopped &&
+           m_end_exception_count == other.m_end_exception_count;
+  }
+
+  bool m_loop = true;
+
+protected:
+  void OnEndException() override
+  {
+    ++m_end_exception_count;
+    if (!m_loop)
+      return;
+    SetPredScale(m_memory[(m_start_address >> 1) % m_memory.size()]);
+    SetYn1(0x1234);
+    SetYn2(-0x1234);
+  }
+  u8 ReadMemory(u32 address) override { return m_memory[address % m_memory.size()]; }
+  void WriteMemory(u32 address, u8 value) override {}
+
+private:
+  const std::vector<u8>& m_memory;
+  u32 m_end_exception_count = 0;
+};
+
+TEST(DSPAccelerator, ReadSamplesMatchesRead)
+{
+  std::mt19937 rng(0);
+  std::vector<u8> memory(0x400);
+  for (u8& byte : memory)
+    byte = static_cast<u8>(rng());
+  std::array<s16, 16> coefs;
+  for (s16& coef : coefs)
+    coef = static_cast<s16>(rng() % 0x1000) - 0x800;
+
+  for (const u16 format : {0x00, 0x0A, 0x19, 0x05})
+  {
+    for (int test = 0; test < 200; ++test)
+    {
+      SCOPED_TRACE(testing::Message() << "format " << format << ", test " << test);
+
+      MemoryAccelerator single(memory);
+      single.m_loop = test % 4 != 0;
+      single.SetSampleFormat(format);
+      // Cover all the special cases for the low bits of the end address
+      const u32 start = 0x200 + rng() % 0x40;
+      const u32 end = start + 0x20 + rng() % 0x60;
+      single.SetStartAddress(start);
+      single.SetEndAddress(end);
+      single.SetCurrentAddress(start + rng() % (end - start));
+      single.SetPredScale(static_cast<u16>(rng()));
+      single.SetYn1(static_cast<s16>(rng()));
+      single.SetYn2(static_cast<s16>(rng()));
+
+      MemoryAccelerator batch(memory);
+      batch.m_loop = single.m_loop;
+      batch.SetSampleFormat(format);
+      batch.SetStartAddress(single.GetStartAddress());
+      batch.SetEndAddress(single.GetEndAddress());
+      batch.SetCurrentAddress(single.GetCurrentAddress());
+      batch.SetPredScale(single.GetPredScale());
+      batch.SetYn1(single.GetYn1());
+      batch.SetYn2(single.GetYn2());
+
+      for (int batch_index = 0; batch_index < 20; ++batch_index)
+      {
+        const u32 count = 1 + rng() % 40;
+        std::array<s16, 40> expected;
+        for (u32 i = 0; i < count; ++i)
+          expected[i] = static_cast<s16>(single.Read(coefs.data()));
+
+        std::array<s16, 40> samples;
+        batch.ReadSamples(samples.data(), count, coefs.data());
+
+        for (u32 i = 0; i < count; ++i)
+          EXPECT_EQ(samples[i], expected[i]);
+        EXPECT_TRUE(batch == single);
+      }
+    }
+  }
+}
@@ -0,0 +1,163 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/DSP/DSPAnalyzer.h"
+#include "Core/DSP/DSPCore.h"
+#include "Core/DSP/DSPTables.h"
+
+namespace
+{
+constexpr u16 LOOP_START = 0x0010;
+}
+
+class DSPAnalyzerTest : public testing::Test
+{
+protected:
+  static void SetUpTestSuite() { DSP::InitInstructionTable(); }
+
+  void SetUp() override
+  {
+    m_dsp.iram = m_iram.data();
+    m_dsp.irom = m_irom.data();
+  }
+
+  void TearDown() override
+  {
+    m_dsp.iram = nullptr;
+    m_dsp.irom = nullptr;
+  }
+
+  // Places <code> at <address> in otherwise empty memory, and returns whether the analyzer marks
+  // it as an idle skip.
+  bool IsIdleSkip(std::initializer_list<u16> code, u16 address = LOOP_START)
+  {
+    m_iram.fill(0);
+    m_irom.fill(0);
+    u16* const memory = address >= 0x8000 ? m_irom.data() : m_iram.data();
+    std::copy(code.begin(), code.end(), memory + (address & 0x0fff));
+
+    DSP::Analyzer& analyzer = m_dsp.GetAnalyzer();
+    analyzer.Analyze(m_dsp);
+    return analyzer.IsIdleSkip(address);
+  }
+
+  DSP::DSPCore m_core;
+  DSP::SDSP& m_dsp = m_core.DSPState();
+  std::array<u16, 0x1000> m_iram{};
+  std::array<u16, 0x1000> m_irom{};
+};
+
+TEST_F(DSPAnalyzerTest, AXMailWaitLoops)
+{
+  EXPECT_TRUE(IsIdleSkip({
+      0x26fc,          // LRS   $AC0.M, @DMBH
+      0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+      0x029d, 0x0010,  // JLZ   0x0010
+      0x02df,          // RET
+  }));
+  EXPECT_TRUE(IsIdleSkip({
+      0x27fe,          // LRS   $AC1.M, @CMBH
+      0x03c0, 0x8000,  // ANDCF $AC1.M, #0x8000
+      0x029c, 0x0010,  // JLNZ  0x0010
+      0x02df,          // RET
+  }));
+  // The same loop in the ROM, as wait_for_cpu_mbox
+  EXPECT_TRUE(IsIdleSkip(
+      {
+          0x26fe,          // LRS   $AC0.M, @CMBH
+          0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+          0x029c, 0x8070,  // JLNZ  0x8070
+          0x02df,          // RET
+      },
+      0x8070));
+}
+
+TEST_F(DSPAnalyzerTest, ZeldaWaitLoops)
+{
+  EXPECT_TRUE(IsIdleSkip({
+      0x00de, 0xfffe,  // LR    $AC0.M, @CMBH
+      0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+      0x029c, 0x0010,  // JLNZ  0x0010
+  }));
+  // Waits for a flag in DMEM, which an interrupt handler sets
+  EXPECT_TRUE(IsIdleSkip({
+      0x00da, 0x0352,  // LR     $AX0.H, @0x0352
+      0x8600,          // TSTAXH $AX0.H
+      0x0295, 0x0010,  // JZ     0x0010
+  }));
+}
+
+// There are no signatures for the GBA ucode or other small ucodes, so their loops have to be found
+// by their shape.
+TEST_F(DSPAnalyzerTest, LoopsWithoutSignatures)
+{
+  EXPECT_TRUE(IsIdleSkip({
+      0x00df, 0xfffe,  // LR   $AC1.M, @CMBH
+      0x03a0, 0x8000,  // ANDF $AC1.M, #0x8000
+      0x029d, 0x0010,  // JLZ  0x0010
+      0x02df,          // RET
+  }));
+  EXPECT_TRUE(IsIdleSkip({
+      0x00db, 0x0400,  // LR     $AX1.H, @0x0400
+      0x0000,          // NOP
+      0x8700,          // TSTAXH $AX1.H
+      0x0295, 0x0010,  // JZ     0x0010
+  }));
+  EXPECT_TRUE(IsIdleSkip({
+      0x00de, 0x0400,  // LR   $AC0.M, @0x0400
+      0x0280, 0x0003,  // CMPI $AC0.M, #0x0003
+      0x0294, 0x0010,  // JNZ  0x0010
+  }));
+}
+
+TEST_F(DSPAnalyzerTest, LoopsWhichChangeStateAreNotSkipped)
+{
+  // Counts how long it waits for, so every iteration matters
+  EXPECT_FALSE(IsIdleSkip({
+      0x26fe,          // LRS   $AC0.M, @CMBH
+      0x7700,          // INC   $AC1
+      0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+      0x029c, 0x0010,  // JLNZ  0x0010
+  }));
+  // Writes to DMEM
+  EXPECT_FALSE(IsIdleSkip({
+      0x26fe,          // LRS   $AC0.M, @CMBH
+      0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+      0x2e10,          // SRS   @0x0010, $AC0.M
+      0x029c, 0x0010,  // JLNZ  0x0010
+  }));
+  // Loads into the stack registers, which pushes them
+  EXPECT_FALSE(IsIdleSkip({
+      0x00cc, 0xfffe,  // LR    $ST0, @CMBH
+      0x029c, 0x0010,  // JLNZ  0x0010
+  }));
+}
+
+TEST_F(DSPAnalyzerTest, LoopsWhichCantWaitForTheCPUAreNotSkipped)
+{
+  // DMAs finish instantly, and the ROM's wait_dma has no signature
+  EXPECT_FALSE(IsIdleSkip({
+      0x26c9,          // LRS   $AC0.M, @DSCR
+      0x02c0, 0x0004,  // ANDCF $AC0.M, #0x0004
+      0x029d, 0x0010,  // JLZ   0x0010
+  }));
+  // Nothing is loaded
+  EXPECT_FALSE(IsIdleSkip({
+      0x02c0, 0x8000,  // ANDCF $AC0.M, #0x8000
+      0x029c, 0x0010,  // JLNZ  0x0010
+  }));
+  // Too long to be a polling loop
+  EXPECT_FALSE(IsIdleSkip({
+      0x26fe,                                          // LRS  $AC0.M, @CMBH
+      0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // NOP
+      0x0000, 0x0000,                                  // NOP
+      0x029c, 0x0010,                                  // JLNZ 0x0010
+  }));
+}
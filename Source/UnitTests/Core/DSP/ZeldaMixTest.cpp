@@ -0,0 +1,139 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DSPHLE/UCodes/ZeldaMix.h"
+
+namespace
+{
+constexpr size_t FRAME_SIZE = 0x50;
+
+// The parts of a VPB which affect rendering once the raw samples have been decoded, with values
+// like the ones games use: resampling ratios around 1:1 (0x1000), a few ramping volumes and
+// some extreme values to cover the clamping.
+struct VoiceParams
+{
+  u32 resampling_ratio;
+  u32 current_pos_frac;
+  std::array<s16, 4> channel_volumes;
+  std::array<s16, 4> channel_targets;
+};
+
+constexpr std::array<VoiceParams, 8> VOICES = {{
+    {0x1000, 0x000, {0x7FFF, 0x4000, 0, 0}, {0x7FFF, 0x4000, 0, 0}},
+    {0x0800, 0x3C0, {0x2000, 0x2000, 0x2000, 0x2000}, {0x6000, 0x1000, 0, -0x8000}},
+    {0x1555, 0xFFF, {-0x8000, 0x7FFF, -0x8000, 0x7FFF}, {0x7FFF, -0x8000, 0x7FFF, -0x8000}},
+    {0x3FFF, 0x123, {0x1234, 0, 0x4321, 0}, {0, 0x1234, 0, 0x4321}},
+    {0x0001, 0x800, {0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF}, {0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF}},
+    {0x2AB0, 0x040, {0x0100, -0x0100, 0x0800, -0x0800}, {0x0200, -0x0200, 0x0400, -0x0400}},
+    {0x1000, 0x7FF, {0, 0, 0, 0}, {0x7FFF, 0x7FFF, 0x7FFF, 0x7FFF}},
+    {0x0C00, 0x5A5, {0x3000, 0x5000, 0x7000, 0x1000}, {0x3000, 0x5000, 0x7000, 0x1000}},
+}};
+
+struct Tables
+{
+  std::array<s16, 0x100> resampling_coeffs;
+  std::array<s16, 8> filter_coeffs;
+  // Enough raw samples for the highest resampling ratio, plus the 4 filter taps
+  std::vector<s16> raw_samples;
+};
+
+Tables CreateTables()
+{
+  // Only use the raw generator output, which is the same with every standard library
+  std::mt19937 rng(1234);
+  const auto random_s16 = [&] { return static_cast<s16>(rng() >> 16); };
+
+  Tables tables;
+  for (s16& coeff : tables.resampling_coeffs)
+    coeff = random_s16();
+  for (s16& coeff : tables.filter_coeffs)
+    coeff = random_s16();
+  tables.raw_samples.resize(((0x3FFF * FRAME_SIZE + 0xFFF) >> 12) + 4);
+  for (s16& sample : tables.raw_samples)
+    sample = random_s16();
+  // Full scale samples, which make the sums of products largest
+  for (size_t i = 0; i < 16; ++i)
+    tables.raw_samples[i] = i % 2 ? 0x7FFF : -0x8000;
+  tables.resampling_coeffs[0] = -0x8000;
+  tables.resampling_coeffs[1] = -0x8000;
+  return tables;
+}
+
+struct Functions
+{
+  decltype(&DSP::HLE::ZeldaMix::ApplyVolume) apply_volume;
+  decltype(&DSP::HLE::ZeldaMix::AddWithVolume) add_with_volume;
+  decltype(&DSP::HLE::ZeldaMix::AddWithVolumeRamp) add_with_volume_ramp;
+  decltype(&DSP::HLE::ZeldaMix::Resample) resample;
+  decltype(&DSP::HLE::ZeldaMix::ApplyFilter) apply_filter;
+};
+
+struct RenderResult
+{
+  std::array<std::array<s16, FRAME_SIZE>, 4> buffers{};
+  std::array<s16, FRAME_SIZE + 7> reverb{};
+  std::vector<u32> positions;
+  std::vector<s32> volumes;
+};
+
+// Renders all voices like ZeldaAudioRenderer does: resampling, mixing into four buffers with
+// ramping volumes, then the reverb filter and the output volume.
+RenderResult Render(const Tables& tables, size_t count, const Functions& f)
+{
+  RenderResult result;
+  for (const VoiceParams& voice : VOICES)
+  {
+    std::array<s16, FRAME_SIZE> input;
+    result.positions.push_back(f.resample(input.data(), count, tables.raw_samples.data(),
+                                          voice.current_pos_frac, voice.resampling_ratio,
+                                          tables.resampling_coeffs.data()));
+
+    for (size_t i = 0; i < 4; ++i)
+    {
+      const s16 delta = voice.channel_targets[i] - voice.channel_volumes[i];
+      const s32 step = count ? (delta << 16) / s32(count) : 0;
+      result.volumes.push_back(f.add_with_volume_ramp(result.buffers[i].data(), input.data(),
+                                                      count, voice.channel_volumes[i] << 16,
+                                                      step));
+    }
+    f.add_with_volume(result.reverb.data(), input.data(), count, 0xB820);
+  }
+
+  f.apply_filter(result.reverb.data(), count, tables.filter_coeffs.data());
+  for (size_t i = 0; i < 4; ++i)
+    f.apply_volume(result.buffers[i].data(), count, 0x1800 + u16(i * 0x2000), i % 2 ? 12 : 15);
+  return result;
+}
+
+const Functions GENERIC = {
+    DSP::HLE::ZeldaMix::ApplyVolumeGeneric, DSP::HLE::ZeldaMix::AddWithVolumeGeneric,
+    DSP::HLE::ZeldaMix::AddWithVolumeRampGeneric, DSP::HLE::ZeldaMix::ResampleGeneric,
+    DSP::HLE::ZeldaMix::ApplyFilterGeneric};
+const Functions VECTORIZED = {DSP::HLE::ZeldaMix::ApplyVolume, DSP::HLE::ZeldaMix::AddWithVolume,
+                              DSP::HLE::ZeldaMix::AddWithVolumeRamp, DSP::HLE::ZeldaMix::Resample,
+                              DSP::HLE::ZeldaMix::ApplyFilter};
+}  // namespace
+
+TEST(ZeldaMix, MatchesGeneric)
+{
+  const Tables tables = CreateTables();
+
+  // Frames always have 0x50 samples. Other counts cover the scalar tail.
+  for (size_t count : {size_t(0), size_t(1), size_t(6), size_t(0x4F), FRAME_SIZE})
+  {
+    const RenderResult expected = Render(tables, count, GENERIC);
+    const RenderResult actual = Render(tables, count, VECTORIZED);
+
+    EXPECT_EQ(expected.buffers, actual.buffers) << count << " samples";
+    EXPECT_EQ(expected.reverb, actual.reverb) << count << " samples";
+    EXPECT_EQ(expected.positions, actual.positions) << count << " samples";
+    EXPECT_EQ(expected.volumes, actual.volumes) << count << " samples";
+  }
+}
@@ -0,0 +1,107 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <chrono>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/FifoPlayer/FifoRecorder.h"
+#include "Core/System.h"
+
+class FifoRecorderTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_recorder = std::make_unique<FifoRecorder>(Core::System::GetInstance());
+  }
+
+  void StartRecording(s32 num_frames)
+  {
+    // The callback can only run on the frame writer thread, so it may still be called while the
+    // recorder is being destroyed
+    FifoRecorder* const recorder = m_recorder.get();
+    m_recorder->StartRecording(num_frames, [this, recorder] {
+      ++m_finished_count;
+      m_frames_when_finished = recorder->GetRecordedFile()->GetFrameCount();
+      m_finished.Set();
+    });
+
+    // What the end of frame hook does when recording starts
+    m_recorder->SetVideoMemory(m_bp_mem.data(), m_cp_mem.data(), m_xf_mem.data(),
+                               m_xf_regs.data(), static_cast<u32>(m_xf_regs.size()),
+                               m_tex_mem.data());
+    m_recorder->EndFrame(0, 0);
+  }
+
+  // The video thread keeps sending commands after the recording ends. The command after the last
+  // end of frame completes the last frame.
+  void WriteCommands()
+  {
+    static constexpr u8 GX_NOP = 0x00;
+    for (int i = 0; i < 4; ++i)
+      m_recorder->WriteGPCommand(&GX_NOP, 1);
+  }
+
+  void RecordFrame()
+  {
+    WriteCommands();
+    m_recorder->EndFrame(0, 0);
+  }
+
+  // Waits for the recording to finish, and for all frames to be written
+  void Finish()
+  {
+    WriteCommands();
+    EXPECT_TRUE(m_finished.WaitFor(std::chrono::seconds(10)));
+    m_recorder.reset();
+  }
+
+  std::unique_ptr<FifoRecorder> m_recorder;
+  int m_finished_count = 0;
+  u32 m_frames_when_finished = 0;
+  Common::Event m_finished;
+
+  std::array<u32, FifoDataFile::BP_MEM_SIZE> m_bp_mem{};
+  std::array<u32, FifoDataFile::CP_MEM_SIZE> m_cp_mem{};
+  std::array<u32, FifoDataFile::XF_MEM_SIZE> m_xf_mem{};
+  std::array<u32, FifoDataFile::XF_REGS_SIZE> m_xf_regs{};
+  std::array<u8, FifoDataFile::TEX_MEM_SIZE> m_tex_mem{};
+};
+
+TEST_F(FifoRecorderTest, FinishesOnceAfterLastFrame)
+{
+  constexpr s32 NUM_FRAMES = 20;
+  StartRecording(NUM_FRAMES);
+  for (s32 i = 0; i < NUM_FRAMES; ++i)
+  {
+    EXPECT_TRUE(m_recorder->IsRecording());
+    RecordFrame();
+  }
+  EXPECT_FALSE(m_recorder->IsRecording());
+
+  Finish();
+  EXPECT_EQ(m_finished_count, 1);
+  EXPECT_EQ(m_frames_when_finished, u32(NUM_FRAMES));
+}
+
+TEST_F(FifoRecorderTest, FinishesOnceAfterStop)
+{
+  StartRecording(0);
+  for (int i = 0; i < 10; ++i)
+    RecordFrame();
+
+  // The frames before this are most likely still queued for the file
+  m_recorder->StopRecording();
+  RecordFrame();
+  EXPECT_FALSE(m_recorder->IsRecording());
+
+  Finish();
+  EXPECT_EQ(m_finished_count, 1);
+  EXPECT_EQ(m_frames_when_finished, 11u);
+}
@@ -0,0 +1,362 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/StringUtil.h"
+#include "Core/StateDelta.h"
+
+namespace
+{
+std::vector<u8> MakeDelta(const std::vector<u8>& base, const std::vector<u8>& state,
+                          size_t* changed_pages = nullptr)
+{
+  std::vector<u8> delta;
+  const size_t pages = State::CreateStateDelta(state, State::HashStatePages(state),
+                                               State::HashStatePages(base), &delta);
+  if (changed_pages)
+    *changed_pages = pages;
+  return delta;
+}
+
+std::vector<u8> RandomState(std::mt19937& rng, size_t size)
+{
+  std::vector<u8> state(size);
+  for (u8& byte : state)
+    byte = static_cast<u8>(rng());
+  return state;
+}
+
+std::vector<u8> ChangeBytes(std::mt19937& rng, std::vector<u8> state, int count)
+{
+  for (int i = 0; i < count; ++i)
+    state[rng() % state.size()] = static_cast<u8>(rng());
+  return state;
+}
+
+// Stands in for the state files on disk
+class StateFiles
+{
+public:
+  // Saves <state> to <filename> the way State::SaveDeltaAs does
+  void Save(State::DeltaChain* chain, const std::string& filename, const std::vector<u8>& state)
+  {
+    chain->ForgetFiles(filename, "");
+    std::vector<u8> delta;
+    std::optional<State::DeltaBase> base = chain->Add(filename, state, &delta);
+    m_files[Normalize(filename)] = base ? File{std::move(delta), std::move(base)} : File{state, {}};
+  }
+
+  State::DeltaChainResult Load(const std::string& filename, std::vector<u8>* state)
+  {
+    return State::ReadDeltaChain(filename, State::MAX_DELTA_CHAIN_LENGTH,
+                                 [this](const std::string& name, std::vector<u8>* payload,
+                                        std::optional<State::DeltaBase>* base) {
+                                   const auto it = m_files.find(Normalize(name));
+                                   if (it == m_files.end())
+                                     return false;
+                                   *payload = it->second.payload;
+                                   *base = it->second.base;
+                                   return true;
+                                 },
+                                 state);
+  }
+
+  std::optional<State::DeltaBase>& GetBase(const std::string& filename)
+  {
+    return m_files.at(Normalize(filename)).base;
+  }
+
+  void Remove(const std::string& filename) { m_files.erase(Normalize(filename)); }
+
+private:
+  struct File
+  {
+    std::vector<u8> payload;
+    std::optional<State::DeltaBase> base;
+  };
+
+  static std::string Normalize(const std::string& filename)
+  {
+    return PathToString(StringToPath(filename).lexically_normal());
+  }
+
+  std::map<std::string, File> m_files;
+};
+}  // namespace
+
+TEST(StateDelta, UnchangedState)
+{
+  std::mt19937 rng(0);
+  const std::vector<u8> base = RandomState(rng, 40 * State::DELTA_PAGE_SIZE + 123);
+
+  size_t changed_pages;
+  const std::vector<u8> delta = MakeDelta(base, base, &changed_pages);
+  EXPECT_EQ(changed_pages, 0u);
+  EXPECT_LT(delta.size(), 64u);
+
+  std::vector<u8> state = base;
+  ASSERT_TRUE(State::ApplyStateDelta(delta, &state));
+  EXPECT_EQ(state, base);
+}
+
+TEST(StateDelta, OnlyStoresChangedPages)
+{
+  std::mt19937 rng(1);
+  const std::vector<u8> base = RandomState(rng, 64 * State::DELTA_PAGE_SIZE);
+
+  std::vector<u8> next = base;
+  next[0] ^= 1;
+  next[5 * State::DELTA_PAGE_SIZE + 17] ^= 0x80;
+  next[5 * State::DELTA_PAGE_SIZE + 18] ^= 0x80;
+  next.back() ^= 0xFF;
+
+  size_t changed_pages;
+  const std::vector<u8> delta = MakeDelta(base, next, &changed_pages);
+  EXPECT_EQ(changed_pages, 3u);
+  EXPECT_LT(delta.size(), 4 * State::DELTA_PAGE_SIZE);
+
+  std::vector<u8> state = base;
+  ASSERT_TRUE(State::ApplyStateDelta(delta, &state));
+  EXPECT_EQ(state, next);
+}
+
+TEST(StateDelta, SizeChanges)
+{
+  std::mt19937 rng(2);
+  for (const size_t base_size : {size_t{0}, size_t{1000}, 8 * State::DELTA_PAGE_SIZE,
+                                 8 * State::DELTA_PAGE_SIZE + 1})
+  {
+    const std::vector<u8> base = RandomState(rng, base_size);
+    for (const size_t size : {size_t{0}, size_t{999}, base_size, base_size + 1,
+                              base_size + 3 * State::DELTA_PAGE_SIZE + 7})
+    {
+      // Keep the common part equal, so that only the pages at the end differ
+      std::vector<u8> next = RandomState(rng, size);
+      std::copy_n(base.begin(), std::min(base_size, size), next.begin());
+
+      std::vector<u8> state = base;
+      ASSERT_TRUE(State::ApplyStateDelta(MakeDelta(base, next), &state));
+      EXPECT_EQ(state, next) << base_size << " -> " << size;
+    }
+  }
+}
+
+TEST(StateDelta, Chain)
+{
+  std::mt19937 rng(3);
+  const std::vector<u8> keyframe = RandomState(rng, 100 * State::DELTA_PAGE_SIZE + 50);
+
+  std::vector<std::vector<u8>> deltas;
+  std::vector<u8> previous = keyframe;
+  for (int i = 0; i < 10; ++i)
+  {
+    std::vector<u8> next = previous;
+    for (int j = 0; j < 20; ++j)
+      next[rng() % next.size()] = static_cast<u8>(rng());
+    deltas.push_back(MakeDelta(previous, next));
+    previous = std::move(next);
+  }
+
+  std::vector<u8> state = keyframe;
+  for (const std::vector<u8>& delta : deltas)
+    ASSERT_TRUE(State::ApplyStateDelta(delta, &state));
+  EXPECT_EQ(state, previous);
+}
+
+TEST(StateDelta, RejectsMalformedDeltas)
+{
+  std::mt19937 rng(4);
+  const std::vector<u8> base = RandomState(rng, 16 * State::DELTA_PAGE_SIZE);
+  std::vector<u8> next = base;
+  next[2 * State::DELTA_PAGE_SIZE] ^= 1;
+  next[9 * State::DELTA_PAGE_SIZE] ^= 1;
+  const std::vector<u8> delta = MakeDelta(base, next);
+
+  std::vector<u8> state = base;
+  std::vector<u8> truncated = delta;
+  truncated.pop_back();
+  EXPECT_FALSE(State::ApplyStateDelta(truncated, &state));
+  EXPECT_FALSE(State::ApplyStateDelta(std::vector<u8>(8), &state));
+
+  // The page indices follow the 16-byte header and have to be increasing
+  std::vector<u8> reordered = delta;
+  std::swap(reordered[16], reordered[20]);
+  EXPECT_FALSE(State::ApplyStateDelta(reordered, &state));
+
+  EXPECT_EQ(state, base);
+}
+
+TEST(StateDelta, ChainStartsWithKeyframe)
+{
+  std::mt19937 rng(5);
+  const std::vector<u8> keyframe = RandomState(rng, 32 * State::DELTA_PAGE_SIZE);
+
+  State::DeltaChain chain;
+  std::vector<u8> delta;
+  EXPECT_EQ(chain.Add("/states/GAME01.s01", keyframe, &delta), std::nullopt);
+  EXPECT_EQ(chain.GetLength(), 1u);
+
+  const std::optional<State::DeltaBase> base =
+      chain.Add("/states/GAME01.s02", ChangeBytes(rng, keyframe, 3), &delta);
+  ASSERT_TRUE(base.has_value());
+  EXPECT_EQ(base->filename, "GAME01.s01");
+  EXPECT_EQ(base->chain_length, 1u);
+  EXPECT_EQ(base->checksum, State::GetStateChecksum(State::HashStatePages(keyframe)));
+  EXPECT_EQ(chain.GetLength(), 2u);
+}
+
+TEST(StateDelta, ChainGetsNewKeyframes)
+{
+  std::mt19937 rng(6);
+  std::vector<u8> state = RandomState(rng, 32 * State::DELTA_PAGE_SIZE);
+
+  State::DeltaChain chain;
+  std::vector<u8> delta;
+  EXPECT_EQ(chain.Add("/states/0.sav", state, &delta), std::nullopt);
+  for (u32 i = 1; i <= State::MAX_DELTA_CHAIN_LENGTH; ++i)
+  {
+    state = ChangeBytes(rng, std::move(state), 2);
+    const std::optional<State::DeltaBase> base =
+        chain.Add(fmt::format("/states/{}.sav", i), state, &delta);
+    ASSERT_TRUE(base.has_value());
+    EXPECT_EQ(base->chain_length, i);
+  }
+
+  // The chain is as long as it may get
+  state = ChangeBytes(rng, std::move(state), 2);
+  EXPECT_EQ(chain.Add("/states/keyframe.sav", state, &delta), std::nullopt);
+  EXPECT_EQ(chain.GetLength(), 1u);
+
+  // A delta which isn't much smaller than the state isn't worth it
+  state = ChangeBytes(rng, std::move(state), 2);
+  EXPECT_TRUE(chain.Add("/states/delta.sav", state, &delta).has_value());
+  std::copy_n(RandomState(rng, state.size() / 2).begin(), state.size() / 2, state.begin());
+  EXPECT_EQ(chain.Add("/states/changed.sav", state, &delta), std::nullopt);
+  EXPECT_EQ(chain.GetLength(), 1u);
+}
+
+TEST(StateDelta, ChainForgetsReplacedFiles)
+{
+  std::mt19937 rng(7);
+  const std::vector<u8> state = RandomState(rng, 32 * State::DELTA_PAGE_SIZE);
+
+  State::DeltaChain chain;
+  std::vector<u8> delta;
+  chain.Add("/states/a.sav", state, &delta);
+  chain.Add("/states/b.sav", state, &delta);
+
+  chain.ForgetFiles("/states/c.sav", "/states/backup.sav");
+  EXPECT_EQ(chain.GetLength(), 2u);
+
+  // Overwriting a state of the chain
+  chain.ForgetFiles("/states/a.sav", "");
+  EXPECT_EQ(chain.GetLength(), 0u);
+
+  // Moving a state of the chain away as the backup of the state being overwritten
+  chain.Add("/states/a.sav", state, &delta);
+  chain.ForgetFiles("/states/c.sav", "/states/a.sav");
+  EXPECT_EQ(chain.GetLength(), 0u);
+
+  chain.Add("/states/a.sav", state, &delta);
+  chain.Reset();
+  EXPECT_EQ(chain.GetLength(), 0u);
+  EXPECT_EQ(chain.Add("/states/b.sav", state, &delta), std::nullopt);
+}
+
+TEST(StateDelta, LoadsChain)
+{
+  std::mt19937 rng(8);
+  std::vector<std::vector<u8>> states{RandomState(rng, 50 * State::DELTA_PAGE_SIZE + 10)};
+  for (int i = 0; i < 5; ++i)
+    states.push_back(ChangeBytes(rng, states.back(), 10));
+
+  State::DeltaChain chain;
+  StateFiles files;
+  for (size_t i = 0; i < states.size(); ++i)
+    files.Save(&chain, fmt::format("/states/{}.sav", i), states[i]);
+
+  for (size_t i = 0; i < states.size(); ++i)
+  {
+    std::vector<u8> state;
+    ASSERT_EQ(files.Load(fmt::format("/states/{}.sav", i), &state),
+              State::DeltaChainResult::Success);
+    EXPECT_EQ(state, states[i]) << i;
+  }
+}
+
+TEST(StateDelta, LoadsChainAcrossDirectories)
+{
+  std::mt19937 rng(9);
+  const std::vector<u8> keyframe = RandomState(rng, 20 * State::DELTA_PAGE_SIZE);
+  const std::vector<u8> next = ChangeBytes(rng, keyframe, 4);
+
+  State::DeltaChain chain;
+  StateFiles files;
+  files.Save(&chain, "/states/keyframe.sav", keyframe);
+  files.Save(&chain, "/states/sub/next.sav", next);
+  EXPECT_EQ(files.GetBase("/states/sub/next.sav")->filename,
+            PathToString(StringToPath("../keyframe.sav")));
+
+  std::vector<u8> state;
+  ASSERT_EQ(files.Load("/states/sub/next.sav", &state), State::DeltaChainResult::Success);
+  EXPECT_EQ(state, next);
+}
+
+TEST(StateDelta, RejectsReplacedBase)
+{
+  std::mt19937 rng(10);
+  const std::vector<u8> keyframe = RandomState(rng, 20 * State::DELTA_PAGE_SIZE);
+  const std::vector<u8> next = ChangeBytes(rng, keyframe, 4);
+
+  State::DeltaChain chain;
+  StateFiles files;
+  files.Save(&chain, "/states/a.sav", keyframe);
+  files.Save(&chain, "/states/b.sav", next);
+
+  // Saved by something that doesn't know about the chain, such as another instance of Dolphin
+  State::DeltaChain other_chain;
+  files.Save(&other_chain, "/states/a.sav", ChangeBytes(rng, keyframe, 1));
+
+  std::vector<u8> state{1, 2, 3};
+  EXPECT_EQ(files.Load("/states/b.sav", &state), State::DeltaChainResult::BaseReplaced);
+  EXPECT_EQ(state, (std::vector<u8>{1, 2, 3}));
+
+  files.Remove("/states/a.sav");
+  EXPECT_EQ(files.Load("/states/b.sav", &state), State::DeltaChainResult::ReadFailed);
+}
+
+TEST(StateDelta, RejectsCorruptedChains)
+{
+  std::mt19937 rng(11);
+  const std::vector<u8> keyframe = RandomState(rng, 20 * State::DELTA_PAGE_SIZE);
+
+  State::DeltaChain chain;
+  StateFiles files;
+  files.Save(&chain, "/states/a.sav", keyframe);
+  files.Save(&chain, "/states/b.sav", ChangeBytes(rng, keyframe, 4));
+  files.Save(&chain, "/states/c.sav", ChangeBytes(rng, keyframe, 4));
+
+  std::vector<u8> state;
+  std::optional<State::DeltaBase>& base = files.GetBase("/states/c.sav");
+  base->chain_length = 0;
+  EXPECT_EQ(files.Load("/states/c.sav", &state), State::DeltaChainResult::ChainCorrupted);
+  base->chain_length = State::MAX_DELTA_CHAIN_LENGTH + 1;
+  EXPECT_EQ(files.Load("/states/c.sav", &state), State::DeltaChainResult::ChainCorrupted);
+
+  // A chain which is longer than its states claim, or cyclic, runs out of allowed length
+  base->chain_length = 1;
+  EXPECT_EQ(files.Load("/states/c.sav", &state), State::DeltaChainResult::ChainCorrupted);
+  base->chain_length = State::MAX_DELTA_CHAIN_LENGTH;
+  base->filename = "c.sav";
+  EXPECT_EQ(files.Load("/states/c.sav", &state), State::DeltaChainResult::ChainCorrupted);
+}
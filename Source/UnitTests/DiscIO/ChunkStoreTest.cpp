@@ -0,0 +1,203 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/ChunkStore.h"
+#include "DiscIO/WIABlob.h"
+
+class ChunkStoreTest : public testing::Test
+{
+protected:
+  ChunkStoreTest() : m_directory(File::CreateTempDir()), m_store_path(m_directory + "/store") {}
+
+  ~ChunkStoreTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override { ASSERT_FALSE(m_directory.empty()); }
+
+  static std::vector<u8> MakeData(size_t size, u32 seed)
+  {
+    std::vector<u8> data(size);
+    u32 state = seed;
+    for (u8& byte : data)
+    {
+      state = state * 1103515245 + 12345;
+      byte = static_cast<u8>(state >> 16);
+    }
+    return data;
+  }
+
+  static std::string ReadFile(const std::string& path)
+  {
+    std::string contents;
+    EXPECT_TRUE(File::ReadFileToString(path, contents));
+    return contents;
+  }
+
+  static void WriteFile(const std::string& path, const std::vector<u8>& data)
+  {
+    File::IOFile file(path, "wb");
+    ASSERT_TRUE(file.WriteBytes(data.data(), data.size()));
+  }
+
+  static std::vector<u8> ReadBlob(const std::string& path)
+  {
+    const std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(path);
+    if (!reader)
+      return {};
+    std::vector<u8> data(reader->GetDataSize());
+    EXPECT_TRUE(reader->Read(0, data.size(), data.data()));
+    return data;
+  }
+
+  // Converts <data> to an RVZ file with the given chunk size and no compression
+  void WriteRVZ(const std::string& path, const std::vector<u8>& data)
+  {
+    const std::string iso_path = path + ".iso";
+    WriteFile(iso_path, data);
+    const std::unique_ptr<DiscIO::BlobReader> iso = DiscIO::CreateBlobReader(iso_path);
+    ASSERT_TRUE(iso);
+    ASSERT_TRUE(DiscIO::ConvertToWIAOrRVZ(iso.get(), iso_path, path, true,
+                                          DiscIO::WIARVZCompressionType::None, 0, CHUNK_SIZE,
+                                          [](const std::string&, float) { return true; }));
+  }
+
+  std::string GetIndexPath() const { return m_store_path + "/chunks.idx"; }
+  std::string GetDataPath() const { return DiscIO::ChunkStore::GetDataPath(m_store_path); }
+
+  static constexpr int CHUNK_SIZE = 0x20000;
+
+  const std::string m_directory;
+  const std::string m_store_path;
+};
+
+TEST_F(ChunkStoreTest, ReusesChunks)
+{
+  const std::vector<u8> a = MakeData(1000, 1);
+  const std::vector<u8> b = MakeData(2000, 2);
+
+  {
+    const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(m_store_path);
+    ASSERT_TRUE(store);
+    EXPECT_EQ(store->Add(a.data(), 1000), 0u);
+    EXPECT_EQ(store->Add(b.data(), 2000), 1000u);
+    EXPECT_EQ(store->Add(a.data(), 1000), 0u);
+    EXPECT_EQ(store->GetAddedBytes(), 3000u);
+    EXPECT_EQ(store->GetReusedBytes(), 1000u);
+  }
+
+  const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(m_store_path);
+  ASSERT_TRUE(store);
+  EXPECT_EQ(store->Add(b.data(), 2000), 1000u);
+  EXPECT_EQ(store->GetAddedBytes(), 0u);
+  EXPECT_EQ(File::GetSize(GetDataPath()), 3000u);
+}
+
+TEST_F(ChunkStoreTest, RepairsTruncatedIndex)
+{
+  const std::vector<u8> a = MakeData(1000, 1);
+  const std::vector<u8> b = MakeData(2000, 2);
+
+  DiscIO::ChunkStore::Open(m_store_path)->Add(a.data(), 1000);
+
+  // As if writing the index entry of a chunk was interrupted
+  {
+    File::IOFile index(GetIndexPath(), "ab");
+    ASSERT_TRUE(index.WriteBytes("abcde", 5));
+  }
+
+  {
+    const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(m_store_path);
+    ASSERT_TRUE(store);
+    EXPECT_EQ(File::GetSize(GetIndexPath()) % 0x20, 0u);
+    EXPECT_EQ(store->Add(b.data(), 2000), 1000u);
+  }
+
+  // The entry added after the repair can be read again
+  const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(m_store_path);
+  ASSERT_TRUE(store);
+  EXPECT_EQ(store->Add(a.data(), 1000), 0u);
+  EXPECT_EQ(store->Add(b.data(), 2000), 1000u);
+  EXPECT_EQ(store->GetAddedBytes(), 0u);
+}
+
+TEST_F(ChunkStoreTest, DropsChunksMissingFromDataFile)
+{
+  const std::vector<u8> a = MakeData(1000, 1);
+  const std::vector<u8> b = MakeData(2000, 2);
+
+  {
+    const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(m_store_path);
+    store->Add(a.data(), 1000);
+    store->Add(b.data(), 2000);
+  }
+
+  // As if the data of the last chunk never made it to the disk
+  std::filesystem::resize_file(StringToPath(GetDataPath()), 1500);
+
+  {
+    const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(m_store_path);
+    ASSERT_TRUE(store);
+    EXPECT_EQ(store->Add(a.data(), 1000), 0u);
+    EXPECT_EQ(store->Add(b.data(), 2000), 1500u);
+    EXPECT_EQ(store->GetAddedBytes(), 2000u);
+  }
+
+  const std::unique_ptr<DiscIO::ChunkStore> store = DiscIO::ChunkStore::Open(m_store_path);
+  ASSERT_TRUE(store);
+  EXPECT_EQ(store->Add(b.data(), 2000), 1500u);
+  EXPECT_EQ(store->GetAddedBytes(), 0u);
+}
+
+TEST_F(ChunkStoreTest, PackAndUnpack)
+{
+  // Two versions of an image which only differ in one chunk
+  constexpr size_t IMAGE_SIZE = 16 * CHUNK_SIZE;
+  const std::vector<u8> image_a = MakeData(IMAGE_SIZE, 1);
+  std::vector<u8> image_b = image_a;
+  const std::vector<u8> changed = MakeData(CHUNK_SIZE, 2);
+  std::copy(changed.begin(), changed.end(), image_b.begin() + 5 * CHUNK_SIZE);
+
+  const std::string rvz_a = m_directory + "/a.rvz";
+  const std::string rvz_b = m_directory + "/b.rvz";
+  WriteRVZ(rvz_a, image_a);
+  WriteRVZ(rvz_b, image_b);
+
+  const std::string packed_a = m_directory + "/packed/a.rvz";
+  const std::string packed_b = m_directory + "/packed/b.rvz";
+  ASSERT_TRUE(File::CreateDirs(m_directory + "/packed"));
+  ASSERT_TRUE(DiscIO::PackWIAOrRVZ(rvz_a, packed_a, m_store_path));
+  const u64 store_size_a = File::GetSize(GetDataPath());
+  EXPECT_GE(store_size_a, IMAGE_SIZE);
+  ASSERT_TRUE(DiscIO::PackWIAOrRVZ(rvz_b, packed_b, m_store_path));
+
+  // Only the changed chunk was added for the second image
+  EXPECT_EQ(File::GetSize(GetDataPath()) - store_size_a, u64(CHUNK_SIZE));
+  EXPECT_LT(File::GetSize(packed_b), File::GetSize(rvz_b) / 4);
+
+  // The packed files can be read directly
+  EXPECT_EQ(ReadBlob(packed_a), image_a);
+  EXPECT_EQ(ReadBlob(packed_b), image_b);
+
+  const std::string unpacked_a = m_directory + "/unpacked_a.rvz";
+  const std::string unpacked_b = m_directory + "/unpacked_b.rvz";
+  ASSERT_TRUE(DiscIO::UnpackWIAOrRVZ(packed_a, unpacked_a));
+  ASSERT_TRUE(DiscIO::UnpackWIAOrRVZ(packed_b, unpacked_b));
+  EXPECT_EQ(ReadFile(unpacked_a), ReadFile(rvz_a));
+  EXPECT_EQ(ReadFile(unpacked_b), ReadFile(rvz_b));
+}
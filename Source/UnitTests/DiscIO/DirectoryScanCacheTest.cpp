@@ -0,0 +1,218 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
+#include "DiscIO/DirectoryScanCache.h"
+#include "DiscIO/RiivolutionPatcher.h"
+
+class DirectoryScanCacheTest : public testing::Test
+{
+protected:
+  DirectoryScanCacheTest()
+      : m_directory(File::CreateTempDir()), m_old_user_path(File::GetUserPath(D_USER_IDX))
+  {
+  }
+
+  ~DirectoryScanCacheTest() override
+  {
+    DiscIO::SetDirectoryScanCaching(false);
+    File::SetUserPath(D_USER_IDX, m_old_user_path);
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_FALSE(m_directory.empty());
+
+    // Keep the cache file away from the real user directory
+    File::SetUserPath(D_USER_IDX, m_directory + "/User/");
+    ASSERT_TRUE(File::CreateFullPath(File::GetUserPath(D_CACHE_IDX)));
+    DiscIO::SetDirectoryScanCaching(true);
+
+    m_root = m_directory + "/root";
+    ASSERT_TRUE(File::CreateFullPath(m_root + "/sub/"));
+    WriteFile(m_root + "/a.bin", 10);
+    WriteFile(m_root + "/sub/b.bin", 20);
+  }
+
+  void TearDown() override
+  {
+    // Forget the listings, so that they can't leak into the next test
+    DiscIO::ShutdownDirectoryScanCache();
+  }
+
+  static void WriteFile(const std::string& path, size_t size)
+  {
+    File::IOFile file(path, "wb");
+    ASSERT_TRUE(file.WriteBytes(std::vector<u8>(size, 0x5a).data(), size));
+  }
+
+  // Directories that were changed in the last few seconds aren't cached, so make them look older.
+  // The time is always the same, so that doing this again doesn't count as a change.
+  void MakeOld(const std::string& path)
+  {
+    std::filesystem::last_write_time(StringToPath(path), m_old_time);
+  }
+
+  void MakeAllOld()
+  {
+    MakeOld(m_root);
+    MakeOld(m_root + "/sub");
+  }
+
+  static std::optional<u64> FindSize(const File::FSTEntry& entry, const std::string& name)
+  {
+    const auto it = std::find_if(entry.children.begin(), entry.children.end(),
+                                 [&](const File::FSTEntry& e) { return e.virtualName == name; });
+    if (it == entry.children.end())
+      return std::nullopt;
+    return it->size;
+  }
+
+  static void ExpectSameTree(const File::FSTEntry& a, const File::FSTEntry& b)
+  {
+    EXPECT_EQ(a.isDirectory, b.isDirectory);
+    EXPECT_EQ(a.size, b.size);
+    EXPECT_EQ(a.physicalName, b.physicalName);
+    EXPECT_EQ(a.virtualName, b.virtualName);
+    ASSERT_EQ(a.children.size(), b.children.size());
+    for (size_t i = 0; i < a.children.size(); ++i)
+      ExpectSameTree(a.children[i], b.children[i]);
+  }
+
+  const std::string m_directory;
+  const std::string m_old_user_path;
+  const std::filesystem::file_time_type m_old_time =
+      std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  std::string m_root;
+};
+
+TEST_F(DirectoryScanCacheTest, MatchesUncachedScan)
+{
+  MakeAllOld();
+  const File::FSTEntry uncached = File::ScanDirectoryTree(m_root, true);
+
+  // Once to fill the cache and once to read from it
+  ExpectSameTree(DiscIO::ScanDirectoryTreeCached(m_root, true), uncached);
+  ExpectSameTree(DiscIO::ScanDirectoryTreeCached(m_root, true), uncached);
+  ExpectSameTree(DiscIO::ScanDirectoryTreeCached(m_root, false),
+                 File::ScanDirectoryTree(m_root, false));
+}
+
+TEST_F(DirectoryScanCacheTest, ListingIsReusedUntilDirectoryChanges)
+{
+  MakeAllOld();
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 10u);
+
+  // Overwriting a file in place doesn't change its directory, so the old size is still used until
+  // the file is opened and revalidated
+  WriteFile(m_root + "/a.bin", 30);
+  MakeOld(m_root);
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 10u);
+
+  // Adding a file changes the directory
+  WriteFile(m_root + "/c.bin", 5);
+  const File::FSTEntry listing = DiscIO::ScanDirectoryTreeCached(m_root, false);
+  EXPECT_EQ(FindSize(listing, "a.bin"), 30u);
+  EXPECT_EQ(FindSize(listing, "c.bin"), 5u);
+}
+
+TEST_F(DirectoryScanCacheTest, RevalidationDropsOverwrittenFiles)
+{
+  const std::string path = m_root + "/a.bin";
+  MakeAllOld();
+  DiscIO::ScanDirectoryTreeCached(m_root, true);
+  EXPECT_TRUE(DiscIO::RevalidateCachedFile(path, 10));
+  EXPECT_TRUE(DiscIO::RevalidateCachedFile(m_root + "/sub/b.bin", 20));
+
+  // A different size means the cached size was wrong, and the listing is scanned again
+  WriteFile(path, 30);
+  MakeOld(m_root);
+  EXPECT_FALSE(DiscIO::RevalidateCachedFile(path, 30));
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 30u);
+
+  // The same size with a different modification time only refreshes the listing
+  std::filesystem::last_write_time(StringToPath(path), m_old_time - std::chrono::hours(1));
+  EXPECT_TRUE(DiscIO::RevalidateCachedFile(path, 30));
+  EXPECT_TRUE(DiscIO::RevalidateCachedFile(path, 30));
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 30u);
+
+  // Files in listings that aren't cached can't be checked
+  EXPECT_TRUE(DiscIO::RevalidateCachedFile(m_directory + "/missing/a.bin", 1));
+}
+
+TEST_F(DirectoryScanCacheTest, RecentlyChangedDirectoriesAreNotCached)
+{
+  // The directory was just written to, so its modification time could still change without
+  // changing its value
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 10u);
+  WriteFile(m_root + "/a.bin", 30);
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 30u);
+}
+
+TEST_F(DirectoryScanCacheTest, DisabledCachingScansEveryTime)
+{
+  DiscIO::SetDirectoryScanCaching(false);
+  MakeAllOld();
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 10u);
+  WriteFile(m_root + "/a.bin", 30);
+  MakeOld(m_root);
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 30u);
+}
+
+TEST_F(DirectoryScanCacheTest, PersistsInCacheFile)
+{
+  MakeAllOld();
+  const File::FSTEntry original = DiscIO::ScanDirectoryTreeCached(m_root, true);
+  DiscIO::ShutdownDirectoryScanCache();
+  ASSERT_TRUE(File::Exists(File::GetUserPath(D_CACHE_IDX) + "directories.cache"));
+
+  // The stale size shows that the listing came from the cache file
+  WriteFile(m_root + "/sub/b.bin", 40);
+  MakeOld(m_root + "/sub");
+  ExpectSameTree(DiscIO::ScanDirectoryTreeCached(m_root, true), original);
+}
+
+TEST_F(DirectoryScanCacheTest, CorruptedCacheFileIsDiscarded)
+{
+  MakeAllOld();
+  DiscIO::ScanDirectoryTreeCached(m_root, true);
+  DiscIO::ShutdownDirectoryScanCache();
+
+  const std::string cache_path = File::GetUserPath(D_CACHE_IDX) + "directories.cache";
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(cache_path, contents));
+  ASSERT_TRUE(File::WriteStringToFile(cache_path, contents.substr(0, contents.size() / 2)));
+
+  WriteFile(m_root + "/a.bin", 30);
+  MakeOld(m_root);
+  EXPECT_EQ(FindSize(DiscIO::ScanDirectoryTreeCached(m_root, false), "a.bin"), 30u);
+}
+
+TEST_F(DirectoryScanCacheTest, RiivolutionResolvesCaseThroughListing)
+{
+  ASSERT_TRUE(File::CreateFullPath(m_root + "/Mod/"));
+  WriteFile(m_root + "/Mod/File.BIN", 12);
+  MakeAllOld();
+  MakeOld(m_root + "/Mod");
+
+  // Riivolution assumes a case-insensitive file system
+  DiscIO::Riivolution::FileDataLoaderHostFS loader(m_root, m_root + "/riivolution/mod.xml", "");
+  EXPECT_EQ(loader.GetExternalFileSize("/mod/file.bin"), 12u);
+  EXPECT_EQ(loader.GetExternalFileSize("/MOD/FILE.BIN"), 12u);
+  EXPECT_EQ(loader.GetFileContents("/mod/file.bin").size(), 12u);
+  EXPECT_EQ(loader.GetExternalFileSize("/mod/missing.bin"), std::nullopt);
+}
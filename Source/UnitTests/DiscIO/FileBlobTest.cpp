@@ -0,0 +1,94 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "DiscIO/FileBlob.h"
+
+class FileBlobTest : public testing::Test
+{
+protected:
+  // Big enough to span several pages and read sizes, small enough to write quickly. The file is
+  // only read, so all tests share it.
+  static constexpr size_t FILE_SIZE = 2 * 1024 * 1024;
+
+  static void SetUpTestSuite()
+  {
+    s_directory = File::CreateTempDir();
+    if (s_directory.empty())
+      return;
+    s_file_path = s_directory + "/image.iso";
+
+    s_data.resize(FILE_SIZE);
+    for (size_t i = 0; i < s_data.size(); ++i)
+      s_data[i] = static_cast<u8>(i * 7 + i / 4096);
+
+    File::IOFile file(s_file_path, "wb");
+    if (!file.WriteBytes(s_data.data(), s_data.size()))
+      s_file_path.clear();
+  }
+
+  static void TearDownTestSuite()
+  {
+    if (!s_directory.empty())
+      File::DeleteDirRecursively(s_directory);
+    s_directory.clear();
+    s_file_path.clear();
+    s_data.clear();
+  }
+
+  void SetUp() override { ASSERT_FALSE(s_file_path.empty()); }
+
+  void TearDown() override { DiscIO::SetPlainFileMapping(false); }
+
+  static std::unique_ptr<DiscIO::PlainFileReader> CreateReader(bool mapped)
+  {
+    DiscIO::SetPlainFileMapping(mapped);
+    return DiscIO::PlainFileReader::Create(File::IOFile(s_file_path, "rb"));
+  }
+
+  static inline std::string s_directory;
+  static inline std::string s_file_path;
+  static inline std::vector<u8> s_data;
+};
+
+TEST_F(FileBlobTest, MappedReadsMatchFile)
+{
+  const auto reader = CreateReader(true);
+  ASSERT_TRUE(reader);
+  ASSERT_TRUE(reader->IsMapped());
+  EXPECT_EQ(reader->GetDataSize(), FILE_SIZE);
+
+  std::vector<u8> buffer(0x10000);
+  for (const u64 offset : {u64{0}, u64{1}, u64{0x7fff}, u64{FILE_SIZE - buffer.size()}})
+  {
+    ASSERT_TRUE(reader->Read(offset, buffer.size(), buffer.data()));
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), s_data.begin() + offset)) << offset;
+  }
+
+  // Reads past the end must fail, like they do when reading normally
+  EXPECT_FALSE(reader->Read(FILE_SIZE - 1, 2, buffer.data()));
+  EXPECT_TRUE(reader->Read(FILE_SIZE, 0, buffer.data()));
+}
+
+TEST_F(FileBlobTest, CopyOfMappedReaderIsIndependent)
+{
+  std::unique_ptr<DiscIO::BlobReader> copy;
+  {
+    const auto reader = CreateReader(true);
+    ASSERT_TRUE(reader);
+    copy = reader->CopyReader();
+  }
+
+  std::vector<u8> buffer(0x8000);
+  ASSERT_TRUE(copy->Read(0x12345, buffer.size(), buffer.data()));
+  EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), s_data.begin() + 0x12345));
+}
@@ -0,0 +1,236 @@
+// Copyright 2024 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/Clipper.h"
+#include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/Rasterizer.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
+#include "VideoCommon/BPFunctions.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/CPUCull.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/XFMemory.h"
+
+using BBox = std::array<u16, 4>;
+using Vertex = CPUCull::TransformedVertex;
+
+// The values the SDK resets the bounding box to before every draw.
+static constexpr BBox RESET_BBOX = {1023, 0, 1023, 0};
+
+class BoundingBoxTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::memset(&bpmem, 0, sizeof(bpmem));
+    std::memset(&xfmem, 0, sizeof(xfmem));
+
+    // 640x528 viewport and scissor, with the 342 offset the SDK adds to both.
+    xfmem.viewport.wd = 320.0f;
+    xfmem.viewport.ht = -264.0f;
+    xfmem.viewport.xOrig = 342.0f + 320.0f;
+    xfmem.viewport.yOrig = 342.0f + 264.0f;
+    bpmem.scissorTL.x = 342;
+    bpmem.scissorTL.y = 342;
+    bpmem.scissorBR.x = 342 + 639;
+    bpmem.scissorBR.y = 342 + 527;
+    bpmem.scissorOffset.x = 342 / 2;
+    bpmem.scissorOffset.y = 342 / 2;
+
+    // Make sure every rasterized pixel reaches the bounding box update.
+    bpmem.alpha_test.comp0 = CompareMode::Always;
+    bpmem.alpha_test.comp1 = CompareMode::Always;
+    bpmem.alpha_test.logic = AlphaTestOp::And;
+
+    Rasterizer::Init();
+  }
+
+  // Converts pixel coordinates to clip space for the viewport set up above.
+  static Vertex Pixel(float x, float y, float w = 1.0f)
+  {
+    return {(x - 320.0f) / 320.0f * w, (y - 264.0f) / -264.0f * w, 0.5f * w, w};
+  }
+
+  static BBox DrawSoftware(const std::vector<Vertex>& triangles)
+  {
+    Rasterizer::ScissorChanged();
+    for (u32 i = 0; i < 4; i++)
+      BBoxManager::SetCoordinate(static_cast<BBoxManager::Coordinate>(i), RESET_BBOX[i]);
+
+    for (size_t i = 0; i + 2 < triangles.size(); i += 3)
+    {
+      std::array<OutputVertexData, 3> vertices;
+      for (size_t j = 0; j < 3; j++)
+      {
+        const Vertex& v = triangles[i + j];
+        vertices[j].projectedPosition = {v.x, v.y, v.z, v.w};
+        Clipper::PerspectiveDivide(&vertices[j]);
+      }
+
+      // The rasterizer only fills front facing triangles, the clipper swaps the winding of back
+      // facing ones when culling is disabled.
+      Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[1], &vertices[2]);
+      Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[2], &vertices[1]);
+    }
+
+    BBox result;
+    for (u32 i = 0; i < 4; i++)
+      result[i] = BBoxManager::GetCoordinate(static_cast<BBoxManager::Coordinate>(i));
+    return result;
+  }
+
+  static BBox
+  DrawCPU(const std::vector<Vertex>& vertices,
+          OpcodeDecoder::Primitive primitive = OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES,
+          CullMode cullmode = CullMode::None)
+  {
+    const BPFunctions::ScissorResult scissors = BPFunctions::ComputeScissorRects();
+    BBox bbox;
+    if (!CPUCull::ComputeBoundingBox(vertices.data(), static_cast<u32>(vertices.size()), primitive,
+                                     cullmode, xfmem.viewport, 0.0f, scissors.m_result, &bbox))
+    {
+      return RESET_BBOX;
+    }
+
+    return {std::min(bbox[0], RESET_BBOX[0]), std::max(bbox[1], RESET_BBOX[1]),
+            std::min(bbox[2], RESET_BBOX[2]), std::max(bbox[3], RESET_BBOX[3])};
+  }
+
+  // The CPU result must contain everything the software rasterizer drew.
+  static void ExpectContains(const BBox& cpu, const BBox& sw)
+  {
+    EXPECT_LE(cpu[0], sw[0]);
+    EXPECT_GE(cpu[1], sw[1]);
+    EXPECT_LE(cpu[2], sw[2]);
+    EXPECT_GE(cpu[3], sw[3]);
+  }
+};
+
+TEST_F(BoundingBoxTest, AxisAlignedQuadMatchesSoftware)
+{
+  const std::vector<Vertex> quad = {
+      Pixel(10.25f, 20.25f), Pixel(50.75f, 20.25f), Pixel(50.75f, 60.75f),
+      Pixel(10.25f, 20.25f), Pixel(50.75f, 60.75f), Pixel(10.25f, 60.75f),
+  };
+
+  const BBox sw = DrawSoftware(quad);
+  const BBox cpu = DrawCPU(quad);
+  EXPECT_EQ(sw, cpu);
+  EXPECT_EQ(cpu, (BBox{10, 51, 20, 61}));
+}
+
+TEST_F(BoundingBoxTest, TriangleIsConservative)
+{
+  const std::vector<Vertex> triangle = {
+      Pixel(100.3f, 30.6f),
+      Pixel(180.9f, 95.1f),
+      Pixel(120.4f, 140.2f),
+  };
+
+  const BBox sw = DrawSoftware(triangle);
+  const BBox cpu = DrawCPU(triangle);
+  ExpectContains(cpu, sw);
+  EXPECT_NE(sw, RESET_BBOX);
+}
+
+TEST_F(BoundingBoxTest, PerspectiveTriangleIsConservative)
+{
+  const std::vector<Vertex> triangle = {
+      Pixel(200.5f, 200.5f, 2.0f),
+      Pixel(400.5f, 220.5f, 0.5f),
+      Pixel(300.5f, 400.5f, 1.5f),
+  };
+
+  ExpectContains(DrawCPU(triangle), DrawSoftware(triangle));
+}
+
+TEST_F(BoundingBoxTest, ClampedToScissor)
+{
+  bpmem.scissorTL.x = 342 + 64;
+  bpmem.scissorTL.y = 342 + 32;
+  bpmem.scissorBR.x = 342 + 127;
+  bpmem.scissorBR.y = 342 + 95;
+
+  const std::vector<Vertex> triangle = {
+      Pixel(-100.0f, -100.0f),
+      Pixel(700.0f, -100.0f),
+      Pixel(300.0f, 600.0f),
+  };
+
+  const BBox sw = DrawSoftware(triangle);
+  const BBox cpu = DrawCPU(triangle);
+  EXPECT_EQ(sw, cpu);
+  EXPECT_EQ(cpu, (BBox{64, 127, 32, 95}));
+}
+
+TEST_F(BoundingBoxTest, CulledTrianglesAreIgnored)
+{
+  const std::vector<Vertex> triangle = {
+      Pixel(100.5f, 100.5f),
+      Pixel(200.5f, 100.5f),
+      Pixel(150.5f, 200.5f),
+  };
+
+  EXPECT_EQ(DrawCPU(triangle, OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES, CullMode::All),
+            RESET_BBOX);
+
+  // Exactly one of the two windings survives back face culling.
+  const std::vector<Vertex> reversed = {triangle[0], triangle[2], triangle[1]};
+  const bool front_drawn =
+      DrawCPU(triangle, OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES, CullMode::Back) != RESET_BBOX;
+  const bool back_drawn =
+      DrawCPU(reversed, OpcodeDecoder::Primitive::GX_DRAW_TRIANGLES, CullMode::Back) != RESET_BBOX;
+  EXPECT_NE(front_drawn, back_drawn);
+}
+
+TEST_F(BoundingBoxTest, OffscreenTriangleIsIgnored)
+{
+  const std::vector<Vertex> triangle = {
+      Pixel(700.5f, 10.5f),
+      Pixel(800.5f, 10.5f),
+      Pixel(750.5f, 60.5f),
+  };
+
+  EXPECT_EQ(DrawSoftware(triangle), RESET_BBOX);
+  EXPECT_EQ(DrawCPU(triangle), RESET_BBOX);
+}
+
+TEST_F(BoundingBoxTest, QuadPrimitiveMatchesTriangles)
+{
+  const std::vector<Vertex> quad = {
+      Pixel(300.5f, 300.5f),
+      Pixel(340.5f, 300.5f),
+      Pixel(340.5f, 330.5f),
+      Pixel(300.5f, 330.5f),
+  };
+  const std::vector<Vertex> triangles = {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]};
+
+  const BBox cpu = DrawCPU(quad, OpcodeDecoder::Primitive::GX_DRAW_QUADS);
+  EXPECT_EQ(cpu, DrawCPU(triangles));
+  ExpectContains(cpu, DrawSoftware(triangles));
+}
+
+TEST_F(BoundingBoxTest, LineCrossingScissorIsCounted)
+{
+  bpmem.scissorTL.x = 342 + 64;
+  bpmem.scissorTL.y = 342 + 32;
+  bpmem.scissorBR.x = 342 + 127;
+  bpmem.scissorBR.y = 342 + 95;
+
+  // Both ends are outside of the scissor rectangle, but the line crosses it. The result covers
+  // the extents of the whole segment within the scissor rectangle.
+  const std::vector<Vertex> line = {Pixel(10.5f, 40.5f), Pixel(200.5f, 80.5f)};
+  EXPECT_EQ(DrawCPU(line, OpcodeDecoder::Primitive::GX_DRAW_LINES), (BBox{64, 127, 40, 79}));
+  EXPECT_EQ(DrawCPU(line, OpcodeDecoder::Primitive::GX_DRAW_LINE_STRIP), (BBox{64, 127, 40, 79}));
+
+  // The same vertices as points are all outside of it.
+  EXPECT_EQ(DrawCPU(line, OpcodeDecoder::Primitive::GX_DRAW_POINTS), RESET_BBOX);
+}